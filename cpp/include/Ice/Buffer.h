@@ -11,10 +11,30 @@
 #define ICE_BUFFER_H
 
 #include <Ice/Config.h>
+#include <IceUtil/Shared.h>
+#include <IceUtil/Handle.h>
 
 namespace IceInternal
 {
 
+//
+// Buffer memory shared by a buffer container with other objects, the
+// memory is released with the last reference. See Buffer::Container::share().
+//
+class ICE_API BufferMemory : public IceUtil::Shared
+{
+public:
+
+    BufferMemory(Ice::Byte*, size_t);
+    virtual ~BufferMemory();
+
+private:
+
+    Ice::Byte* _buf;
+    const size_t _capacity;
+};
+typedef IceUtil::Handle<BufferMemory> BufferMemoryPtr;
+
 class ICE_API Buffer : private IceUtil::noncopyable
 {
 public:
@@ -22,10 +42,22 @@ public:
     Buffer() : i(b.begin()) { }
     Buffer(const Ice::Byte* beg, const Ice::Byte* end) : b(beg, end), i(b.begin()) { }
     Buffer(const std::vector<Ice::Byte>& v) : b(v), i(b.begin()) { }
-    Buffer(Buffer& o, bool adopt) : b(o.b, adopt), i(b.begin()) { }
+    Buffer(Buffer&, bool);
 
     void swapBuffer(Buffer&);
 
+    //
+    // Copy the bytes referenced by the segments to the buffer, see Segment
+    // below.
+    //
+    void copySegments();
+
+    //
+    // Copy the bytes referenced by the segments without owner, the buffer
+    // keeps referencing the memory of the other segments.
+    //
+    void copyUnownedSegments();
+
     class ICE_API Container : private IceUtil::noncopyable
     {
     public:
@@ -83,6 +115,20 @@ public:
 
         void clear();
 
+        //
+        // Share the memory of the container, the returned memory remains
+        // valid until the last reference is released even if the container
+        // is cleared or destroyed. Returns 0 if the memory isn't owned by
+        // the container. A shared container must not be re-used for writing
+        // and should be cleared instead.
+        //
+        BufferMemoryPtr share();
+
+        bool shared() const
+        {
+            return _memory;
+        }
+
         void resize(size_type n) // Inlined for performance reasons.
         {
             if(n == 0)
@@ -148,10 +194,29 @@ public:
         size_type _capacity;
         int _shrinkCounter;
         bool _owned;
+        BufferMemoryPtr _memory;
+    };
+
+    //
+    // A segment references memory which isn't owned by the buffer. The
+    // space for the segment bytes is reserved in the buffer at the given
+    // offset but the bytes are only copied by copySegments(), transports
+    // which support gather writes send them directly from the referenced
+    // memory. The memory must remain valid until the buffer is sent or
+    // copySegments() is called, unless the segment has an owner which
+    // keeps the memory alive for as long as the segment references it.
+    //
+    struct Segment
+    {
+        Container::size_type offset;
+        const Ice::Byte* data;
+        Container::size_type size;
+        IceUtil::Handle<IceUtil::Shared> owner;
     };
 
     Container b;
     Container::iterator i;
+    std::vector<Segment> segments;
 };
 
 }
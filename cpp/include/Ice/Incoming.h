@@ -49,6 +49,13 @@ protected:
 
 #endif
 
+namespace Ice
+{
+
+class ObjectAdapterI;
+
+}
+
 namespace IceInternal
 {
 
@@ -82,6 +89,8 @@ protected:
     void handleException(const std::exception&, bool);
     void handleException(const std::string&, bool);
 
+    void finishDispatch();
+
     Ice::Current _current;
     Ice::ObjectPtr _servant;
     Ice::ServantLocatorPtr _locator;
@@ -102,11 +111,28 @@ protected:
     //
     ResponseHandler* _responseHandler;
 
+    //
+    // The object adapter which admitted the dispatch if it limits the
+    // number of concurrent dispatches.
+    //
+    Ice::ObjectAdapterI* _dispatchAdapter;
+
+    //
+    // True if the dispatch was rejected by the object adapter before
+    // being dispatched.
+    //
+    bool _dispatchRejected;
+
+    //
+    // The callbacks of the dispatch interceptors, the innermost interceptor
+    // first. A vector is used since, unlike a deque, it doesn't allocate
+    // memory for each request when there are no dispatch interceptors.
+    //
 #ifdef ICE_CPP11_MAPPING
-    using DispatchInterceptorCallbacks = std::deque<std::pair<std::function<bool()>,
-                                                              std::function<bool(std::exception_ptr)>>>;
+    using DispatchInterceptorCallbacks = std::vector<std::pair<std::function<bool()>,
+                                                               std::function<bool(std::exception_ptr)>>>;
 #else
-    typedef std::deque<Ice::DispatchInterceptorAsyncCallbackPtr> DispatchInterceptorCallbacks;
+    typedef std::vector<Ice::DispatchInterceptorAsyncCallbackPtr> DispatchInterceptorCallbacks;
 #endif
     DispatchInterceptorCallbacks _interceptorCBs;
 };
@@ -105,6 +105,12 @@ private:
     // holds a ConnectionI* for optimization.
     //
     const ResponseHandlerPtr _responseHandlerCopy;
+
+    //
+    // The memory of the request, in parameters using the array mapping
+    // reference it and must remain valid until the response is sent.
+    //
+    const BufferMemoryPtr _requestMemory;
 };
 
 }
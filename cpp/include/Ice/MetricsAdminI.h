@@ -667,6 +667,12 @@ public:
         }
     }
 
+    //
+    // Register a map created by the given factory, for maps which are not
+    // updated by observers.
+    //
+    void registerMap(const std::string&, const MetricsMapFactoryPtr&);
+
     void unregisterMap(const std::string&);
 
     virtual Ice::StringSeq getMetricsViewNames(Ice::StringSeq&, const ::Ice::Current&);
@@ -293,6 +293,14 @@ public:
         }
     }
 
+    //
+    // Write the given encapsulation without copying its data if it's large
+    // enough, the request stream references the encapsulation memory and
+    // keeps the given owner alive until the request is sent. This allows
+    // sending the same encapsulation with many requests.
+    //
+    void writeParamEncaps(const ::Ice::Byte*, ::Ice::Int, const IceUtil::Handle<IceUtil::Shared>&);
+
 protected:
 
     const Ice::EncodingVersion _encoding;
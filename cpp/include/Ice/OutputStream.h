@@ -87,6 +87,15 @@ public:
 
     void setFormat(FormatType);
 
+    //
+    // Byte sequences whose size is greater or equal to the threshold are
+    // not copied to the stream, the stream references their memory with a
+    // buffer segment instead (see IceInternal::Buffer::Segment). The
+    // caller must ensure the memory remains valid until the stream is
+    // sent. A threshold of 0 (the default) disables this.
+    //
+    void setSegmentThreshold(Container::size_type);
+
     void* getClosure() const;
     void* setClosure(void*);
 
@@ -181,6 +190,13 @@ public:
         memcpy(&b[position], &v[0], sz);
     }
 
+    //
+    // Write an encapsulation without copying its data: the stream references
+    // the memory of the encapsulation with a buffer segment which keeps the
+    // given owner alive (see IceInternal::Buffer::Segment).
+    //
+    void writeEncapsulation(const Byte*, Int, const IceUtil::Handle<IceUtil::Shared>&);
+
     const EncodingVersion& getEncoding() const
     {
         return _currentEncaps ? _currentEncaps->encoding : _encoding;
@@ -741,6 +757,8 @@ private:
 
     FormatType _format;
 
+    Container::size_type _segmentThreshold;
+
     Encaps* _currentEncaps;
 
     void initEncaps();
@@ -55,6 +55,62 @@ const ::Ice::Byte replyMsg = 2;
 const ::Ice::Byte validateConnectionMsg = 3;
 const ::Ice::Byte closeConnectionMsg = 4;
 
+//
+// The Ice protocol compression codecs. bzip2 is the only codec
+// understood by all Ice versions, the other codecs are only used
+// with peers which advertised support for them.
+//
+const ::Ice::Byte compressionCodecNone = 0;
+const ::Ice::Byte compressionCodecBZip2 = 1;
+const ::Ice::Byte compressionCodecLZ4 = 2;
+const ::Ice::Byte compressionCodecZstd = 3;
+
+//
+// The compression status of a message is derived from the codec: an
+// odd value indicates that the message isn't compressed but that the
+// response, if any, should be compressed with the codec, an even
+// value indicates that the message is compressed with the codec. The
+// status values for bzip2 are therefore the historical values 1 and
+// 2.
+//
+// The validate connection message sent by the server carries instead
+// the set of codecs supported by the server (compressionCodecMask).
+//
+inline ::Ice::Byte
+compressionCodecSupportedStatus(::Ice::Byte codec)
+{
+    return codec == compressionCodecNone ? 0 : static_cast< ::Ice::Byte>(codec * 2 - 1);
+}
+
+inline ::Ice::Byte
+compressionCodecCompressedStatus(::Ice::Byte codec)
+{
+    return static_cast< ::Ice::Byte>(codec * 2);
+}
+
+inline ::Ice::Byte
+compressionStatusCodec(::Ice::Byte status)
+{
+    //
+    // Unknown codecs are mapped to bzip2, this matches the behavior of
+    // older Ice versions which don't check the compression status.
+    //
+    ::Ice::Byte codec = static_cast< ::Ice::Byte>((status + 1) / 2);
+    return codec > compressionCodecZstd ? compressionCodecBZip2 : codec;
+}
+
+inline bool
+compressionStatusCompressed(::Ice::Byte status)
+{
+    return status > 0 && status % 2 == 0;
+}
+
+inline ::Ice::Byte
+compressionCodecMask(::Ice::Byte codec)
+{
+    return static_cast< ::Ice::Byte>(1 << (codec - 1));
+}
+
 //
 // The request header, batch request header and reply header.
 //
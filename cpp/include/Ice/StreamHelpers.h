@@ -328,6 +328,33 @@ struct StreamableTraits< ::IceInternal::Handle<T> >
 };
 #endif
 
+//
+// IsWireCompatible<T>::value is true if the memory representation of T
+// is identical to its encoding on little-endian hosts. slice2cpp
+// specializes this template for structs which only contain numeric
+// members (other than bool) or such structs, and no padding. Vectors of
+// these structs are marshaled and unmarshaled with a single copy.
+//
+template<typename T>
+struct IsWireCompatible
+{
+    static const bool value = false;
+};
+
+template<typename T>
+struct IsWireCompatibleVector
+{
+    static const bool value = false;
+};
+
+#ifndef ICE_BIG_ENDIAN
+template<typename T>
+struct IsWireCompatibleVector< ::std::vector<T> >
+{
+    static const bool value = IsWireCompatible<T>::value;
+};
+#endif
+
 //
 // StreamHelper templates used by streams to read and write data.
 //
@@ -445,9 +472,9 @@ struct StreamHelper<T, StreamHelperCategoryEnum>
     }
 };
 
-// Helper for sequences
-template<typename T>
-struct StreamHelper<T, StreamHelperCategorySequence>
+// Helper for sequences, elements are marshaled one by one
+template<typename T, bool wireCompatible>
+struct StreamSequenceHelper
 {
     template<class S> static inline void
     write(S* stream, const T& v)
@@ -471,6 +498,51 @@ struct StreamHelper<T, StreamHelperCategorySequence>
     }
 };
 
+// Helper for vectors of wire compatible elements, the elements are copied at once
+template<typename T>
+struct StreamSequenceHelper<T, true>
+{
+    template<class S> static inline void
+    write(S* stream, const T& v)
+    {
+        stream->writeSize(static_cast<Int>(v.size()));
+        if(!v.empty())
+        {
+            stream->writeBlob(reinterpret_cast<const Byte*>(&v[0]), v.size() * sizeof(typename T::value_type));
+        }
+    }
+
+    template<class S> static inline void
+    read(S* stream, T& v)
+    {
+        Int sz = stream->readAndCheckSeqSize(StreamableTraits<typename T::value_type>::minWireSize);
+        T(sz).swap(v);
+        if(sz > 0)
+        {
+            const Byte* p;
+            stream->readBlob(p, v.size() * sizeof(typename T::value_type));
+            memcpy(&v[0], p, v.size() * sizeof(typename T::value_type));
+        }
+    }
+};
+
+// Helper for sequences
+template<typename T>
+struct StreamHelper<T, StreamHelperCategorySequence>
+{
+    template<class S> static inline void
+    write(S* stream, const T& v)
+    {
+        StreamSequenceHelper<T, IsWireCompatibleVector<T>::value>::write(stream, v);
+    }
+
+    template<class S> static inline void
+    read(S* stream, T& v)
+    {
+        StreamSequenceHelper<T, IsWireCompatibleVector<T>::value>::read(stream, v);
+    }
+};
+
 // Helper for array custom sequence parameters
 template<typename T>
 struct StreamHelper<std::pair<const T*, const T*>, StreamHelperCategorySequence>
@@ -181,6 +181,98 @@ private:
 
 #endif
 
+//
+// A pointer which can be atomically loaded, exchanged and compared and
+// exchanged. It's also a very partial placeholder for std::atomic<T*>.
+//
+template<typename T>
+class AtomicPtr : public IceUtil::noncopyable
+{
+public:
+
+    AtomicPtr() :
+        _ptr(0)
+    {
+    }
+
+    inline T* load() const
+    {
+#if defined(ICE_CPP11_COMPILER_HAS_ATOMIC)
+        return _ptr.load();
+#elif defined(_WIN32)
+        return static_cast<T*>(InterlockedCompareExchangePointer(const_cast<PVOID volatile*>(&_ptr), 0, 0));
+#elif defined(ICE_HAS_GCC_BUILTINS)
+        return __sync_val_compare_and_swap(const_cast<T* volatile*>(&_ptr), static_cast<T*>(0), static_cast<T*>(0));
+#else
+        IceUtil::Mutex::Lock sync(_mutex);
+        return _ptr;
+#endif
+    }
+
+    inline T* exchange(T* desired)
+    {
+#if defined(ICE_CPP11_COMPILER_HAS_ATOMIC)
+        return _ptr.exchange(desired);
+#elif defined(_WIN32)
+        return static_cast<T*>(InterlockedExchangePointer(&_ptr, desired));
+#elif defined(ICE_HAS_GCC_BUILTINS)
+        __sync_synchronize();
+        return __sync_lock_test_and_set(&_ptr, desired);
+#else
+        IceUtil::Mutex::Lock sync(_mutex);
+        T* tmp = _ptr;
+        _ptr = desired;
+        return tmp;
+#endif
+    }
+
+    //
+    // Set the pointer to desired if it's equal to expected. Otherwise,
+    // expected is set to the current value and false is returned.
+    //
+    inline bool compare_exchange(T*& expected, T* desired)
+    {
+#if defined(ICE_CPP11_COMPILER_HAS_ATOMIC)
+        return _ptr.compare_exchange_weak(expected, desired);
+#else
+        T* current;
+#   if defined(_WIN32)
+        current = static_cast<T*>(InterlockedCompareExchangePointer(&_ptr, desired, expected));
+#   elif defined(ICE_HAS_GCC_BUILTINS)
+        current = __sync_val_compare_and_swap(&_ptr, expected, desired);
+#   else
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            current = _ptr;
+            if(current == expected)
+            {
+                _ptr = desired;
+            }
+        }
+#   endif
+        if(current == expected)
+        {
+            return true;
+        }
+        expected = current;
+        return false;
+#endif
+    }
+
+private:
+
+#if defined(ICE_CPP11_COMPILER_HAS_ATOMIC)
+    std::atomic<T*> _ptr;
+#elif defined(_WIN32)
+    PVOID volatile _ptr;
+#else
+    T* volatile _ptr;
+#   if !defined(ICE_HAS_GCC_BUILTINS)
+    mutable IceUtil::Mutex _mutex;
+#   endif
+#endif
+};
+
 }
 
 #endif
@@ -69,7 +69,7 @@ public:
                               const IceUtil::Optional<Ice::ACMHeartbeat>&);
     virtual Ice::ACM getACM();
 
-    void destroy();
+    virtual void destroy();
     void swapReapedConnections(std::vector<Ice::ConnectionIPtr>&);
 
 private:
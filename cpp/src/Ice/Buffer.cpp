@@ -8,17 +8,78 @@
 // **********************************************************************
 
 #include <Ice/Buffer.h>
+#include <Ice/BufferPool.h>
 #include <Ice/LocalException.h>
 
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
 
+IceInternal::BufferMemory::BufferMemory(Ice::Byte* buf, size_t capacity) :
+    _buf(buf),
+    _capacity(capacity)
+{
+}
+
+IceInternal::BufferMemory::~BufferMemory()
+{
+    releaseBuffer(_buf, _capacity);
+}
+
+IceInternal::Buffer::Buffer(Buffer& o, bool adopt) : b(o.b, adopt), i(b.begin())
+{
+    //
+    // The segments of the other buffer are copied, the buffer memory is
+    // either adopted or shared with the other buffer.
+    //
+    if(!o.segments.empty())
+    {
+        segments.swap(o.segments);
+        copySegments();
+    }
+}
+
 void
 IceInternal::Buffer::swapBuffer(Buffer& other)
 {
     b.swap(other.b);
     std::swap(i, other.i);
+    segments.swap(other.segments);
+}
+
+void
+IceInternal::Buffer::copySegments()
+{
+    for(vector<Segment>::const_iterator p = segments.begin(); p != segments.end(); ++p)
+    {
+        if(p->offset + p->size <= b.size())
+        {
+            memcpy(b.begin() + p->offset, p->data, p->size);
+        }
+    }
+    segments.clear();
+}
+
+void
+IceInternal::Buffer::copyUnownedSegments()
+{
+    vector<Segment>::iterator q = segments.begin();
+    for(vector<Segment>::iterator p = segments.begin(); p != segments.end(); ++p)
+    {
+        if(p->owner)
+        {
+            if(q != p)
+            {
+                *q = *p;
+            }
+            ++q;
+        }
+        else if(p->offset + p->size <= b.size())
+        {
+            memcpy(b.begin() + p->offset, p->data, p->size);
+        }
+    }
+    segments.erase(q, segments.end());
 }
 
 IceInternal::Buffer::Container::Container() :
@@ -67,12 +128,14 @@ IceInternal::Buffer::Container::Container(Container& other, bool adopt)
         _capacity = other._capacity;
         _shrinkCounter = other._shrinkCounter;
         _owned = other._owned;
+        _memory = other._memory;
 
         other._buf = 0;
         other._size = 0;
         other._capacity = 0;
         other._shrinkCounter = 0;
         other._owned = true;
+        other._memory = 0;
     }
     else
     {
@@ -81,6 +144,7 @@ IceInternal::Buffer::Container::Container(Container& other, bool adopt)
         _capacity = other._capacity;
         _shrinkCounter = 0;
         _owned = false;
+        _memory = other._memory;
     }
 }
 
@@ -88,7 +152,7 @@ IceInternal::Buffer::Container::~Container()
 {
     if(_buf && _owned)
     {
-        ::free(_buf);
+        releaseBuffer(_buf, _capacity);
     }
 }
 
@@ -100,6 +164,7 @@ IceInternal::Buffer::Container::swap(Container& other)
     std::swap(_capacity, other._capacity);
     std::swap(_shrinkCounter, other._shrinkCounter);
     std::swap(_owned, other._owned);
+    _memory.swap(other._memory);
 }
 
 void
@@ -107,7 +172,7 @@ IceInternal::Buffer::Container::clear()
 {
     if(_buf && _owned)
     {
-        ::free(_buf);
+        releaseBuffer(_buf, _capacity);
     }
 
     _buf = 0;
@@ -115,6 +180,22 @@ IceInternal::Buffer::Container::clear()
     _capacity = 0;
     _shrinkCounter = 0;
     _owned = true;
+    _memory = 0;
+}
+
+IceInternal::BufferMemoryPtr
+IceInternal::Buffer::Container::share()
+{
+    if(_buf && _owned)
+    {
+        //
+        // Transfer the ownership of the memory to the shared memory
+        // object, the container keeps a reference until it's cleared.
+        //
+        _memory = new BufferMemory(_buf, _capacity);
+        _owned = false;
+    }
+    return _memory;
 }
 
 void
@@ -135,18 +216,29 @@ IceInternal::Buffer::Container::reserve(size_type n)
         return;
     }
 
+    //
+    // Buffers are allocated from the buffer pool which rounds up the
+    // capacity to the size of its size classes.
+    //
+    _capacity = bufferCapacity(_capacity);
+    if(_capacity == c && _owned)
+    {
+        return;
+    }
+
     pointer p;
     if(_owned)
     {
-        p = reinterpret_cast<pointer>(::realloc(_buf, _capacity));
+        p = reallocateBuffer(_buf, c, _capacity, _size);
     }
     else
     {
-        p = reinterpret_cast<pointer>(::malloc(_capacity));
+        p = allocateBuffer(_capacity);
         if(p)
         {
             ::memcpy(p, _buf, _size);
             _owned = true;
+            _memory = 0;
         }
     }
 
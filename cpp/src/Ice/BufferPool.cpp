@@ -0,0 +1,361 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/BufferPool.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/MutexPtrLock.h>
+
+#ifndef _WIN32
+#   include <pthread.h>
+#endif
+
+using namespace std;
+using namespace IceInternal;
+
+namespace
+{
+
+const size_t minSizeShift = 8; // 256 bytes
+const size_t maxSizeShift = 16; // 64KB
+const size_t sizeClassCount = maxSizeShift - minSizeShift + 1;
+const size_t maxPooledSize = static_cast<size_t>(1) << maxSizeShift;
+
+//
+// The maximum number of buffers of a size class cached by the shared
+// pool is bounded by the memory they use, with at most 1024 buffers.
+//
+const size_t maxPoolMemory = 4 * 1024 * 1024;
+const size_t maxPoolBuffers = 1024;
+
+struct SizeClass
+{
+    SizeClass() : max(0), allocated(0), hits(0), released(0)
+    {
+    }
+
+    vector<Ice::Byte*> buffers;
+    size_t max;
+    Ice::Long allocated;
+    Ice::Long hits;
+    Ice::Long released;
+};
+
+IceUtil::Mutex* poolMutex = 0;
+SizeClass* sizeClasses = 0;
+
+inline size_t
+sizeClassIndex(size_t capacity)
+{
+    assert(capacity <= maxPooledSize && (capacity & (capacity - 1)) == 0);
+    size_t index = 0;
+    while((static_cast<size_t>(1) << (index + minSizeShift)) < capacity)
+    {
+        ++index;
+    }
+    return index;
+}
+
+//
+// Must be called with the pool mutex locked.
+//
+void
+releaseToPool(SizeClass& sizeClass, Ice::Byte* buf)
+{
+    if(sizeClass.buffers.size() < sizeClass.max)
+    {
+        sizeClass.buffers.push_back(buf);
+    }
+    else
+    {
+        ::free(buf);
+    }
+}
+
+#ifndef _WIN32
+
+//
+// The number of buffers of each size class cached by a thread, the
+// thread exchanges half of its cache with the shared pool when its
+// cache is empty or full. The counters of the thread are added to
+// the shared pool counters at the latest every flushCount allocations.
+//
+const size_t threadCacheSize = 8;
+const Ice::Long flushCount = 256;
+
+struct ThreadCache
+{
+    ThreadCache()
+    {
+        for(size_t i = 0; i < sizeClassCount; ++i)
+        {
+            buffers[i].reserve(threadCacheSize + 1);
+            allocated[i] = 0;
+            hits[i] = 0;
+            released[i] = 0;
+        }
+    }
+
+    vector<Ice::Byte*> buffers[sizeClassCount];
+    Ice::Long allocated[sizeClassCount];
+    Ice::Long hits[sizeClassCount];
+    Ice::Long released[sizeClassCount];
+};
+
+pthread_key_t threadCacheKey;
+
+//
+// Add the thread counters to the shared pool counters and keep at most
+// the given number of buffers in the thread cache. Must be called with
+// the pool mutex locked.
+//
+void
+flush(ThreadCache* cache, size_t index, size_t keep)
+{
+    SizeClass& sizeClass = sizeClasses[index];
+    sizeClass.allocated += cache->allocated[index];
+    sizeClass.hits += cache->hits[index];
+    sizeClass.released += cache->released[index];
+    cache->allocated[index] = 0;
+    cache->hits[index] = 0;
+    cache->released[index] = 0;
+
+    vector<Ice::Byte*>& buffers = cache->buffers[index];
+    while(buffers.size() > keep)
+    {
+        releaseToPool(sizeClass, buffers.back());
+        buffers.pop_back();
+    }
+}
+
+ThreadCache*
+getThreadCache()
+{
+    ThreadCache* cache = static_cast<ThreadCache*>(pthread_getspecific(threadCacheKey));
+    if(!cache)
+    {
+        cache = new ThreadCache;
+        if(pthread_setspecific(threadCacheKey, cache) != 0)
+        {
+            delete cache;
+            return 0;
+        }
+    }
+    return cache;
+}
+
+#endif
+
+}
+
+#ifndef _WIN32
+extern "C" void
+iceBufferPoolThreadCacheDestructor(void* p)
+{
+    ThreadCache* cache = static_cast<ThreadCache*>(p);
+    if(!cache)
+    {
+        return;
+    }
+
+    IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(poolMutex);
+    for(size_t i = 0; i < sizeClassCount; ++i)
+    {
+        flush(cache, i, 0);
+    }
+    delete cache;
+}
+#endif
+
+namespace
+{
+
+//
+// The pool is never destroyed: threads that are still running during
+// static destruction, or thread cache destructors that run after it,
+// may still allocate or release buffers.
+//
+class Init
+{
+public:
+
+    Init()
+    {
+        poolMutex = new IceUtil::Mutex;
+        sizeClasses = new SizeClass[sizeClassCount];
+        for(size_t i = 0; i < sizeClassCount; ++i)
+        {
+            sizeClasses[i].max = min(maxPoolBuffers, maxPoolMemory >> (i + minSizeShift));
+        }
+
+#ifndef _WIN32
+        if(pthread_key_create(&threadCacheKey, &iceBufferPoolThreadCacheDestructor) != 0)
+        {
+            //
+            // Without thread caches, buffers are not pooled. We don't throw
+            // here since we're called during static initialization.
+            //
+            delete[] sizeClasses;
+            sizeClasses = 0;
+        }
+#endif
+    }
+};
+
+Init init;
+
+}
+
+size_t
+IceInternal::bufferCapacity(size_t size)
+{
+    if(size > maxPooledSize)
+    {
+        return size;
+    }
+
+    size_t capacity = static_cast<size_t>(1) << minSizeShift;
+    while(capacity < size)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+Ice::Byte*
+IceInternal::allocateBuffer(size_t capacity)
+{
+    if(capacity > maxPooledSize || !sizeClasses)
+    {
+        return reinterpret_cast<Ice::Byte*>(::malloc(capacity));
+    }
+
+    size_t index = sizeClassIndex(capacity);
+
+#ifndef _WIN32
+    ThreadCache* cache = getThreadCache();
+    if(cache)
+    {
+        vector<Ice::Byte*>& buffers = cache->buffers[index];
+        if(++cache->allocated[index] >= flushCount || buffers.empty())
+        {
+            //
+            // Refill the thread cache from the shared pool and add the
+            // thread counters to the shared pool counters.
+            //
+            IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(poolMutex);
+            vector<Ice::Byte*>& pooled = sizeClasses[index].buffers;
+            while(buffers.size() < threadCacheSize / 2 && !pooled.empty())
+            {
+                buffers.push_back(pooled.back());
+                pooled.pop_back();
+            }
+            flush(cache, index, threadCacheSize);
+        }
+
+        if(buffers.empty())
+        {
+            return reinterpret_cast<Ice::Byte*>(::malloc(capacity));
+        }
+        ++cache->hits[index];
+        Ice::Byte* buf = buffers.back();
+        buffers.pop_back();
+        return buf;
+    }
+#endif
+
+    {
+        IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(poolMutex);
+        SizeClass& sizeClass = sizeClasses[index];
+        ++sizeClass.allocated;
+        if(!sizeClass.buffers.empty())
+        {
+            ++sizeClass.hits;
+            Ice::Byte* buf = sizeClass.buffers.back();
+            sizeClass.buffers.pop_back();
+            return buf;
+        }
+    }
+    return reinterpret_cast<Ice::Byte*>(::malloc(capacity));
+}
+
+Ice::Byte*
+IceInternal::reallocateBuffer(Ice::Byte* buf, size_t oldCapacity, size_t capacity, size_t size)
+{
+    if(oldCapacity > maxPooledSize && capacity > maxPooledSize)
+    {
+        return reinterpret_cast<Ice::Byte*>(::realloc(buf, capacity));
+    }
+
+    Ice::Byte* p = allocateBuffer(capacity);
+    if(p && buf)
+    {
+        ::memcpy(p, buf, min(size, capacity));
+        releaseBuffer(buf, oldCapacity);
+    }
+    return p;
+}
+
+void
+IceInternal::releaseBuffer(Ice::Byte* buf, size_t capacity)
+{
+    if(!buf)
+    {
+        return;
+    }
+
+    if(capacity > maxPooledSize || !sizeClasses)
+    {
+        ::free(buf);
+        return;
+    }
+
+    size_t index = sizeClassIndex(capacity);
+
+#ifndef _WIN32
+    ThreadCache* cache = getThreadCache();
+    if(cache)
+    {
+        ++cache->released[index];
+        vector<Ice::Byte*>& buffers = cache->buffers[index];
+        buffers.push_back(buf);
+        if(buffers.size() > threadCacheSize)
+        {
+            IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(poolMutex);
+            flush(cache, index, threadCacheSize / 2);
+        }
+        return;
+    }
+#endif
+
+    IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(poolMutex);
+    SizeClass& sizeClass = sizeClasses[index];
+    ++sizeClass.released;
+    releaseToPool(sizeClass, buf);
+}
+
+vector<BufferPoolStats>
+IceInternal::getBufferPoolStats()
+{
+    vector<BufferPoolStats> stats;
+    IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(poolMutex);
+    if(sizeClasses)
+    {
+        for(size_t i = 0; i < sizeClassCount; ++i)
+        {
+            BufferPoolStats s;
+            s.size = static_cast<size_t>(1) << (i + minSizeShift);
+            s.allocated = sizeClasses[i].allocated;
+            s.hits = sizeClasses[i].hits;
+            s.released = sizeClasses[i].released;
+            s.cached = static_cast<int>(sizeClasses[i].buffers.size());
+            stats.push_back(s);
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,58 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_BUFFER_POOL_H
+#define ICE_BUFFER_POOL_H
+
+#include <Ice/Config.h>
+
+namespace IceInternal
+{
+
+//
+// The memory of buffer containers is allocated from a process-wide
+// pool. Buffers up to 64KB are allocated in power of two size classes
+// and are recycled, larger buffers are allocated with malloc. Each
+// thread caches a few buffers of each size class and exchanges buffers
+// in batches with the shared pool. The pool and its statistics are
+// shared by all the communicators of the process.
+//
+
+//
+// Statistics of a size class of the buffer pool. The counters of the
+// thread caches are only periodically added to these counters.
+//
+struct BufferPoolStats
+{
+    size_t size; // The size of the buffers of the class.
+    Ice::Long allocated; // The number of allocated buffers.
+    Ice::Long hits; // The number of allocations served with a recycled buffer.
+    Ice::Long released; // The number of released buffers.
+    int cached; // The number of buffers cached by the shared pool.
+};
+
+//
+// Returns the capacity to allocate for the given size.
+//
+size_t bufferCapacity(size_t);
+
+//
+// Allocate, re-allocate or release buffer memory. The capacity must be
+// a capacity returned by bufferCapacity(). Like malloc and realloc, the
+// allocation functions return 0 if the memory can't be allocated.
+//
+Ice::Byte* allocateBuffer(size_t);
+Ice::Byte* reallocateBuffer(Ice::Byte*, size_t, size_t, size_t);
+void releaseBuffer(Ice::Byte*, size_t);
+
+std::vector<BufferPoolStats> getBufferPoolStats();
+
+}
+
+#endif
@@ -44,6 +44,7 @@ using namespace Ice::Instrumentation;
 using namespace IceInternal;
 
 IceUtil::Shared* IceInternal::upCast(OutgoingConnectionFactory* p) { return p; }
+IceUtil::Shared* IceInternal::upCast(ConnectionPool* p) { return p; }
 
 #ifndef ICE_CPP11_MAPPING
 IceUtil::Shared* IceInternal::upCast(IncomingConnectionFactory* p) { return p; }
@@ -126,6 +127,158 @@ find(const multimap<K,::IceInternal::Handle<V> >& m,
 }
 #endif
 
+//
+// Returns the least loaded active or holding connection for the given
+// key and the number of such connections.
+//
+template<typename Map> typename Map::mapped_type
+findLeastLoaded(const Map& m, const typename Map::key_type& k, int& count)
+{
+    typename Map::mapped_type connection;
+    int outstanding = -1;
+    count = 0;
+    pair<typename Map::const_iterator, typename Map::const_iterator> pr = m.equal_range(k);
+    for(typename Map::const_iterator q = pr.first; q != pr.second; ++q)
+    {
+        int n = q->second->outstandingRequests();
+        if(n >= 0)
+        {
+            ++count;
+            if(outstanding < 0 || n < outstanding)
+            {
+                connection = q->second;
+                outstanding = n;
+            }
+        }
+    }
+    return connection;
+}
+
+}
+
+class IceInternal::OutgoingConnectionFactory::ConnectionPoolACMMonitor : public FactoryACMMonitor
+{
+public:
+
+    ConnectionPoolACMMonitor(const OutgoingConnectionFactoryPtr& factory, const InstancePtr& instance,
+                             const ACMConfig& config) :
+        FactoryACMMonitor(instance, config),
+        _factory(factory)
+    {
+    }
+
+    virtual void
+    destroy()
+    {
+        FactoryACMMonitor::destroy();
+
+        //
+        // Break the cycle with the factory, connections might still be
+        // reaped once the factory is destroyed.
+        //
+        Lock sync(*this);
+        _factory = 0;
+    }
+
+    virtual void
+    reap(const ConnectionIPtr& connection)
+    {
+        FactoryACMMonitor::reap(connection);
+
+        OutgoingConnectionFactoryPtr factory;
+        {
+            Lock sync(*this);
+            factory = _factory;
+        }
+
+        //
+        // This is called with the connection mutex locked, the pool is
+        // grown again from the timer thread.
+        //
+        if(factory)
+        {
+            factory->scheduleGrowConnectionPool(ConnectorInfo(connection->connector(), connection->endpoint()), 0,
+                                                connection);
+        }
+    }
+
+private:
+
+    OutgoingConnectionFactoryPtr _factory;
+};
+
+IceInternal::ConnectionPool::ConnectionPool() : _next(0)
+{
+}
+
+void
+IceInternal::ConnectionPool::add(const Ice::ConnectionIPtr& connection)
+{
+    Lock sync(*this);
+    _connections.push_back(connection);
+}
+
+void
+IceInternal::ConnectionPool::remove(const Ice::ConnectionIPtr& connection)
+{
+    Lock sync(*this);
+    vector<Ice::ConnectionIPtr>::iterator p = find(_connections.begin(), _connections.end(), connection);
+    if(p != _connections.end())
+    {
+        _connections.erase(p);
+    }
+}
+
+bool
+IceInternal::ConnectionPool::empty() const
+{
+    Lock sync(*this);
+    return _connections.empty();
+}
+
+int
+IceInternal::ConnectionPool::size() const
+{
+    Lock sync(*this);
+    int count = 0;
+    for(vector<Ice::ConnectionIPtr>::const_iterator p = _connections.begin(); p != _connections.end(); ++p)
+    {
+        if((*p)->outstandingRequests() >= 0)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+Ice::ConnectionIPtr
+IceInternal::ConnectionPool::select(const Ice::ConnectionIPtr& connection)
+{
+    Lock sync(*this);
+    Ice::ConnectionIPtr selected = connection;
+    int outstanding = -1;
+    const size_t sz = _connections.size();
+    for(size_t i = 0; i < sz; ++i)
+    {
+        //
+        // Start with a different connection each time to spread the
+        // requests over the connections which have no outstanding
+        // requests.
+        //
+        const Ice::ConnectionIPtr& c = _connections[(_next + i) % sz];
+        int n = c->outstandingRequests();
+        if(n >= 0 && (outstanding < 0 || n < outstanding))
+        {
+            selected = c;
+            outstanding = n;
+            if(outstanding == 0)
+            {
+                break;
+            }
+        }
+    }
+    ++_next;
+    return selected;
 }
 
 bool
@@ -199,6 +352,7 @@ IceInternal::OutgoingConnectionFactory::waitUntilFinished()
         cons.clear();
         _connections.clear();
         _connectionsByEndpoint.clear();
+        _connectionPools.clear();
         _monitor->destroy();
     }
 }
@@ -235,9 +389,9 @@ IceInternal::OutgoingConnectionFactory::create(const vector<EndpointIPtr>& endpt
     }
 
 #ifdef ICE_CPP11_MAPPING
-    auto cb = make_shared<ConnectCallback>(_instance, this, endpoints, hasMore, callback, selType);
+    auto cb = make_shared<ConnectCallback>(_instance, this, endpoints, hasMore, callback, selType, false);
 #else
-    ConnectCallbackPtr cb = new ConnectCallback(_instance, this, endpoints, hasMore, callback, selType);
+    ConnectCallbackPtr cb = new ConnectCallback(_instance, this, endpoints, hasMore, callback, selType, false);
 #endif
     cb->getConnectors();
 }
@@ -296,6 +450,14 @@ IceInternal::OutgoingConnectionFactory::setRouterInfo(const RouterInfoPtr& route
     }
 }
 
+ConnectionPoolPtr
+IceInternal::OutgoingConnectionFactory::getConnectionPool(const ConnectionIPtr& connection)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    map<ConnectorPtr, ConnectionPoolPtr>::const_iterator p = _connectionPools.find(connection->connector());
+    return p != _connectionPools.end() ? p->second : ConnectionPoolPtr();
+}
+
 void
 IceInternal::OutgoingConnectionFactory::removeAdapter(const ObjectAdapterPtr& adapter)
 {
@@ -349,7 +511,11 @@ IceInternal::OutgoingConnectionFactory::OutgoingConnectionFactory(const Communic
                                                                   const InstancePtr& instance) :
     _communicator(communicator),
     _instance(instance),
-    _monitor(new FactoryACMMonitor(instance, instance->clientACM())),
+    _monitor(instance->defaultsAndOverrides()->defaultConnectionPoolSize > 1 ?
+             new ConnectionPoolACMMonitor(this, instance, instance->clientACM()) :
+             new FactoryACMMonitor(instance, instance->clientACM())),
+    _connectionPoolSize(instance->defaultsAndOverrides()->defaultConnectionPoolSize),
+    _parallelConnect(instance->defaultsAndOverrides()->defaultParallelConnect),
     _destroyed(false),
     _pendingConnectCount(0)
 {
@@ -395,7 +561,16 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr
     assert(!endpoints.empty());
     for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
     {
-        ConnectionIPtr connection = find(_connectionsByEndpoint, *p, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
+        ConnectionIPtr connection;
+        if(_connectionPoolSize > 1)
+        {
+            int count;
+            connection = findLeastLoaded(_connectionsByEndpoint, *p, count);
+        }
+        else
+        {
+            connection = find(_connectionsByEndpoint, *p, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
+        }
         if(connection)
         {
             if(defaultsAndOverrides->overrideCompress)
@@ -413,19 +588,36 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr
 }
 
 ConnectionIPtr
-IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInfo>& connectors, bool& compress)
+IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInfo>& connectors, bool growPool,
+                                                       bool& compress)
 {
     // This must be called with the mutex locked.
 
     DefaultsAndOverridesPtr defaultsAndOverrides = _instance->defaultsAndOverrides();
     for(vector<ConnectorInfo>::const_iterator p = connectors.begin(); p != connectors.end(); ++p)
     {
-        if(_pending.find(p->connector) != _pending.end())
+        bool pending = _pending.find(p->connector) != _pending.end();
+
+        ConnectionIPtr connection;
+        if(_connectionPoolSize > 1)
+        {
+            //
+            // Pooled connections remain usable while another connection
+            // to the connector is established, unless we're the one
+            // establishing connections to grow the pool.
+            //
+            int count;
+            connection = findLeastLoaded(_connections, p->connector, count);
+            if(growPool && (pending || count < _connectionPoolSize))
+            {
+                return 0;
+            }
+        }
+        else if(!pending)
         {
-            continue;
+            connection = find(_connections, p->connector, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
         }
 
-        ConnectionIPtr connection = find(_connections, p->connector, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
         if(connection)
         {
             if(defaultsAndOverrides->overrideCompress)
@@ -496,6 +688,7 @@ IceInternal::OutgoingConnectionFactory::getConnection(const vector<ConnectorInfo
             remove(_connections, (*p)->connector(), *p);
             remove(_connectionsByEndpoint, (*p)->endpoint(), *p);
             remove(_connectionsByEndpoint, (*p)->endpoint()->compress(true), *p);
+            removeFromConnectionPool(*p);
         }
 
         //
@@ -513,7 +706,7 @@ IceInternal::OutgoingConnectionFactory::getConnection(const vector<ConnectorInfo
             //
             // Search for a matching connection. If we find one, we're done.
             //
-            Ice::ConnectionIPtr connection = findConnection(connectors, compress);
+            Ice::ConnectionIPtr connection = findConnection(connectors, cb && cb->growPool(), compress);
             if(connection)
             {
                 return connection;
@@ -621,8 +814,14 @@ IceInternal::OutgoingConnectionFactory::finishGetConnection(const vector<Connect
     }
 
     set<ConnectCallbackPtr> callbacks;
+    bool growPool = false;
     {
         IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        if(_connectionPoolSize > 1)
+        {
+            growPool = addToConnectionPool(ci, connection);
+        }
+
         for(vector<ConnectorInfo>::const_iterator p = connectors.begin(); p != connectors.end(); ++p)
         {
             map<ConnectorPtr, set<ConnectCallbackPtr> >::iterator q = _pending.find(p->connector);
@@ -674,6 +873,11 @@ IceInternal::OutgoingConnectionFactory::finishGetConnection(const vector<Connect
     {
         (*p)->setConnection(connection, compress);
     }
+
+    if(growPool)
+    {
+        growConnectionPool(ci, 0);
+    }
 }
 
 void
@@ -783,6 +987,118 @@ IceInternal::OutgoingConnectionFactory::removeFromPending(const ConnectCallbackP
     }
 }
 
+bool
+IceInternal::OutgoingConnectionFactory::addToConnectionPool(const ConnectorInfo& ci, const ConnectionIPtr& connection)
+{
+    // This must be called with the mutex locked.
+
+    if(_destroyed)
+    {
+        return false;
+    }
+
+    ConnectionPoolPtr& pool = _connectionPools[ci.connector];
+    if(!pool)
+    {
+        pool = new ConnectionPool();
+    }
+    pool->add(connection);
+    return pool->size() < _connectionPoolSize;
+}
+
+void
+IceInternal::OutgoingConnectionFactory::removeFromConnectionPool(const ConnectionIPtr& connection)
+{
+    // This must be called with the mutex locked.
+
+    map<ConnectorPtr, ConnectionPoolPtr>::iterator p = _connectionPools.find(connection->connector());
+    if(p != _connectionPools.end())
+    {
+        p->second->remove(connection);
+        if(p->second->empty())
+        {
+            _connectionPools.erase(p);
+        }
+    }
+}
+
+void
+IceInternal::OutgoingConnectionFactory::growConnectionPool(const ConnectorInfo& ci, int retry)
+{
+    //
+    // Establish another connection to the connector in the background.
+    // Once established, the connection is added to the pool and the
+    // pool is grown again until it's full.
+    //
+    vector<EndpointIPtr> endpoints;
+    endpoints.push_back(ci.endpoint);
+    CreateConnectionCallbackPtr callback = new ConnectionPoolCallback(this, ci, retry);
+#ifdef ICE_CPP11_MAPPING
+    auto cb = make_shared<ConnectCallback>(_instance, this, endpoints, false, callback,
+                                           Ice::EndpointSelectionType::Ordered, true);
+#else
+    ConnectCallbackPtr cb = new ConnectCallback(_instance, this, endpoints, false, callback, Ice::Ordered, true);
+#endif
+    cb->getConnectors();
+}
+
+void
+IceInternal::OutgoingConnectionFactory::regrowConnectionPool(const ConnectorInfo& ci, int retry)
+{
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        if(_destroyed)
+        {
+            return;
+        }
+
+        //
+        // The pool is only grown again if it still has connections, it's
+        // otherwise re-created by the next connection establishment.
+        //
+        map<ConnectorPtr, ConnectionPoolPtr>::const_iterator p = _connectionPools.find(ci.connector);
+        if(p == _connectionPools.end())
+        {
+            return;
+        }
+        int size = p->second->size();
+        if(size == 0 || size >= _connectionPoolSize)
+        {
+            return;
+        }
+    }
+    growConnectionPool(ci, retry);
+}
+
+void
+IceInternal::OutgoingConnectionFactory::scheduleGrowConnectionPool(const ConnectorInfo& ci, int retry,
+                                                                   const ConnectionIPtr& connection)
+{
+    //
+    // Closed connections are replaced right away, failed connection
+    // establishments are retried with an exponential backoff starting
+    // at 100ms and limited to 10s.
+    //
+    IceUtil::Time delay;
+    if(retry > 0)
+    {
+        delay = IceUtil::Time::milliSeconds(min(100 << min(retry - 1, 7), 10000));
+    }
+
+    try
+    {
+        _instance->timer()->schedule(ICE_MAKE_SHARED(ConnectionPoolTimerTask, this, ci, retry, connection), delay);
+    }
+    catch(const Ice::CommunicatorDestroyedException&)
+    {
+        // Ignore.
+    }
+    catch(const IceUtil::IllegalArgumentException&)
+    {
+        // Ignore, the communicator is being destroyed.
+    }
+}
+
 void
 IceInternal::OutgoingConnectionFactory::handleException(const LocalException& ex, bool hasMore)
 {
@@ -844,13 +1160,17 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::ConnectCallback(const I
                                                                          const vector<EndpointIPtr>& endpoints,
                                                                          bool hasMore,
                                                                          const CreateConnectionCallbackPtr& cb,
-                                                                         Ice::EndpointSelectionType selType) :
+                                                                         Ice::EndpointSelectionType selType,
+                                                                         bool growPool) :
     _instance(instance),
     _factory(factory),
     _endpoints(endpoints),
     _hasMore(hasMore),
     _callback(cb),
-    _selType(selType)
+    _selType(selType),
+    _growPool(growPool),
+    _parallel(false),
+    _done(false)
 {
     _endpointsIter = _endpoints.begin();
 }
@@ -861,6 +1181,38 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::ConnectCallback(const I
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartCompleted(const ConnectionIPtr& connection)
 {
+    if(_parallel)
+    {
+        vector<ConnectorInfo>::const_iterator p;
+        vector<Attempt> canceled;
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            vector<Attempt>::iterator q = _attempts.begin();
+            while(q != _attempts.end() && q->connection.get() != connection.get())
+            {
+                ++q;
+            }
+            if(q == _attempts.end())
+            {
+                return; // The attempt was canceled and the connection closed.
+            }
+
+            if(q->observer)
+            {
+                q->observer->detach();
+            }
+            p = q->connector;
+            _attempts.erase(q);
+            _attempts.swap(canceled);
+            _done = true;
+        }
+        cancel(canceled);
+
+        connection->activate();
+        _factory->finishGetConnection(_connectors, *p, connection, ICE_SHARED_FROM_THIS);
+        return;
+    }
+
     if(_observer)
     {
         _observer->detach();
@@ -871,9 +1223,36 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartComplete
 }
 
 void
-IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailed(const ConnectionIPtr& /*connection*/,
+IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailed(const ConnectionIPtr& connection,
                                                                                const LocalException& ex)
 {
+    if(_parallel)
+    {
+        Ice::Instrumentation::ObserverPtr observer;
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            vector<Attempt>::iterator q = _attempts.begin();
+            while(q != _attempts.end() && q->connection.get() != connection.get())
+            {
+                ++q;
+            }
+            if(q == _attempts.end())
+            {
+                return; // The attempt was canceled.
+            }
+            observer = q->observer;
+            _attempts.erase(q);
+        }
+
+        if(observer)
+        {
+            observer->failed(ex.ice_id());
+            observer->detach();
+        }
+        connectParallelFailed(ex);
+        return;
+    }
+
     assert(_iter != _connectors.end());
     if(connectionStartFailedImpl(ex))
     {
@@ -1004,40 +1383,32 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::getConnection()
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::nextConnector()
 {
-    while(true)
+    if(_factory->_parallelConnect > 0 && _iter != _connectors.end() && _iter + 1 != _connectors.end())
     {
         try
         {
-            const CommunicatorObserverPtr& obsv = _factory->_instance->initializationData().observer;
-            if(obsv)
-            {
-                _observer = obsv->getConnectionEstablishmentObserver(_iter->endpoint, _iter->connector->toString());
-                if(_observer)
-                {
-                    _observer->attach();
-                }
-            }
+            _timer = _instance->timer();
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            _factory->finishGetConnection(_connectors, ex, ICE_SHARED_FROM_THIS);
+            return;
+        }
+        _parallel = true;
+        connectParallel();
+        return;
+    }
 
+    while(true)
+    {
+        try
+        {
             assert(_iter != _connectors.end());
-
-            if(_instance->traceLevels()->network >= 2)
-            {
-                Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
-                out << "trying to establish " << _iter->endpoint->protocol() << " connection to "
-                    << _iter->connector->toString();
-            }
-            Ice::ConnectionIPtr connection = _factory->createConnection(_iter->connector->connect(), *_iter);
+            Ice::ConnectionIPtr connection = connect(*_iter, _observer);
             connection->start(ICE_SHARED_FROM_THIS);
         }
         catch(const Ice::LocalException& ex)
         {
-            if(_instance->traceLevels()->network >= 2)
-            {
-                Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
-                out << "failed to establish " << _iter->endpoint->protocol() << " connection to "
-                    << _iter->connector->toString() << "\n" << ex;
-            }
-
             if(connectionStartFailedImpl(ex))
             {
                 continue; // More connectors to try, continue.
@@ -1127,6 +1498,223 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailedIm
     return false;
 }
 
+Ice::ConnectionIPtr
+IceInternal::OutgoingConnectionFactory::ConnectCallback::connect(const ConnectorInfo& ci, ObserverPtr& observer)
+{
+    const CommunicatorObserverPtr& obsv = _factory->_instance->initializationData().observer;
+    if(obsv)
+    {
+        observer = obsv->getConnectionEstablishmentObserver(ci.endpoint, ci.connector->toString());
+        if(observer)
+        {
+            observer->attach();
+        }
+    }
+
+    if(_instance->traceLevels()->network >= 2)
+    {
+        Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+        out << "trying to establish " << ci.endpoint->protocol() << " connection to " << ci.connector->toString();
+    }
+
+    try
+    {
+        return _factory->createConnection(ci.connector->connect(), ci);
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        if(_instance->traceLevels()->network >= 2)
+        {
+            Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+            out << "failed to establish " << ci.endpoint->protocol() << " connection to "
+                << ci.connector->toString() << "\n" << ex;
+        }
+        throw;
+    }
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::runTimerTask()
+{
+    //
+    // The parallel connect delay expired and the pending connection
+    // attempts are not established yet, try the next connector.
+    //
+    connectParallel();
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::connectParallel()
+{
+    //
+    // The mutex is held while creating the connection to ensure the
+    // connector is still pending in the factory, it's released before
+    // starting the connection since start() might call back.
+    //
+    IceUtil::Mutex::Lock sync(_mutex);
+    if(_done || _iter == _connectors.end())
+    {
+        return;
+    }
+
+    vector<ConnectorInfo>::const_iterator p = _iter++;
+    ObserverPtr observer;
+    Ice::ConnectionIPtr connection;
+    try
+    {
+        connection = connect(*p, observer);
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        sync.release();
+        if(observer)
+        {
+            observer->failed(ex.ice_id());
+            observer->detach();
+        }
+        connectParallelFailed(ex);
+        return;
+    }
+    _attempts.push_back(Attempt(connection, p, observer));
+
+    if(_iter != _connectors.end())
+    {
+        try
+        {
+            _timer->cancel(ICE_SHARED_FROM_THIS);
+            _timer->schedule(ICE_SHARED_FROM_THIS, IceUtil::Time::milliSeconds(_factory->_parallelConnect));
+        }
+        catch(const IceUtil::IllegalArgumentException&)
+        {
+            // Ignore, the communicator is being destroyed.
+        }
+    }
+    sync.release();
+
+    connection->start(ICE_SHARED_FROM_THIS);
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::connectParallelFailed(const Ice::LocalException& ex)
+{
+    vector<Attempt> canceled;
+    bool finished = false;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_done)
+        {
+            return;
+        }
+
+        //
+        // We're done if the communicator is destroyed or if there's no
+        // more connectors to try and no more pending attempts.
+        //
+        if(dynamic_cast<const Ice::CommunicatorDestroyedException*>(&ex) ||
+           (_iter == _connectors.end() && _attempts.empty()))
+        {
+            _attempts.swap(canceled);
+            _done = true;
+            finished = true;
+        }
+    }
+
+    _factory->handleConnectionException(ex, _hasMore || !finished);
+    if(finished)
+    {
+        cancel(canceled);
+        _factory->finishGetConnection(_connectors, ex, ICE_SHARED_FROM_THIS);
+    }
+    else
+    {
+        connectParallel(); // Try the next connector without waiting for the delay.
+    }
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::cancel(const vector<Attempt>& attempts)
+{
+    _timer->cancel(ICE_SHARED_FROM_THIS);
+    for(vector<Attempt>::const_iterator p = attempts.begin(); p != attempts.end(); ++p)
+    {
+        if(p->observer)
+        {
+            p->observer->detach();
+        }
+        p->connection->close(true);
+    }
+}
+
+IceInternal::OutgoingConnectionFactory::ConnectionPoolCallback::ConnectionPoolCallback(
+    const OutgoingConnectionFactoryPtr& factory, const ConnectorInfo& ci, int retry) :
+    _factory(factory),
+    _connectorInfo(ci),
+    _retry(retry)
+{
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectionPoolCallback::setConnection(const Ice::ConnectionIPtr&, bool)
+{
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectionPoolCallback::setException(const Ice::LocalException& ex)
+{
+    if(!dynamic_cast<const CommunicatorDestroyedException*>(&ex))
+    {
+        _factory->scheduleGrowConnectionPool(_connectorInfo, _retry + 1, ICE_NULLPTR);
+    }
+}
+
+IceInternal::OutgoingConnectionFactory::ConnectionPoolTimerTask::ConnectionPoolTimerTask(
+    const OutgoingConnectionFactoryPtr& factory, const ConnectorInfo& ci, int retry,
+    const Ice::ConnectionIPtr& connection) :
+    _factory(factory),
+    _connectorInfo(ci),
+    _retry(retry),
+    _connection(connection)
+{
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectionPoolTimerTask::runTimerTask()
+{
+    if(_connection)
+    {
+        //
+        // Only connections lost abnormally are replaced. Connections closed
+        // gracefully by either peer, idle connections closed by ACM and
+        // connections closed because the peer stopped responding aren't
+        // replaced.
+        //
+        try
+        {
+            _connection->throwException();
+        }
+        catch(const Ice::CloseConnectionException&)
+        {
+            return;
+        }
+        catch(const Ice::ForcedCloseConnectionException&)
+        {
+            return;
+        }
+        catch(const Ice::ConnectionTimeoutException&)
+        {
+            return;
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+            return;
+        }
+        catch(const Ice::LocalException&)
+        {
+        }
+    }
+    _factory->regrowConnectionPool(_connectorInfo, _retry);
+}
+
 void
 IceInternal::IncomingConnectionFactory::activate()
 {
@@ -12,6 +12,7 @@
 
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
+#include <IceUtil/Timer.h>
 #include <Ice/CommunicatorF.h>
 #include <Ice/ConnectionFactoryF.h>
 #include <Ice/ConnectionI.h>
@@ -44,6 +45,38 @@ ICE_DEFINE_PTR(ObjectAdapterIPtr, ObjectAdapterI);
 namespace IceInternal
 {
 
+//
+// The connections established to the same connector when connection
+// pooling is enabled with Ice.Default.ConnectionPoolSize. Requests are
+// sent over the pooled connection with the least outstanding requests.
+//
+class ConnectionPool : public IceUtil::Shared, public IceUtil::Mutex
+{
+public:
+
+    ConnectionPool();
+
+    void add(const Ice::ConnectionIPtr&);
+    void remove(const Ice::ConnectionIPtr&);
+    bool empty() const;
+
+    //
+    // Returns the number of active or holding connections.
+    //
+    int size() const;
+
+    //
+    // Returns the least loaded connection, or the given connection if
+    // none of the pooled connections is active or holding.
+    //
+    Ice::ConnectionIPtr select(const Ice::ConnectionIPtr&);
+
+private:
+
+    std::vector<Ice::ConnectionIPtr> _connections;
+    size_t _next;
+};
+
 class OutgoingConnectionFactory : public virtual IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
@@ -68,6 +101,8 @@ public:
     void removeAdapter(const Ice::ObjectAdapterPtr&);
     void flushAsyncBatchRequests(const CommunicatorFlushBatchAsyncPtr&);
 
+    ConnectionPoolPtr getConnectionPool(const Ice::ConnectionIPtr&);
+
     OutgoingConnectionFactory(const Ice::CommunicatorPtr&, const InstancePtr&);
     virtual ~OutgoingConnectionFactory();
     friend class Instance;
@@ -87,7 +122,8 @@ private:
     };
 
     class ConnectCallback : public Ice::ConnectionI::StartCallback,
-                            public IceInternal::EndpointI_connectors
+                            public IceInternal::EndpointI_connectors,
+                            public IceUtil::TimerTask
 #ifdef ICE_CPP11_MAPPING
                           , public std::enable_shared_from_this<ConnectCallback>
 #endif
@@ -96,7 +132,7 @@ private:
     public:
 
         ConnectCallback(const InstancePtr&, const OutgoingConnectionFactoryPtr&, const std::vector<EndpointIPtr>&, bool,
-                        const CreateConnectionCallbackPtr&, Ice::EndpointSelectionType);
+                        const CreateConnectionCallbackPtr&, Ice::EndpointSelectionType, bool);
 
         virtual void connectionStartCompleted(const Ice::ConnectionIPtr&);
         virtual void connectionStartFailed(const Ice::ConnectionIPtr&, const Ice::LocalException&);
@@ -104,6 +140,8 @@ private:
         virtual void connectors(const std::vector<ConnectorPtr>&);
         virtual void exception(const Ice::LocalException&);
 
+        virtual void runTimerTask();
+
         void getConnectors();
         void nextEndpoint();
 
@@ -119,24 +157,112 @@ private:
 
         bool operator<(const ConnectCallback&) const;
 
+        bool growPool() const
+        {
+            return _growPool;
+        }
+
     private:
 
         bool connectionStartFailedImpl(const Ice::LocalException&);
 
+        Ice::ConnectionIPtr connect(const ConnectorInfo&, Ice::Instrumentation::ObserverPtr&);
+
+        void connectParallel();
+        void connectParallelFailed(const Ice::LocalException&);
+
+        //
+        // A connection attempt in progress when connecting to the
+        // connectors in parallel.
+        //
+        struct Attempt
+        {
+            Attempt(const Ice::ConnectionIPtr& c, const std::vector<ConnectorInfo>::const_iterator& p,
+                    const Ice::Instrumentation::ObserverPtr& o) :
+                connection(c), connector(p), observer(o)
+            {
+            }
+
+            Ice::ConnectionIPtr connection;
+            std::vector<ConnectorInfo>::const_iterator connector;
+            Ice::Instrumentation::ObserverPtr observer;
+        };
+
+        void cancel(const std::vector<Attempt>&);
+
         const InstancePtr _instance;
         const OutgoingConnectionFactoryPtr _factory;
         const std::vector<EndpointIPtr> _endpoints;
         const bool _hasMore;
         const CreateConnectionCallbackPtr _callback;
         const Ice::EndpointSelectionType _selType;
+        const bool _growPool;
         Ice::Instrumentation::ObserverPtr _observer;
         std::vector<EndpointIPtr>::const_iterator _endpointsIter;
         std::vector<ConnectorInfo> _connectors;
         std::vector<ConnectorInfo>::const_iterator _iter;
+
+        //
+        // With parallel connects, the next connector is tried once the
+        // parallel connect delay expires, the first established connection
+        // is kept and the other connection attempts are canceled.
+        //
+        bool _parallel;
+        IceUtil::TimerPtr _timer;
+        IceUtil::Mutex _mutex;
+        bool _done;
+        std::vector<Attempt> _attempts;
     };
     ICE_DEFINE_PTR(ConnectCallbackPtr, ConnectCallback);
     friend class ConnectCallback;
 
+    //
+    // The callback of the connection establishments which grow a pool,
+    // failed establishments are retried after a delay while the pool has
+    // other connections.
+    //
+    class ConnectionPoolCallback : public CreateConnectionCallback
+    {
+    public:
+
+        ConnectionPoolCallback(const OutgoingConnectionFactoryPtr&, const ConnectorInfo&, int);
+
+        virtual void setConnection(const Ice::ConnectionIPtr&, bool);
+        virtual void setException(const Ice::LocalException&);
+
+    private:
+
+        const OutgoingConnectionFactoryPtr _factory;
+        const ConnectorInfo _connectorInfo;
+        const int _retry;
+    };
+    friend class ConnectionPoolCallback;
+
+    class ConnectionPoolTimerTask : public IceUtil::TimerTask
+    {
+    public:
+
+        ConnectionPoolTimerTask(const OutgoingConnectionFactoryPtr&, const ConnectorInfo&, int,
+                                const Ice::ConnectionIPtr&);
+
+        virtual void runTimerTask();
+
+    private:
+
+        const OutgoingConnectionFactoryPtr _factory;
+        const ConnectorInfo _connectorInfo;
+        const int _retry;
+        const Ice::ConnectionIPtr _connection;
+    };
+    friend class ConnectionPoolTimerTask;
+
+    //
+    // Notifies the factory of the reaped connections to replace the
+    // closed pooled connections.
+    //
+    class ConnectionPoolACMMonitor;
+    friend class ConnectionPoolACMMonitor;
+
     std::vector<EndpointIPtr> applyOverrides(const std::vector<EndpointIPtr>&);
     Ice::ConnectionIPtr findConnection(const std::vector<EndpointIPtr>&, bool&);
     void incPendingConnectCount();
@@ -149,18 +275,27 @@ private:
     bool addToPending(const ConnectCallbackPtr&, const std::vector<ConnectorInfo>&);
     void removeFromPending(const ConnectCallbackPtr&, const std::vector<ConnectorInfo>&);
 
-    Ice::ConnectionIPtr findConnection(const std::vector<ConnectorInfo>&, bool&);
+    Ice::ConnectionIPtr findConnection(const std::vector<ConnectorInfo>&, bool, bool&);
     Ice::ConnectionIPtr createConnection(const TransceiverPtr&, const ConnectorInfo&);
 
+    bool addToConnectionPool(const ConnectorInfo&, const Ice::ConnectionIPtr&);
+    void removeFromConnectionPool(const Ice::ConnectionIPtr&);
+    void growConnectionPool(const ConnectorInfo&, int);
+    void regrowConnectionPool(const ConnectorInfo&, int);
+    void scheduleGrowConnectionPool(const ConnectorInfo&, int, const Ice::ConnectionIPtr&);
+
     void handleException(const Ice::LocalException&, bool);
     void handleConnectionException(const Ice::LocalException&, bool);
 
     Ice::CommunicatorPtr _communicator;
     const InstancePtr _instance;
     const FactoryACMMonitorPtr _monitor;
+    const int _connectionPoolSize;
+    const int _parallelConnect;
     bool _destroyed;
 
     std::multimap<ConnectorPtr, Ice::ConnectionIPtr> _connections;
+    std::map<ConnectorPtr, ConnectionPoolPtr> _connectionPools;
     std::map<ConnectorPtr, std::set<ConnectCallbackPtr> > _pending;
 
 #ifdef ICE_CPP11_MAPPING
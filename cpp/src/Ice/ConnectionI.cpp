@@ -27,11 +27,20 @@
 #include <Ice/ReferenceFactory.h> // For createProxy().
 #include <Ice/ProxyFactory.h> // For createProxy().
 #include <Ice/BatchRequestQueue.h>
+#include <Ice/ReplyStatus.h>
 
 #ifdef ICE_HAS_BZIP2
 #  include <bzlib.h>
 #endif
 
+#ifdef ICE_HAS_LZ4
+#  include <lz4.h>
+#endif
+
+#ifdef ICE_HAS_ZSTD
+#  include <zstd.h>
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace Ice::Instrumentation;
@@ -46,6 +55,33 @@ namespace
 
 const ::std::string flushBatchRequests_name = "flushBatchRequests";
 
+//
+// The compression codecs supported by this build, advertised by the
+// server with the validate connection message.
+//
+const Byte supportedCompressionCodecs =
+#ifdef ICE_HAS_BZIP2
+    (1 << (compressionCodecBZip2 - 1)) |
+#endif
+#ifdef ICE_HAS_LZ4
+    (1 << (compressionCodecLZ4 - 1)) |
+#endif
+#ifdef ICE_HAS_ZSTD
+    (1 << (compressionCodecZstd - 1)) |
+#endif
+    0;
+
+//
+// The codec used when the peer doesn't support the requested codec:
+// bzip2 if it's supported by this build, otherwise no compression.
+//
+inline Byte
+fallbackCompressionCodec()
+{
+    return supportedCompressionCodecs & compressionCodecMask(compressionCodecBZip2) ?
+        compressionCodecBZip2 : compressionCodecNone;
+}
+
 class TimeoutCallback : public IceUtil::TimerTask
 {
 public:
@@ -65,6 +101,25 @@ private:
     Ice::ConnectionI* _connection;
 };
 
+class CorkTimeoutCallback : public IceUtil::TimerTask
+{
+public:
+
+    CorkTimeoutCallback(Ice::ConnectionI* connection) : _connection(connection)
+    {
+    }
+
+    void
+    runTimerTask()
+    {
+        _connection->corkTimedOut();
+    }
+
+private:
+
+    Ice::ConnectionI* _connection;
+};
+
 class DispatchCall : public DispatchWorkItem
 {
 public:
@@ -242,6 +297,7 @@ Ice::ConnectionI::OutgoingMessage::adopt(OutputStream* str)
     assert(str);
     stream = new OutputStream(str->instance(), currentProtocolEncoding);
     stream->swap(*str);
+    stream->copyUnownedSegments(); // The adopted stream might outlive the memory referenced by its segments.
     adopted = true;
 }
 
@@ -448,6 +504,23 @@ Ice::ConnectionI::isActiveOrHolding() const
     return _state > StateNotValidated && _state < StateClosing;
 }
 
+void
+Ice::ConnectionI::updateOutstandingRequests()
+{
+    //
+    // Called with the connection locked whenever the state or the
+    // async requests change.
+    //
+    if(_state == StateActive || _state == StateHolding)
+    {
+        _outstandingRequests.exchange(static_cast<int>(_asyncRequests.size()));
+    }
+    else
+    {
+        _outstandingRequests.exchange(-1);
+    }
+}
+
 bool
 Ice::ConnectionI::isFinished() const
 {
@@ -603,89 +676,41 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
 AsyncStatus
 Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compress, bool response, int batchRequestNum)
 {
-    OutputStream* os = out->getOs();
-
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    //
-    // If the exception is closed before we even have a chance
-    // to send our request, we always try to send the request
-    // again.
-    //
-    if(_exception)
-    {
-        throw RetryException(*_exception);
-    }
-    assert(_state > StateNotValidated);
-    assert(_state < StateClosing);
-
     //
     // Ensure the message isn't bigger than what we can send with the
     // transport.
     //
-    _transceiver->checkSendSize(*os);
+    _transceiver->checkSendSize(*out->getOs());
 
     //
     // Notify the request that it's cancelable with this connection.
     // This will throw if the request is canceled.
     //
     out->cancelable(ICE_SHARED_FROM_THIS);
-    Int requestId = 0;
-    if(response)
-    {
-        //
-        // Create a new unique request ID.
-        //
-        requestId = _nextRequestId++;
-        if(requestId <= 0)
-        {
-            _nextRequestId = 1;
-            requestId = _nextRequestId++;
-        }
 
-        //
-        // Fill in the request ID.
-        //
-        const Byte* p = reinterpret_cast<const Byte*>(&requestId);
-#ifdef ICE_BIG_ENDIAN
-        reverse_copy(p, p + sizeof(Int), os->b.begin() + headerSize);
-#else
-        copy(p, p + sizeof(Int), os->b.begin() + headerSize);
-#endif
-    }
-    else if(batchRequestNum > 0)
+    //
+    // Push the request on the lock-free pending request queue. Only the
+    // thread which pushes a request on an empty queue locks the
+    // connection to send the pending requests. The requests of the other
+    // threads are sent along with its own request and their sent or
+    // exception callbacks are called from the client thread pool.
+    //
+    PendingRequest* request = new PendingRequest(out, compress, response, batchRequestNum);
+    PendingRequest* head = _pendingRequests.load();
+    do
     {
-        const Byte* p = reinterpret_cast<const Byte*>(&batchRequestNum);
-#ifdef ICE_BIG_ENDIAN
-        reverse_copy(p, p + sizeof(Int), os->b.begin() + headerSize);
-#else
-        copy(p, p + sizeof(Int), os->b.begin() + headerSize);
-#endif
+        request->next = head;
     }
+    while(!_pendingRequests.compare_exchange(head, request));
 
-    out->attachRemoteObserver(initConnectionInfo(), _endpoint, requestId);
-
-    AsyncStatus status = AsyncStatusQueued;
-    try
-    {
-        OutgoingMessage message(out, os, compress, requestId);
-        status = sendMessage(message);
-    }
-    catch(const LocalException& ex)
+    if(head)
     {
-        setState(StateClosed, ex);
-        assert(_exception);
-        _exception->ice_throw();
+        return AsyncStatusQueued; // The thread which pushed the first pending request will send this request.
     }
 
-    if(response)
-    {
-        //
-        // Add to the async requests map.
-        //
-        _asyncRequestsHint = _asyncRequests.insert(_asyncRequests.end(),
-                                                   pair<const Int, OutgoingAsyncBasePtr>(requestId, out));
-    }
-    return status;
+    PendingRetries retries; // Must be declared before the lock, see PendingRetries.
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    return sendPendingRequests(out, retries);
 }
 
 BatchRequestQueuePtr
@@ -927,12 +952,19 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
     // NOTE: This isn't called from a thread pool thread.
     //
 
+    PendingRetries retries; // Must be declared before the lock, see PendingRetries.
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     if(_state >= StateClosed)
     {
         return; // The request has already been or will be shortly notified of the failure.
     }
 
+    //
+    // Send the pending requests first, the canceled request might not
+    // be sent or queued yet.
+    //
+    sendPendingRequests(0, retries);
+
     for(deque<OutgoingMessage>::iterator o = _sendStreams.begin(); o != _sendStreams.end(); ++o)
     {
         if(o->outAsync.get() == outAsync.get())
@@ -949,6 +981,7 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
                 {
                     _asyncRequests.erase(o->requestId);
                 }
+                updateOutstandingRequests();
             }
 
             if(dynamic_cast<const Ice::ConnectionTimeoutException*>(&ex))
@@ -959,16 +992,34 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
             {
                 //
                 // If the request is being sent, don't remove it from the send streams,
-                // it will be removed once the sending is finished.
+                // it will be removed once the sending is finished. Corked requests are
+                // not being sent, nothing is written until the cork delay expires.
                 //
-                if(o == _sendStreams.begin())
+                if(!_corked &&
+                   (o == _sendStreams.begin() || static_cast<size_t>(o - _sendStreams.begin()) < _coalescedCount))
                 {
                     o->canceled(true); // true = adopt the stream
+
+                    //
+                    // The request is being sent, the memory referenced by the
+                    // stream segments is no longer valid once the invocation
+                    // returns.
+                    //
+                    _writeStream.copyUnownedSegments();
                 }
                 else
                 {
                     o->canceled(false);
+                    if(_corked)
+                    {
+                        _corkedBytes -= o->stream->b.size();
+                    }
                     _sendStreams.erase(o);
+                    if(_corked && _sendStreams.empty())
+                    {
+                        _corked = false;
+                        _timer->cancel(_corkTimeout);
+                    }
                 }
                 if(outAsync->exception(ex))
                 {
@@ -993,6 +1044,7 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
                 {
                     _asyncRequests.erase(_asyncRequestsHint);
                     _asyncRequestsHint = _asyncRequests.end();
+                    updateOutstandingRequests();
                     if(outAsync->exception(ex))
                     {
                         outAsync->invokeExceptionAsync();
@@ -1014,6 +1066,7 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
                 {
                     assert(p != _asyncRequestsHint);
                     _asyncRequests.erase(p);
+                    updateOutstandingRequests();
                     if(outAsync->exception(ex))
                     {
                         outAsync->invokeExceptionAsync();
@@ -1048,7 +1101,16 @@ Ice::ConnectionI::sendResponse(Int, OutputStream* os, Byte compressFlag, bool /*
             _exception->ice_throw();
         }
 
-        OutgoingMessage message(os, compressFlag > 0);
+        //
+        // The response is compressed with the codec requested by the
+        // compression status of the request if it's supported.
+        //
+        Byte codec = compressionStatusCodec(compressFlag);
+        if(codec != compressionCodecNone && !(supportedCompressionCodecs & compressionCodecMask(codec)))
+        {
+            codec = fallbackCompressionCodec();
+        }
+        OutgoingMessage message(os, codec);
         sendMessage(message);
 
         if(_state == StateClosing && _dispatchCount == 0)
@@ -1215,6 +1277,11 @@ Ice::ConnectionI::startAsync(SocketOperation operation)
                 _observer.startWrite(_writeStream);
             }
 
+            if(!_writeStream.segments.empty())
+            {
+                _writeStream.copySegments(); // Asynchronous writes don't support gather writes.
+            }
+
             if(_transceiver->startWrite(_writeStream) && !_sendStreams.empty())
             {
                 // The whole message is written, assume it's sent now for at-most-once semantics.
@@ -1709,6 +1776,10 @@ Ice::ConnectionI::finished(ThreadPoolCurrent& current, bool close)
         IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
         assert(_state == StateClosed);
         unscheduleTimeout(static_cast<SocketOperation>(SocketOperationRead | SocketOperationWrite));
+        if(_corked)
+        {
+            _timer->cancel(_corkTimeout);
+        }
     }
 
     //
@@ -1788,11 +1859,12 @@ Ice::ConnectionI::finish(bool close)
 
     if(!_sendStreams.empty())
     {
-        if(!_writeStream.b.empty())
+        if(!_writeStream.b.empty() && !_corked && !_coalescedCount)
         {
             //
             // Return the stream to the outgoing call. This is important for
-            // retriable AMI calls which are not marshalled again.
+            // retriable AMI calls which are not marshalled again. Corked or
+            // coalesced messages were not swapped with the write stream.
             //
             OutgoingMessage* message = &_sendStreams.front();
             _writeStream.swap(*message->stream);
@@ -1906,6 +1978,25 @@ Ice::ConnectionI::timedOut()
     }
 }
 
+void
+Ice::ConnectionI::corkTimedOut()
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    if(!_corked || _state >= StateClosed)
+    {
+        return;
+    }
+
+    try
+    {
+        sendCorkedMessages();
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        setState(StateClosed, ex);
+    }
+}
+
 string
 Ice::ConnectionI::type() const
 {
@@ -1975,10 +2066,18 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _warn(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Connections") > 0),
     _warnUdp(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Datagrams") > 0),
     _compressionLevel(1),
+    _peerCompressionCodecs(0),
     _nextRequestId(1),
     _asyncRequestsHint(_asyncRequests.end()),
+    _outstandingRequests(-1),
     _messageSizeMax(adapter ? adapter->messageSizeMax() : _instance->messageSizeMax()),
     _batchRequestQueue(new BatchRequestQueue(instance, endpoint->datagram())),
+    _corkDelay(0),
+    _corkMaxBytes(0),
+    _corkTimeout(new CorkTimeoutCallback(this)),
+    _corked(false),
+    _corkedBytes(0),
+    _coalescedCount(0),
     _readStream(_instance.get(), Ice::currentProtocolEncoding),
     _readHeader(false),
     _writeStream(_instance.get(), Ice::currentProtocolEncoding),
@@ -1996,10 +2095,28 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     {
         compressionLevel = 1;
     }
-    else if(compressionLevel > 9)
+
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+    //
+    // Corking is only supported with stream transports, each message
+    // must be sent with its own datagram.
+    //
+    if(!_endpoint->datagram())
     {
-        compressionLevel = 9;
+        Int delay = properties->getPropertyAsInt("Ice.Cork.Delay");
+        Int maxBytes = properties->getPropertyAsIntWithDefault("Ice.Cork.MaxBytes", 1400);
+        if(adapter)
+        {
+            delay = properties->getPropertyAsIntWithDefault(adapter->getName() + ".Cork.Delay", delay);
+            maxBytes = properties->getPropertyAsIntWithDefault(adapter->getName() + ".Cork.MaxBytes", maxBytes);
+        }
+        if(delay > 0 && maxBytes > headerSize)
+        {
+            const_cast<IceUtil::Int64&>(_corkDelay) = delay;
+            const_cast<size_t&>(_corkMaxBytes) = static_cast<size_t>(maxBytes);
+        }
     }
+#endif
 
     if(adapter)
     {
@@ -2025,11 +2142,11 @@ Ice::ConnectionI::create(const CommunicatorPtr& communicator,
                                              endpoint, adapter));
     if(adapter)
     {
-        const_cast<ThreadPoolPtr&>(conn->_threadPool) = adapter->getThreadPool();
+        const_cast<ThreadPoolPtr&>(conn->_threadPool) = adapter->getThreadPool()->nextShard();
     }
     else
     {
-        const_cast<ThreadPoolPtr&>(conn->_threadPool) = conn->_instance->clientThreadPool();
+        const_cast<ThreadPoolPtr&>(conn->_threadPool) = conn->_instance->clientThreadPool()->nextShard();
     }
     conn->_threadPool->initialize(conn);
     return conn;
@@ -2043,6 +2160,7 @@ Ice::ConnectionI::~ConnectionI()
     assert(_state == StateFinished);
     assert(_dispatchCount == 0);
     assert(_sendStreams.empty());
+    assert(!_pendingRequests.load());
     assert(_asyncRequests.empty());
 }
 
@@ -2266,6 +2384,7 @@ Ice::ConnectionI::setState(State state)
         }
     }
     _state = state;
+    updateOutstandingRequests();
 
     notifyAll();
 
@@ -2310,7 +2429,7 @@ Ice::ConnectionI::initiateShutdown()
         os.write(static_cast<Byte>(1)); // compression status: compression supported but not used.
         os.write(headerSize); // Message size.
 
-        OutgoingMessage message(&os, false);
+        OutgoingMessage message(&os, compressionCodecNone);
         if(sendMessage(message) & AsyncStatusSent)
         {
             setState(StateClosingPending);
@@ -2348,7 +2467,7 @@ Ice::ConnectionI::heartbeat()
         os.i = os.b.begin();
         try
         {
-            OutgoingMessage message(&os, false);
+            OutgoingMessage message(&os, compressionCodecNone);
             sendMessage(message);
         }
         catch(const LocalException& ex)
@@ -2395,7 +2514,7 @@ Ice::ConnectionI::validate(SocketOperation operation)
                 _writeStream.write(currentProtocol);
                 _writeStream.write(currentProtocolEncoding);
                 _writeStream.write(validateConnectionMsg);
-                _writeStream.write(static_cast<Byte>(0)); // Compression status (always zero for validate connection).
+                _writeStream.write(supportedCompressionCodecs); // Compression codecs supported by the server.
                 _writeStream.write(headerSize); // Message size.
                 _writeStream.i = _writeStream.b.begin();
                 traceSend(_writeStream, _logger, _traceLevels);
@@ -2476,8 +2595,12 @@ Ice::ConnectionI::validate(SocketOperation operation)
             {
                 throw ConnectionNotValidatedException(__FILE__, __LINE__);
             }
-            Byte compress;
-            _readStream.read(compress); // Ignore compression status for validate connection.
+            //
+            // The compression status of the validate connection message
+            // is the set of compression codecs supported by the server.
+            // Servers from older Ice versions always send zero.
+            //
+            _readStream.read(_peerCompressionCodecs);
             Int size;
             _readStream.read(size);
             if(size != headerSize)
@@ -2525,8 +2648,11 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
     else if(_state == StateClosingPending && _writeStream.i == _writeStream.b.begin())
     {
         // Message wasn't sent, empty the _writeStream, we're not going to send more data.
-        OutgoingMessage* message = &_sendStreams.front();
-        _writeStream.swap(*message->stream);
+        if(!_coalescedCount)
+        {
+            OutgoingMessage* message = &_sendStreams.front();
+            _writeStream.swap(*message->stream);
+        }
         return SocketOperationNone;
     }
 
@@ -2536,18 +2662,30 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
         while(true)
         {
             //
-            // Notify the message that it was sent.
+            // Notify the message(s) that were sent.
             //
-            OutgoingMessage* message = &_sendStreams.front();
-            if(message->stream)
+            size_t count = max<size_t>(_coalescedCount, 1);
+            while(count-- > 0)
             {
-                _writeStream.swap(*message->stream);
-                if(message->sent())
+                OutgoingMessage* message = &_sendStreams.front();
+                if(message->stream)
                 {
-                    callbacks.push_back(*message);
+                    if(!_coalescedCount)
+                    {
+                        _writeStream.swap(*message->stream);
+                    }
+                    if(message->sent())
+                    {
+                        callbacks.push_back(*message);
+                    }
                 }
+                _sendStreams.pop_front();
+            }
+            if(_coalescedCount)
+            {
+                _writeStream.b.clear(); // Release the coalesced messages.
+                _coalescedCount = 0;
             }
-            _sendStreams.pop_front();
 
             //
             // If there's nothing left to send, we're done.
@@ -2570,57 +2708,67 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
             }
 
             //
-            // Otherwise, prepare the next message stream for writing.
+            // Otherwise, prepare the next message stream for writing. Small
+            // messages queued while the previous message was being sent are
+            // coalesced if corking is enabled.
             //
-            message = &_sendStreams.front();
+            OutgoingMessage* message = &_sendStreams.front();
             assert(!message->stream->i);
-#ifdef ICE_HAS_BZIP2
-            if(message->compress && message->stream->b.size() >= 100) // Only compress messages > 100 bytes.
+            if(corkable(*message))
             {
-                //
-                // Message compressed. Request compressed response, if any.
-                //
-                message->stream->b[9] = 2;
-
-                //
-                // Do compression.
-                //
-                OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
-                doCompress(*message->stream, stream);
-
-                traceSend(*message->stream, _logger, _traceLevels);
-
-                message->adopt(&stream); // Adopt the compressed stream.
-                message->stream->i = message->stream->b.begin();
+                coalesceMessages();
             }
             else
             {
-#endif
-                if(message->compress)
+#ifdef ICE_HAS_COMPRESSION
+                if(message->compress && message->stream->b.size() >= 100) // Only compress messages > 100 bytes.
                 {
                     //
-                    // Message not compressed. Request compressed response, if any.
+                    // Message compressed. Request compressed response, if any.
+                    //
+                    message->stream->b[9] = compressionCodecCompressedStatus(message->compress);
+
+                    //
+                    // Do compression.
                     //
-                    message->stream->b[9] = 1;
+                    OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
+                    message->stream->copySegments();
+                    doCompress(*message->stream, stream, message->compress);
+
+                    traceSend(*message->stream, _logger, _traceLevels);
+
+                    message->adopt(&stream); // Adopt the compressed stream.
+                    message->stream->i = message->stream->b.begin();
                 }
+                else
+                {
+#endif
+                    if(message->compress)
+                    {
+                        //
+                        // Message not compressed. Request compressed response, if any.
+                        //
+                        message->stream->b[9] = compressionCodecSupportedStatus(message->compress);
+                    }
 
-                //
-                // No compression, just fill in the message size.
-                //
-                Int sz = static_cast<Int>(message->stream->b.size());
-                const Byte* p = reinterpret_cast<const Byte*>(&sz);
+                    //
+                    // No compression, just fill in the message size.
+                    //
+                    Int sz = static_cast<Int>(message->stream->b.size());
+                    const Byte* p = reinterpret_cast<const Byte*>(&sz);
 #ifdef ICE_BIG_ENDIAN
-                reverse_copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
+                    reverse_copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
 #else
-                copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
+                    copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
 #endif
-                message->stream->i = message->stream->b.begin();
-                traceSend(*message->stream, _logger, _traceLevels);
+                    message->stream->i = message->stream->b.begin();
+                    traceSend(*message->stream, _logger, _traceLevels);
 
-#ifdef ICE_HAS_BZIP2
-            }
+#ifdef ICE_HAS_COMPRESSION
+                }
 #endif
-            _writeStream.swap(*message->stream);
+                _writeStream.swap(*message->stream);
+            }
 
             //
             // Send the message.
@@ -2676,6 +2824,39 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
     {
         _sendStreams.push_back(message);
         _sendStreams.back().adopt(0);
+        if(_corked)
+        {
+            //
+            // Send the corked messages now if this message can't be corked
+            // or if the corked messages reached the maximum size.
+            //
+            _corkedBytes += _sendStreams.back().stream->b.size();
+            if(!corkable(_sendStreams.back()) || _corkedBytes >= _corkMaxBytes)
+            {
+                try
+                {
+                    sendCorkedMessages();
+                }
+                catch(const Ice::LocalException& ex)
+                {
+                    setState(StateClosed, ex); // The queued messages are notified of the failure by finish().
+                }
+            }
+        }
+        return AsyncStatusQueued;
+    }
+
+    if(corkable(message))
+    {
+        //
+        // The connection is idle, hold the message for at most the cork
+        // delay to send it along with the small messages sent meanwhile.
+        //
+        _sendStreams.push_back(message);
+        _sendStreams.back().adopt(0);
+        _corked = true;
+        _corkedBytes = _sendStreams.back().stream->b.size();
+        _timer->schedule(_corkTimeout, IceUtil::Time::microSeconds(_corkDelay));
         return AsyncStatusQueued;
     }
 
@@ -2686,19 +2867,20 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
 
     message.stream->i = message.stream->b.begin();
     SocketOperation op;
-#ifdef ICE_HAS_BZIP2
+#ifdef ICE_HAS_COMPRESSION
     if(message.compress && message.stream->b.size() >= 100) // Only compress messages larger than 100 bytes.
     {
         //
         // Message compressed. Request compressed response, if any.
         //
-        message.stream->b[9] = 2;
+        message.stream->b[9] = compressionCodecCompressedStatus(message.compress);
 
         //
         // Do compression.
         //
         OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
-        doCompress(*message.stream, stream);
+        message.stream->copySegments();
+        doCompress(*message.stream, stream, message.compress);
         stream.i = stream.b.begin();
 
         traceSend(*message.stream, _logger, _traceLevels);
@@ -2741,7 +2923,7 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
             //
             // Message not compressed. Request compressed response, if any.
             //
-            message.stream->b[9] = 1;
+            message.stream->b[9] = compressionCodecSupportedStatus(message.compress);
         }
 
         //
@@ -2786,7 +2968,7 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
 
         _sendStreams.push_back(message);
         _sendStreams.back().adopt(0); // Adopt the stream.
-#ifdef ICE_HAS_BZIP2
+#ifdef ICE_HAS_COMPRESSION
     }
 #endif
 
@@ -2796,30 +2978,355 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
     return AsyncStatusQueued;
 }
 
-#ifdef ICE_HAS_BZIP2
-static string
-getBZ2Error(int bzError)
+bool
+Ice::ConnectionI::corkable(const OutgoingMessage& message) const
 {
-    if(bzError == BZ_RUN_OK)
-    {
-        return ": BZ_RUN_OK";
-    }
-    else if(bzError == BZ_FLUSH_OK)
-    {
-        return ": BZ_FLUSH_OK";
-    }
-    else if(bzError == BZ_FINISH_OK)
+    if(!_corkDelay || !message.stream || !message.stream->segments.empty() ||
+       message.stream->b.size() >= _corkMaxBytes)
     {
-        return ": BZ_FINISH_OK";
+        return false;
     }
-    else if(bzError == BZ_STREAM_END)
+
+    //
+    // Only requests and replies are corked. Close connection and validate
+    // connection (heartbeat) messages are sent right away along with the
+    // messages corked before them.
+    //
+    Byte messageType = message.stream->b[8];
+    if(messageType == closeConnectionMsg || messageType == validateConnectionMsg)
     {
-        return ": BZ_STREAM_END";
+        return false;
     }
-    else if(bzError == BZ_CONFIG_ERROR)
+#ifdef ICE_HAS_COMPRESSION
+    return !message.compress || message.stream->b.size() < 100; // Messages larger than 100 bytes are compressed.
+#else
+    return true;
+#endif
+}
+
+void
+Ice::ConnectionI::coalesceMessages()
+{
+    //
+    // Copy the first messages of the send queue which can be corked to the
+    // write stream, up to the maximum number of bytes. The stream of these
+    // messages isn't swapped with the write stream.
+    //
+    _writeStream.resize(0);
+    _coalescedCount = 0;
+    for(deque<OutgoingMessage>::iterator p = _sendStreams.begin(); p != _sendStreams.end(); ++p)
     {
-        return ": BZ_CONFIG_ERROR";
-    }
+        if(!corkable(*p) || (_coalescedCount > 0 && _writeStream.b.size() + p->stream->b.size() > _corkMaxBytes))
+        {
+            break;
+        }
+
+        if(p->compress)
+        {
+            //
+            // Message not compressed. Request compressed response, if any.
+            //
+            p->stream->b[9] = compressionCodecSupportedStatus(p->compress);
+        }
+
+        Int sz = static_cast<Int>(p->stream->b.size());
+        const Byte* q = reinterpret_cast<const Byte*>(&sz);
+#ifdef ICE_BIG_ENDIAN
+        reverse_copy(q, q + sizeof(Int), p->stream->b.begin() + 10);
+#else
+        copy(q, q + sizeof(Int), p->stream->b.begin() + 10);
+#endif
+        p->stream->i = p->stream->b.begin();
+        traceSend(*p->stream, _logger, _traceLevels);
+
+        _writeStream.writeBlob(&p->stream->b[0], p->stream->b.size());
+        ++_coalescedCount;
+    }
+    assert(_coalescedCount > 0);
+    _writeStream.i = _writeStream.b.begin();
+}
+
+void
+Ice::ConnectionI::sendCorkedMessages()
+{
+    assert(_corked && !_sendStreams.empty());
+    _corked = false;
+    _timer->cancel(_corkTimeout);
+
+    coalesceMessages();
+    if(_observer)
+    {
+        _observer.startWrite(_writeStream);
+    }
+    SocketOperation op = write(_writeStream);
+    if(!op)
+    {
+        if(_observer)
+        {
+            _observer.finishWrite(_writeStream);
+        }
+        if(_acmLastActivity != IceUtil::Time())
+        {
+            _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        }
+
+        if(_coalescedCount == _sendStreams.size() && _state < StateClosing)
+        {
+            //
+            // All the messages are sent, their sent callbacks are called from
+            // the client thread pool.
+            //
+            for(deque<OutgoingMessage>::iterator p = _sendStreams.begin(); p != _sendStreams.end(); ++p)
+            {
+                if(p->sent())
+                {
+                    p->outAsync->invokeSentAsync();
+                }
+            }
+            _sendStreams.clear();
+            _writeStream.b.clear();
+            _coalescedCount = 0;
+            return;
+        }
+
+        //
+        // Let the thread pool notify the sent messages and send the
+        // remaining messages.
+        //
+        op = SocketOperationWrite;
+    }
+    else
+    {
+        scheduleTimeout(op);
+    }
+    _threadPool->_register(ICE_SHARED_FROM_THIS, op);
+}
+
+AsyncStatus
+Ice::ConnectionI::sendPendingRequests(const OutgoingAsyncBasePtr& out, PendingRetries& retries)
+{
+    //
+    // Send the requests of the pending request queue in the order they
+    // were pushed. The status of the given request is returned and the
+    // exceptions raised to send it are re-thrown once the other requests
+    // are sent. If the given request was already sent by another thread,
+    // AsyncStatusQueued is returned: the sent or exception callbacks
+    // are called from the client thread pool.
+    //
+    IceUtil::UniquePtr<PendingRequest> requests;
+    PendingRequest* p = _pendingRequests.exchange(0);
+    while(p)
+    {
+        PendingRequest* next = p->next;
+        p->next = requests.release();
+        requests.reset(p);
+        p = next;
+    }
+
+    AsyncStatus status = AsyncStatusQueued;
+    bool retry = false;
+    bool failed = false;
+    while(requests.get())
+    {
+        IceUtil::UniquePtr<PendingRequest> request(requests.release());
+        requests.reset(request->next);
+        request->next = 0;
+
+        const bool own = request->outAsync == out;
+        try
+        {
+            AsyncStatus s = sendRequest(request->outAsync, request->compress, request->response,
+                                        request->batchRequestNum);
+            if(own)
+            {
+                status = s;
+            }
+            else if(s & AsyncStatusInvokeSentCallback)
+            {
+                request->outAsync->invokeSentAsync();
+            }
+        }
+        catch(const RetryException&)
+        {
+            if(own)
+            {
+                retry = true;
+            }
+            else
+            {
+                //
+                // Proxy requests of other threads are retried with the retry
+                // queue, like the requests of the connect request handler.
+                //
+                ProxyOutgoingAsyncBasePtr proxyOutAsync = ICE_DYNAMIC_CAST(ProxyOutgoingAsyncBase, request->outAsync);
+                if(proxyOutAsync)
+                {
+                    retries.add(proxyOutAsync, *_exception);
+                }
+                else if(request->outAsync->exception(*_exception))
+                {
+                    request->outAsync->invokeExceptionAsync();
+                }
+            }
+        }
+        catch(const LocalException&)
+        {
+            if(own)
+            {
+                failed = true;
+            }
+            else if(request->outAsync->exception(*_exception))
+            {
+                request->outAsync->invokeExceptionAsync();
+            }
+        }
+    }
+
+    if(retry)
+    {
+        throw RetryException(*_exception);
+    }
+    else if(failed)
+    {
+        _exception->ice_throw();
+    }
+    return status;
+}
+
+Ice::ConnectionI::PendingRetries::~PendingRetries()
+{
+    for(vector<ProxyOutgoingAsyncBasePtr>::const_iterator p = _requests.begin(); p != _requests.end(); ++p)
+    {
+        (*p)->retryException(*_exception);
+    }
+}
+
+void
+Ice::ConnectionI::PendingRetries::add(const ProxyOutgoingAsyncBasePtr& outAsync, const LocalException& ex)
+{
+    if(!_exception)
+    {
+        ICE_SET_EXCEPTION_FROM_CLONE(_exception, ex.ice_clone());
+    }
+    _requests.push_back(outAsync);
+}
+
+AsyncStatus
+Ice::ConnectionI::sendRequest(const OutgoingAsyncBasePtr& out, bool compress, bool response, int batchRequestNum)
+{
+    OutputStream* os = out->getOs();
+
+    //
+    // If the exception is closed before we even have a chance
+    // to send our request, we always try to send the request
+    // again.
+    //
+    if(_exception)
+    {
+        throw RetryException(*_exception);
+    }
+    assert(_state > StateNotValidated);
+    assert(_state < StateClosing);
+
+    Int requestId = 0;
+    if(response)
+    {
+        //
+        // Create a new unique request ID.
+        //
+        requestId = _nextRequestId++;
+        if(requestId <= 0)
+        {
+            _nextRequestId = 1;
+            requestId = _nextRequestId++;
+        }
+
+        //
+        // Fill in the request ID.
+        //
+        const Byte* p = reinterpret_cast<const Byte*>(&requestId);
+#ifdef ICE_BIG_ENDIAN
+        reverse_copy(p, p + sizeof(Int), os->b.begin() + headerSize);
+#else
+        copy(p, p + sizeof(Int), os->b.begin() + headerSize);
+#endif
+    }
+    else if(batchRequestNum > 0)
+    {
+        const Byte* p = reinterpret_cast<const Byte*>(&batchRequestNum);
+#ifdef ICE_BIG_ENDIAN
+        reverse_copy(p, p + sizeof(Int), os->b.begin() + headerSize);
+#else
+        copy(p, p + sizeof(Int), os->b.begin() + headerSize);
+#endif
+    }
+
+    out->attachRemoteObserver(initConnectionInfo(), _endpoint, requestId);
+
+    //
+    // Use the configured compression codec if the peer supports it,
+    // otherwise fallback to bzip2 which is supported by all peers.
+    //
+    Byte codec = compressionCodecNone;
+    if(compress)
+    {
+        codec = _instance->compressionCodec();
+        if(!(_peerCompressionCodecs & compressionCodecMask(codec)))
+        {
+            codec = fallbackCompressionCodec();
+        }
+    }
+
+    AsyncStatus status = AsyncStatusQueued;
+    try
+    {
+        OutgoingMessage message(out, os, codec, requestId);
+        status = sendMessage(message);
+    }
+    catch(const LocalException& ex)
+    {
+        setState(StateClosed, ex);
+        assert(_exception);
+        _exception->ice_throw();
+    }
+
+    if(response)
+    {
+        //
+        // Add to the async requests map.
+        //
+        _asyncRequestsHint = _asyncRequests.insert(_asyncRequests.end(),
+                                                   pair<const Int, OutgoingAsyncBasePtr>(requestId, out));
+        updateOutstandingRequests();
+    }
+    return status;
+}
+
+
+#ifdef ICE_HAS_BZIP2
+static string
+getBZ2Error(int bzError)
+{
+    if(bzError == BZ_RUN_OK)
+    {
+        return ": BZ_RUN_OK";
+    }
+    else if(bzError == BZ_FLUSH_OK)
+    {
+        return ": BZ_FLUSH_OK";
+    }
+    else if(bzError == BZ_FINISH_OK)
+    {
+        return ": BZ_FINISH_OK";
+    }
+    else if(bzError == BZ_STREAM_END)
+    {
+        return ": BZ_STREAM_END";
+    }
+    else if(bzError == BZ_CONFIG_ERROR)
+    {
+        return ": BZ_CONFIG_ERROR";
+    }
     else if(bzError == BZ_SEQUENCE_ERROR)
     {
         return ": BZ_SEQUENCE_ERROR";
@@ -2857,9 +3364,11 @@ getBZ2Error(int bzError)
         return "";
     }
 }
+#endif
 
+#ifdef ICE_HAS_COMPRESSION
 void
-Ice::ConnectionI::doCompress(OutputStream& uncompressed, OutputStream& compressed)
+Ice::ConnectionI::doCompress(OutputStream& uncompressed, OutputStream& compressed, Byte codec)
 {
     const Byte* p;
 
@@ -2867,18 +3376,72 @@ Ice::ConnectionI::doCompress(OutputStream& uncompressed, OutputStream& compresse
     // Compress the message body, but not the header.
     //
     unsigned int uncompressedLen = static_cast<unsigned int>(uncompressed.b.size() - headerSize);
-    unsigned int compressedLen = static_cast<unsigned int>(uncompressedLen * 1.01 + 600);
-    compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
-    int bzError = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
-                                           &compressedLen,
-                                           reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
-                                           uncompressedLen,
-                                           _compressionLevel, 0, 0);
-    if(bzError != BZ_OK)
+    unsigned int compressedLen;
+    switch(codec)
     {
-        CompressionException ex(__FILE__, __LINE__);
-        ex.reason = "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError);
-        throw ex;
+#ifdef ICE_HAS_LZ4
+        case compressionCodecLZ4:
+        {
+            compressedLen = static_cast<unsigned int>(LZ4_compressBound(static_cast<int>(uncompressedLen)));
+            compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
+            int sz = LZ4_compress_default(reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
+                                          reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
+                                          static_cast<int>(uncompressedLen),
+                                          static_cast<int>(compressedLen));
+            if(sz <= 0)
+            {
+                CompressionException ex(__FILE__, __LINE__);
+                ex.reason = "LZ4_compress_default failed";
+                throw ex;
+            }
+            compressedLen = static_cast<unsigned int>(sz);
+            break;
+        }
+#endif
+#ifdef ICE_HAS_ZSTD
+        case compressionCodecZstd:
+        {
+            compressedLen = static_cast<unsigned int>(ZSTD_compressBound(uncompressedLen));
+            compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
+            size_t sz = ZSTD_compress(&compressed.b[0] + headerSize + sizeof(Int), compressedLen,
+                                      &uncompressed.b[0] + headerSize, uncompressedLen,
+                                      min(_compressionLevel, ZSTD_maxCLevel()));
+            if(ZSTD_isError(sz))
+            {
+                CompressionException ex(__FILE__, __LINE__);
+                ex.reason = string("ZSTD_compress failed: ") + ZSTD_getErrorName(sz);
+                throw ex;
+            }
+            compressedLen = static_cast<unsigned int>(sz);
+            break;
+        }
+#endif
+#ifdef ICE_HAS_BZIP2
+        case compressionCodecBZip2:
+        {
+            compressedLen = static_cast<unsigned int>(uncompressedLen * 1.01 + 600);
+            compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
+            int bzError = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
+                                                   &compressedLen,
+                                                   reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
+                                                   uncompressedLen,
+                                                   min(_compressionLevel, 9), 0, 0);
+            if(bzError != BZ_OK)
+            {
+                CompressionException ex(__FILE__, __LINE__);
+                ex.reason = "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError);
+                throw ex;
+            }
+            break;
+        }
+#endif
+        default:
+        {
+            assert(false);
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "unsupported compression codec";
+            throw ex;
+        }
     }
     compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
 
@@ -2914,7 +3477,7 @@ Ice::ConnectionI::doCompress(OutputStream& uncompressed, OutputStream& compresse
 }
 
 void
-Ice::ConnectionI::doUncompress(InputStream& compressed, InputStream& uncompressed)
+Ice::ConnectionI::doUncompress(InputStream& compressed, InputStream& uncompressed, Byte codec)
 {
     Int uncompressedSize;
     compressed.i = compressed.b.begin() + headerSize;
@@ -2932,16 +3495,66 @@ Ice::ConnectionI::doUncompress(InputStream& compressed, InputStream& uncompresse
 
     unsigned int uncompressedLen = uncompressedSize - headerSize;
     unsigned int compressedLen = static_cast<unsigned int>(compressed.b.size() - headerSize - sizeof(Int));
-    int bzError = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
-                                             &uncompressedLen,
-                                             reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
-                                             compressedLen,
-                                             0, 0);
-    if(bzError != BZ_OK)
+    switch(codec)
     {
-        CompressionException ex(__FILE__, __LINE__);
-        ex.reason = "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError);
-        throw ex;
+#ifdef ICE_HAS_BZIP2
+        case compressionCodecBZip2:
+        {
+            int bzError = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
+                                                     &uncompressedLen,
+                                                     reinterpret_cast<char*>(&compressed.b[0]) + headerSize +
+                                                     sizeof(Int),
+                                                     compressedLen,
+                                                     0, 0);
+            if(bzError != BZ_OK)
+            {
+                CompressionException ex(__FILE__, __LINE__);
+                ex.reason = "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError);
+                throw ex;
+            }
+            break;
+        }
+#endif
+#ifdef ICE_HAS_LZ4
+        case compressionCodecLZ4:
+        {
+            int sz = LZ4_decompress_safe(reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
+                                         reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
+                                         static_cast<int>(compressedLen),
+                                         static_cast<int>(uncompressedLen));
+            if(sz != static_cast<int>(uncompressedLen))
+            {
+                CompressionException ex(__FILE__, __LINE__);
+                ex.reason = "LZ4_decompress_safe failed";
+                throw ex;
+            }
+            break;
+        }
+#endif
+#ifdef ICE_HAS_ZSTD
+        case compressionCodecZstd:
+        {
+            size_t sz = ZSTD_decompress(&uncompressed.b[0] + headerSize, uncompressedLen,
+                                        &compressed.b[0] + headerSize + sizeof(Int), compressedLen);
+            if(ZSTD_isError(sz) || sz != uncompressedLen)
+            {
+                CompressionException ex(__FILE__, __LINE__);
+                ex.reason = "ZSTD_decompress failed";
+                if(ZSTD_isError(sz))
+                {
+                    ex.reason += string(": ") + ZSTD_getErrorName(sz);
+                }
+                throw ex;
+            }
+            break;
+        }
+#endif
+        default:
+        {
+            FeatureNotSupportedException ex(__FILE__, __LINE__);
+            ex.unsupportedFeature = "Cannot uncompress message compressed with unsupported codec";
+            throw ex;
+        }
     }
 
     copy(compressed.b.begin(), compressed.b.begin() + headerSize, uncompressed.b.begin());
@@ -2984,11 +3597,20 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
         stream.read(messageType);
         stream.read(compress);
 
-        if(compress == 2)
+        if(compress > 0)
         {
-#ifdef ICE_HAS_BZIP2
+            //
+            // The peer supports the codec of the message, it can be used for
+            // the messages we send (useful for bi-directional connections).
+            //
+            _peerCompressionCodecs |= compressionCodecMask(compressionStatusCodec(compress));
+        }
+
+        if(compressionStatusCompressed(compress))
+        {
+#ifdef ICE_HAS_COMPRESSION
             InputStream ustream(_instance.get(), Ice::currentProtocolEncoding);
-            doUncompress(stream, ustream);
+            doUncompress(stream, ustream, compressionStatusCodec(compress));
             stream.b.swap(ustream.b);
 #else
             FeatureNotSupportedException ex(__FILE__, __LINE__);
@@ -3039,10 +3661,13 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
                 {
                     traceRecv(stream, _logger, _traceLevels);
                     stream.read(requestId);
-                    invokeNum = 1;
-                    servantManager = _servantManager;
-                    adapter = _adapter;
-                    ++dispatchCount;
+                    if(queueDispatch(requestId, 1))
+                    {
+                        invokeNum = 1;
+                        servantManager = _servantManager;
+                        adapter = _adapter;
+                        ++dispatchCount;
+                    }
                 }
                 break;
             }
@@ -3063,9 +3688,16 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
                         invokeNum = 0;
                         throw UnmarshalOutOfBoundsException(__FILE__, __LINE__);
                     }
-                    servantManager = _servantManager;
-                    adapter = _adapter;
-                    dispatchCount += invokeNum;
+                    if(queueDispatch(0, invokeNum))
+                    {
+                        servantManager = _servantManager;
+                        adapter = _adapter;
+                        dispatchCount += invokeNum;
+                    }
+                    else
+                    {
+                        invokeNum = 0;
+                    }
                 }
                 break;
             }
@@ -3104,6 +3736,7 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
                     {
                         _asyncRequests.erase(q);
                     }
+                    updateOutstandingRequests();
 
                     stream.swap(*outAsync->getIs());
 
@@ -3180,6 +3813,51 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
     return _state == StateHolding ? SocketOperationNone : SocketOperationRead;
 }
 
+bool
+Ice::ConnectionI::queueDispatch(Int requestId, Int invokeNum)
+{
+    //
+    // Queue the requests with the adapter admission control. If the
+    // adapter rejects the requests, they are discarded and the response
+    // of a twoway request is sent right away. Must be called with the
+    // mutex locked.
+    //
+    ObjectAdapterI* adapter = dynamic_cast<ObjectAdapterI*>(_adapter.get());
+    if(!adapter || !adapter->hasDispatchLimits())
+    {
+        return true;
+    }
+
+    try
+    {
+        adapter->queueDispatch(_threadPool, invokeNum);
+        return true;
+    }
+    catch(const DispatchRejectedException& ex)
+    {
+        if(_instance->initializationData().properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1) > 1)
+        {
+            Warning out(_logger);
+            out << "dispatch rejected:\n" << ex << '\n' << _desc;
+        }
+
+        if(requestId != 0)
+        {
+            OutputStream os(_instance.get(), Ice::currentProtocolEncoding);
+            os.writeBlob(replyHdr, sizeof(replyHdr));
+            os.write(requestId);
+            os.write(replyUnknownLocalException);
+            ostringstream str;
+            str << ex;
+            os.write(str.str(), false);
+            os.write(replyDispatchRejectedMarker);
+            OutgoingMessage message(&os, compressionCodecNone);
+            sendMessage(message);
+        }
+        return false;
+    }
+}
+
 void
 Ice::ConnectionI::invokeAll(InputStream& stream, Int invokeNum, Int requestId, Byte compress,
                             const ServantManagerPtr& servantManager, const ObjectAdapterPtr& adapter)
@@ -3189,6 +3867,12 @@ Ice::ConnectionI::invokeAll(InputStream& stream, Int invokeNum, Int requestId, B
     // operation must be called *without* the mutex locked.
     //
 
+    //
+    // The requests queued with the adapter admission control by
+    // parseMessage are dequeued once their dispatch completes.
+    //
+    ObjectAdapterI* adapterI = dynamic_cast<ObjectAdapterI*>(adapter.get());
+
     try
     {
         while(invokeNum > 0)
@@ -3207,14 +3891,31 @@ Ice::ConnectionI::invokeAll(InputStream& stream, Int invokeNum, Int requestId, B
             in.invoke(servantManager, &stream);
 
             --invokeNum;
+            if(adapterI)
+            {
+                adapterI->dequeueDispatch(1);
+            }
         }
 
         stream.clear();
     }
     catch(const LocalException& ex)
     {
+        if(adapterI)
+        {
+            adapterI->dequeueDispatch(invokeNum);
+        }
         invokeException(requestId, ex, invokeNum, false);  // Fatal invocation exception
     }
+
+    //
+    // If the request memory is shared with asynchronous dispatches, the
+    // stream can't be re-used to read other messages.
+    //
+    if(stream.b.shared())
+    {
+        stream.b.clear();
+    }
 }
 
 void
@@ -3361,6 +4062,11 @@ ConnectionI::read(Buffer& buf)
 SocketOperation
 ConnectionI::write(Buffer& buf)
 {
+    if(!buf.segments.empty() && !_transceiver->supportsGatherWrite())
+    {
+        buf.copySegments();
+    }
+
     Buffer::Container::iterator start = buf.i;
     SocketOperation op = _transceiver->write(buf);
     if(_instance->traceLevels()->network >= 3 && buf.i != start)
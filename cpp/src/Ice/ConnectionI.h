@@ -16,6 +16,7 @@
 #include <IceUtil/StopWatch.h>
 #include <IceUtil/Timer.h>
 #include <IceUtil/UniquePtr.h>
+#include <IceUtil/Atomic.h>
 
 #include <Ice/CommunicatorF.h>
 #include <Ice/Connection.h>
@@ -49,6 +50,14 @@
 #    endif
 #endif
 
+//
+// Protocol compression is supported if at least one of the compression
+// codecs is supported.
+//
+#if defined(ICE_HAS_BZIP2) || defined(ICE_HAS_LZ4) || defined(ICE_HAS_ZSTD)
+#    define ICE_HAS_COMPRESSION
+#endif
+
 namespace Ice
 {
 
@@ -92,7 +101,7 @@ public:
 
     struct OutgoingMessage
     {
-        OutgoingMessage(Ice::OutputStream* str, bool comp) :
+        OutgoingMessage(Ice::OutputStream* str, Ice::Byte comp) :
             stream(str), compress(comp), requestId(0), adopted(false)
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
             , isSent(false), invokeSent(false), receivedReply(false)
@@ -101,7 +110,7 @@ public:
         }
 
         OutgoingMessage(const IceInternal::OutgoingAsyncBasePtr& o, Ice::OutputStream* str,
-                        bool comp, int rid) :
+                        Ice::Byte comp, int rid) :
             stream(str), outAsync(o), compress(comp), requestId(rid), adopted(false)
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
             , isSent(false), invokeSent(false), receivedReply(false)
@@ -116,7 +125,7 @@ public:
 
         Ice::OutputStream* stream;
         IceInternal::OutgoingAsyncBasePtr outAsync;
-        bool compress;
+        Ice::Byte compress; // The compression codec, compressionCodecNone if the message isn't compressed.
         int requestId;
         bool adopted;
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
@@ -126,6 +135,57 @@ public:
 #endif
     };
 
+    //
+    // A request pushed on the pending request queue, see sendAsyncRequest.
+    //
+    struct PendingRequest
+    {
+        PendingRequest(const IceInternal::OutgoingAsyncBasePtr& o, bool comp, bool resp, int batch) :
+            outAsync(o), compress(comp), response(resp), batchRequestNum(batch), next(0)
+        {
+        }
+
+        ~PendingRequest()
+        {
+            //
+            // Delete the requests of the list which weren't sent.
+            //
+            while(next)
+            {
+                PendingRequest* p = next;
+                next = p->next;
+                p->next = 0;
+                delete p;
+            }
+        }
+
+        IceInternal::OutgoingAsyncBasePtr outAsync;
+        bool compress;
+        bool response;
+        int batchRequestNum;
+        PendingRequest* next;
+    };
+
+    //
+    // The proxy requests of other threads which must be retried because
+    // the connection was closed before sendPendingRequests sent them. The
+    // retry locks the proxy so the requests are retried when this object
+    // is destroyed, once the connection mutex is released.
+    //
+    class PendingRetries
+    {
+    public:
+
+        ~PendingRetries();
+
+        void add(const IceInternal::ProxyOutgoingAsyncBasePtr&, const Ice::LocalException&);
+
+    private:
+
+        std::vector<IceInternal::ProxyOutgoingAsyncBasePtr> _requests;
+        IceUtil::UniquePtr<Ice::LocalException> _exception;
+    };
+
 
 #ifdef ICE_CPP11_MAPPING
     class StartCallback
@@ -162,6 +222,16 @@ public:
     bool isActiveOrHolding() const;
     bool isFinished() const;
 
+    //
+    // Returns the number of requests awaiting a reply, or -1 if the
+    // connection isn't active or holding. This doesn't lock the
+    // connection, it's used to balance requests over pooled connections.
+    //
+    Int outstandingRequests() const
+    {
+        return _outstandingRequests.load();
+    }
+
     void throwException() const; // Throws the connection exception if destroyed.
 
     void waitUntilHolding() const;
@@ -227,6 +297,7 @@ public:
     virtual IceInternal::NativeInfoPtr getNativeInfo();
 
     void timedOut();
+    void corkTimedOut();
 
     virtual std::string type() const; // From Connection.
     virtual Ice::Int timeout() const; // From Connection.
@@ -276,22 +347,29 @@ private:
     void setState(State);
 
     void initiateShutdown();
+    void updateOutstandingRequests();
     void heartbeat();
 
     bool initialize(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
     bool validate(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
     IceInternal::SocketOperation sendNextMessage(std::vector<OutgoingMessage>&);
     IceInternal::AsyncStatus sendMessage(OutgoingMessage&);
-
-#ifdef ICE_HAS_BZIP2
-    void doCompress(Ice::OutputStream&, Ice::OutputStream&);
-    void doUncompress(Ice::InputStream&, Ice::InputStream&);
+    IceInternal::AsyncStatus sendPendingRequests(const IceInternal::OutgoingAsyncBasePtr&, PendingRetries&);
+    IceInternal::AsyncStatus sendRequest(const IceInternal::OutgoingAsyncBasePtr&, bool, bool, int);
+    bool corkable(const OutgoingMessage&) const;
+    void coalesceMessages();
+    void sendCorkedMessages();
+
+#ifdef ICE_HAS_COMPRESSION
+    void doCompress(Ice::OutputStream&, Ice::OutputStream&, Ice::Byte);
+    void doUncompress(Ice::InputStream&, Ice::InputStream&, Ice::Byte);
 #endif
 
     IceInternal::SocketOperation parseMessage(Ice::InputStream&, Int&, Int&, Byte&,
                                               IceInternal::ServantManagerPtr&, ObjectAdapterPtr&,
                                               IceInternal::OutgoingAsyncBasePtr&, ICE_HEARTBEAT_CALLBACK&, int&);
 
+    bool queueDispatch(Int, Int);
     void invokeAll(Ice::InputStream&, Int, Int, Byte,
                    const IceInternal::ServantManagerPtr&, const ObjectAdapterPtr&);
 
@@ -343,11 +421,13 @@ private:
     IceUtil::Time _acmLastActivity;
 
     const int _compressionLevel;
+    Ice::Byte _peerCompressionCodecs;
 
     Int _nextRequestId;
 
     std::map<Int, IceInternal::OutgoingAsyncBasePtr> _asyncRequests;
     std::map<Int, IceInternal::OutgoingAsyncBasePtr>::iterator _asyncRequestsHint;
+    IceUtilInternal::Atomic _outstandingRequests;
 
     IceUtil::UniquePtr<LocalException> _exception;
 
@@ -355,6 +435,21 @@ private:
     IceInternal::BatchRequestQueuePtr _batchRequestQueue;
 
     std::deque<OutgoingMessage> _sendStreams;
+    IceUtilInternal::AtomicPtr<PendingRequest> _pendingRequests;
+
+    //
+    // Small messages are held in _sendStreams for at most _corkDelay
+    // microseconds while the connection is idle and are written with a
+    // single write. _coalescedCount is the number of messages copied to
+    // _writeStream, 0 if _writeStream holds the stream of the first
+    // message.
+    //
+    const IceUtil::Int64 _corkDelay;
+    const size_t _corkMaxBytes;
+    const IceUtil::TimerTaskPtr _corkTimeout;
+    bool _corked;
+    size_t _corkedBytes;
+    size_t _coalescedCount;
 
     Ice::InputStream _readStream;
     bool _readHeader;
@@ -13,6 +13,9 @@
 #include <Ice/ConnectionI.h>
 #include <Ice/RouterInfo.h>
 #include <Ice/OutgoingAsync.h>
+#include <Ice/ConnectionFactory.h>
+#include <Ice/DefaultsAndOverrides.h>
+#include <Ice/Instance.h>
 
 using namespace std;
 using namespace IceInternal;
@@ -24,6 +27,24 @@ ConnectionRequestHandler::ConnectionRequestHandler(const ReferencePtr& reference
     _connection(connection),
     _compress(compress)
 {
+    //
+    // With connection pooling, requests are sent over the least loaded
+    // connection of the pool of the connection. Once all the connections
+    // of the pool are closed, the requests fail with the closed connection
+    // and the proxy gets a new request handler with a new pool.
+    //
+    InstancePtr instance = reference->getInstance();
+    if(instance->defaultsAndOverrides()->defaultConnectionPoolSize > 1)
+    {
+        try
+        {
+            _pool = instance->outgoingConnectionFactory()->getConnectionPool(connection);
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+            // Ignore, the request will fail with this exception.
+        }
+    }
 }
 
 RequestHandlerPtr
@@ -56,6 +77,10 @@ ConnectionRequestHandler::update(const RequestHandlerPtr& previousHandler, const
 AsyncStatus
 ConnectionRequestHandler::sendAsyncRequest(const ProxyOutgoingAsyncBasePtr& out)
 {
+    if(_pool)
+    {
+        return out->invokeRemote(_pool->select(_connection), _compress, _response);
+    }
     return out->invokeRemote(_connection, _compress, _response);
 }
 
@@ -13,6 +13,7 @@
 #include <Ice/RequestHandler.h>
 #include <Ice/ReferenceF.h>
 #include <Ice/ProxyF.h>
+#include <Ice/ConnectionFactoryF.h>
 
 namespace IceInternal
 {
@@ -39,6 +40,7 @@ private:
 
     Ice::ConnectionIPtr _connection;
     bool _compress;
+    ConnectionPoolPtr _pool;
 };
 
 }
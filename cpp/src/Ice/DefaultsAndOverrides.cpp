@@ -155,6 +155,26 @@ IceInternal::DefaultsAndOverrides::DefaultsAndOverrides(const PropertiesPtr& pro
             << properties->getProperty("Ice.Default.LocatorCacheTimeout") << "': defaulting to -1";
     }
 
+    const_cast<int&>(defaultConnectionPoolSize) =
+        properties->getPropertyAsIntWithDefault("Ice.Default.ConnectionPoolSize", 1);
+    if(defaultConnectionPoolSize < 1)
+    {
+        const_cast<Int&>(defaultConnectionPoolSize) = 1;
+        Warning out(logger);
+        out << "invalid value for Ice.Default.ConnectionPoolSize `"
+            << properties->getProperty("Ice.Default.ConnectionPoolSize") << "': defaulting to 1";
+    }
+
+    const_cast<int&>(defaultParallelConnect) =
+        properties->getPropertyAsIntWithDefault("Ice.Default.ParallelConnect", 0);
+    if(defaultParallelConnect < 0)
+    {
+        const_cast<Int&>(defaultParallelConnect) = 0;
+        Warning out(logger);
+        out << "invalid value for Ice.Default.ParallelConnect `"
+            << properties->getProperty("Ice.Default.ParallelConnect") << "': defaulting to 0";
+    }
+
     const_cast<bool&>(defaultPreferSecure) =
         properties->getPropertyAsIntWithDefault("Ice.Default.PreferSecure", 0) > 0;
 
@@ -36,6 +36,8 @@ public:
     int defaultTimeout;
     int defaultInvocationTimeout;
     int defaultLocatorCacheTimeout;
+    int defaultConnectionPoolSize;
+    int defaultParallelConnect;
     bool defaultPreferSecure;
     Ice::EncodingVersion defaultEncoding;
     Ice::FormatType defaultFormat;
@@ -519,6 +519,17 @@ Ice::InvocationCanceledException::ice_print(ostream& out) const
     out << ":\ninvocation canceled";
 }
 
+void
+Ice::DispatchRejectedException::ice_print(ostream& out) const
+{
+    Exception::ice_print(out);
+    out << ":\ndispatch rejected";
+    if(!reason.empty())
+    {
+        out << ":\n" << reason;
+    }
+}
+
 void
 Ice::ProtocolException::ice_print(ostream& out) const
 {
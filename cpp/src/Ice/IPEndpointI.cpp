@@ -488,26 +488,64 @@ IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance, Input
 
 #ifndef ICE_OS_UWP
 
+namespace
+{
+
+//
+// Expired entries are removed from the host cache when it reaches this
+// size.
+//
+const size_t cachePruneSize = 1024;
+
+}
+
 IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& instance) :
-    IceUtil::Thread("Ice.HostResolver"),
     _instance(instance),
     _protocol(instance->protocolSupport()),
     _preferIPv6(instance->preferIPv6()),
-    _destroyed(false)
+    _cacheTimeout(IceUtil::Time::seconds(
+        max(0, instance->initializationData().properties->getPropertyAsInt("Ice.HostResolver.CacheTimeout")))),
+    _negativeCacheTimeout(IceUtil::Time::seconds(
+        max(0, instance->initializationData().properties->getPropertyAsInt("Ice.HostResolver.NegativeCacheTimeout")))),
+    _destroyed(false),
+    _hits(0),
+    _negativeHits(0),
+    _lookups(0),
+    _coalesced(0)
 {
+    const PropertiesPtr& properties = _instance->initializationData().properties;
+    int size = properties->getPropertyAsIntWithDefault("Ice.HostResolver.Size", 1);
+    if(size < 1)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << "Ice.HostResolver.Size < 1; Size adjusted to 1";
+        size = 1;
+    }
+
     __setNoDelete(true);
     try
     {
-        updateObserver();
-        bool hasPriority = _instance->initializationData().properties->getProperty("Ice.ThreadPriority") != "";
-        int priority = _instance->initializationData().properties->getPropertyAsInt("Ice.ThreadPriority");
-        if(hasPriority)
+        bool hasPriority = properties->getProperty("Ice.ThreadPriority") != "";
+        int priority = properties->getPropertyAsInt("Ice.ThreadPriority");
+        for(int i = 0; i < size; ++i)
         {
-            start(0, priority);
-        }
-        else
-        {
-            start();
+            ostringstream name;
+            name << "Ice.HostResolver";
+            if(size > 1)
+            {
+                name << '-' << i;
+            }
+
+            HelperThreadPtr thread = new HelperThread(this, name.str());
+            if(hasPriority)
+            {
+                thread->start(0, priority);
+            }
+            else
+            {
+                thread->start();
+            }
+            _threads.push_back(thread);
         }
     }
     catch(const IceUtil::Exception& ex)
@@ -516,6 +554,10 @@ IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& insta
             Ice::Error out(_instance->initializationData().logger);
             out << "cannot create thread for enpoint host resolver:\n" << ex;
         }
+
+        destroy();
+        joinWithThreads();
+        __setNoDelete(false);
         throw;
     }
     __setNoDelete(false);
@@ -526,8 +568,9 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
                                            const IPEndpointIPtr& endpoint, const EndpointI_connectorsPtr& callback)
 {
     //
-    // Try to get the addresses without DNS lookup. If this doesn't work, we queue a resolve
-    // entry and the thread will take care of getting the endpoint addresses.
+    // Try to get the addresses without DNS lookup. If this doesn't work, we look up the host
+    // cache and otherwise queue a resolve entry and a thread will take care of getting the
+    // endpoint addresses.
     //
     NetworkProxyPtr networkProxy = _instance->networkProxy();
     if(!networkProxy)
@@ -552,12 +595,15 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
     assert(!_destroyed);
 
     ResolveEntry entry;
-    entry.host = host;
     entry.port = port;
     entry.selType = selType;
     entry.endpoint = endpoint;
     entry.callback = callback;
 
+    //
+    // Requests resolved with the cache are also observed as endpoint
+    // lookups.
+    //
     const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
     if(obsv)
     {
@@ -568,8 +614,43 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
         }
     }
 
-    _queue.push_back(entry);
-    notify();
+    map<string, CacheEntry>::iterator p = _cache.find(host);
+    if(p != _cache.end())
+    {
+        if(p->second.expiration > IceUtil::Time::now(IceUtil::Time::Monotonic))
+        {
+            if(p->second.failed)
+            {
+                ++_negativeHits;
+            }
+            else
+            {
+                ++_hits;
+            }
+            CacheEntry result = p->second;
+            sync.release();
+            finished(vector<ResolveEntry>(1, entry), host, result);
+            return;
+        }
+        _cache.erase(p);
+    }
+
+    //
+    // If the host is already being looked up, the entry waits for the
+    // result of this lookup.
+    //
+    vector<ResolveEntry>& entries = _pending[host];
+    if(entries.empty())
+    {
+        ++_lookups;
+        _queue.push_back(host);
+        notify();
+    }
+    else
+    {
+        ++_coalesced;
+    }
+    entries.push_back(entry);
 }
 
 void
@@ -578,16 +659,59 @@ IceInternal::EndpointHostResolver::destroy()
     Lock sync(*this);
     assert(!_destroyed);
     _destroyed = true;
-    notify();
+    notifyAll();
 }
 
 void
-IceInternal::EndpointHostResolver::run()
+IceInternal::EndpointHostResolver::joinWithThreads()
+{
+    vector<HelperThreadPtr> threads;
+    {
+        Lock sync(*this);
+        threads.swap(_threads);
+    }
+
+    for(vector<HelperThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+}
+
+void
+IceInternal::EndpointHostResolver::updateObserver()
+{
+    Lock sync(*this);
+    for(vector<HelperThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->updateObserver();
+    }
+}
+
+EndpointHostResolverStats
+IceInternal::EndpointHostResolver::getStats()
+{
+    Lock sync(*this);
+
+    EndpointHostResolverStats stats;
+    stats.hits = _hits;
+    stats.negativeHits = _negativeHits;
+    stats.lookups = _lookups;
+    stats.coalesced = _coalesced;
+    stats.pending = 0;
+    for(map<string, vector<ResolveEntry> >::const_iterator p = _pending.begin(); p != _pending.end(); ++p)
+    {
+        stats.pending += static_cast<int>(p->second.size());
+    }
+    stats.cached = static_cast<int>(_cache.size());
+    return stats;
+}
+
+void
+IceInternal::EndpointHostResolver::run(const HelperThreadPtr& thread)
 {
     while(true)
     {
-        ResolveEntry r;
-        ThreadObserverPtr threadObserver;
+        string host;
         {
             Lock sync(*this);
             while(!_destroyed && _queue.empty())
@@ -600,71 +724,211 @@ IceInternal::EndpointHostResolver::run()
                 break;
             }
 
-            r = _queue.front();
+            host = _queue.front();
             _queue.pop_front();
-            threadObserver = _observer.get();
+            thread->setState(ThreadStateInUseForOther);
         }
 
-        if(threadObserver)
+        CacheEntry result;
+        IceUtil::UniquePtr<Ice::LocalException> exception;
+        try
         {
-            threadObserver->stateChanged(ThreadStateIdle, ThreadStateInUseForOther);
+            lookup(host, result);
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            ICE_SET_EXCEPTION_FROM_CLONE(exception, ex.ice_clone());
         }
 
-        try
+        vector<ResolveEntry> entries;
+        {
+            Lock sync(*this);
+            if(!exception.get())
+            {
+                cache(host, result);
+            }
+            map<string, vector<ResolveEntry> >::iterator p = _pending.find(host);
+            assert(p != _pending.end());
+            entries.swap(p->second);
+            _pending.erase(p);
+        }
+
+        if(exception.get())
         {
-            NetworkProxyPtr networkProxy = _instance->networkProxy();
-            ProtocolSupport protocol = _protocol;
-            if(networkProxy)
+            for(vector<ResolveEntry>::const_iterator p = entries.begin(); p != entries.end(); ++p)
             {
-                networkProxy = networkProxy->resolveHost(_protocol);
-                if(networkProxy)
+                if(p->observer)
                 {
-                    protocol = networkProxy->getProtocolSupport();
+                    p->observer->failed(exception->ice_id());
+                    p->observer->detach();
                 }
+                p->callback->exception(*exception.get());
             }
+        }
+        else
+        {
+            finished(entries, host, result);
+        }
+
+        Lock sync(*this);
+        thread->setState(ThreadStateIdle);
+    }
 
-            vector<Address> addresses = getAddresses(r.host, r.port, protocol, r.selType, _preferIPv6, true);
-            if(r.observer)
+    //
+    // Fail the requests for the hosts which are still queued, the
+    // requests for the hosts being looked up by other threads are
+    // completed by these threads.
+    //
+    vector<ResolveEntry> entries;
+    {
+        Lock sync(*this);
+        for(deque<string>::const_iterator p = _queue.begin(); p != _queue.end(); ++p)
+        {
+            map<string, vector<ResolveEntry> >::iterator q = _pending.find(*p);
+            assert(q != _pending.end());
+            entries.insert(entries.end(), q->second.begin(), q->second.end());
+            _pending.erase(q);
+        }
+        _queue.clear();
+    }
+
+    for(vector<ResolveEntry>::const_iterator p = entries.begin(); p != entries.end(); ++p)
+    {
+        Ice::CommunicatorDestroyedException ex(__FILE__, __LINE__);
+        if(p->observer)
+        {
+            p->observer->failed(ex.ice_id());
+            p->observer->detach();
+        }
+        p->callback->exception(ex);
+    }
+}
+
+void
+IceInternal::EndpointHostResolver::lookup(const string& host, CacheEntry& result)
+{
+    result.networkProxy = _instance->networkProxy();
+    result.protocol = _protocol;
+    if(result.networkProxy)
+    {
+        result.networkProxy = result.networkProxy->resolveHost(_protocol);
+        if(result.networkProxy)
+        {
+            result.protocol = result.networkProxy->getProtocolSupport();
+        }
+    }
+
+    //
+    // The addresses are looked up without port and ordering, they are
+    // set for each request by finished().
+    //
+    result.failed = false;
+    result.error = 0;
+    try
+    {
+        result.addresses = getAddresses(host, 0, result.protocol, Ice::Ordered, _preferIPv6, true);
+    }
+    catch(const Ice::DNSException& ex)
+    {
+        result.failed = true;
+        result.error = ex.error;
+    }
+}
+
+void
+IceInternal::EndpointHostResolver::finished(const vector<ResolveEntry>& entries, const string& host,
+                                            const CacheEntry& result)
+{
+    for(vector<ResolveEntry>::const_iterator p = entries.begin(); p != entries.end(); ++p)
+    {
+        ObserverPtr observer = p->observer;
+        try
+        {
+            if(result.failed)
             {
-                r.observer->detach();
-                r.observer = 0;
+                Ice::DNSException ex(__FILE__, __LINE__);
+                ex.error = result.error;
+                ex.host = host;
+                throw ex;
             }
 
-            r.callback->connectors(r.endpoint->connectors(addresses, networkProxy));
+            vector<Address> addresses = result.addresses;
+            for(vector<Address>::iterator q = addresses.begin(); q != addresses.end(); ++q)
+            {
+                setPort(*q, p->port);
+            }
+            sortAddresses(addresses, result.protocol, p->selType, _preferIPv6);
 
-            if(threadObserver)
+            if(observer)
             {
-                threadObserver->stateChanged(ThreadStateInUseForOther, ThreadStateIdle);
+                observer->detach();
+                observer = 0;
             }
 
+            p->callback->connectors(p->endpoint->connectors(addresses, result.networkProxy));
         }
         catch(const Ice::LocalException& ex)
         {
-            if(threadObserver)
-            {
-                threadObserver->stateChanged(ThreadStateInUseForOther, ThreadStateIdle);
-            }
-            if(r.observer)
+            if(observer)
             {
-                r.observer->failed(ex.ice_id());
-                r.observer->detach();
+                observer->failed(ex.ice_id());
+                observer->detach();
             }
-            r.callback->exception(ex);
+            p->callback->exception(ex);
         }
     }
+}
 
-    for(deque<ResolveEntry>::const_iterator p = _queue.begin(); p != _queue.end(); ++p)
+void
+IceInternal::EndpointHostResolver::cache(const string& host, const CacheEntry& result)
+{
+    //
+    // Must be called with the mutex locked.
+    //
+    IceUtil::Time timeout = result.failed ? _negativeCacheTimeout : _cacheTimeout;
+    if(timeout == IceUtil::Time() || _destroyed)
     {
-        Ice::CommunicatorDestroyedException ex(__FILE__, __LINE__);
-        if(p->observer)
+        return;
+    }
+
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    if(_cache.size() >= cachePruneSize)
+    {
+        map<string, CacheEntry>::iterator p = _cache.begin();
+        while(p != _cache.end())
         {
-            p->observer->failed(ex.ice_id());
-            p->observer->detach();
+            if(p->second.expiration <= now)
+            {
+                _cache.erase(p++);
+            }
+            else
+            {
+                ++p;
+            }
         }
-        p->callback->exception(ex);
     }
-    _queue.clear();
 
+    CacheEntry& entry = _cache[host];
+    entry = result;
+    entry.expiration = now + timeout;
+}
+
+IceInternal::EndpointHostResolver::HelperThread::HelperThread(const EndpointHostResolverPtr& resolver,
+                                                              const string& name) :
+    IceUtil::Thread(name),
+    _resolver(resolver),
+    _state(ThreadStateIdle)
+{
+    Lock sync(*_resolver);
+    updateObserver();
+}
+
+void
+IceInternal::EndpointHostResolver::HelperThread::run()
+{
+    _resolver->run(this);
+
+    Lock sync(*_resolver);
     if(_observer)
     {
         _observer.detach();
@@ -672,14 +936,25 @@ IceInternal::EndpointHostResolver::run()
 }
 
 void
-IceInternal::EndpointHostResolver::updateObserver()
+IceInternal::EndpointHostResolver::HelperThread::updateObserver()
 {
-    Lock sync(*this);
-    const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
+    // Must be called with the resolver mutex locked
+    const CommunicatorObserverPtr& obsv = _resolver->_instance->initializationData().observer;
     if(obsv)
     {
-        _observer.attach(obsv->getThreadObserver("Communicator", name(), ThreadStateIdle, _observer.get()));
+        _observer.attach(obsv->getThreadObserver("Communicator", name(), _state, _observer.get()));
+    }
+}
+
+void
+IceInternal::EndpointHostResolver::HelperThread::setState(ThreadState state)
+{
+    // Must be called with the resolver mutex locked
+    if(_observer && _state != state)
+    {
+        _observer->stateChanged(_state, state);
     }
+    _state = state;
 }
 
 #else
@@ -714,7 +989,7 @@ IceInternal::EndpointHostResolver::destroy()
 }
 
 void
-IceInternal::EndpointHostResolver::run()
+IceInternal::EndpointHostResolver::joinWithThreads()
 {
 }
 
@@ -723,4 +998,10 @@ IceInternal::EndpointHostResolver::updateObserver()
 {
 }
 
+EndpointHostResolverStats
+IceInternal::EndpointHostResolver::getStats()
+{
+    return EndpointHostResolverStats();
+}
+
 #endif
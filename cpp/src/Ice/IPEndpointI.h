@@ -22,6 +22,7 @@
 
 #ifndef ICE_OS_UWP
 #   include <deque>
+#   include <map>
 #endif
 
 namespace IceInternal
@@ -108,8 +109,21 @@ private:
     mutable Ice::Int _hashValue;
 };
 
+//
+// Statistics of the endpoint host resolver.
+//
+struct EndpointHostResolverStats
+{
+    Ice::Long hits; // The number of requests resolved with cached addresses.
+    Ice::Long negativeHits; // The number of requests failed with a cached DNS error.
+    Ice::Long lookups; // The number of DNS lookups.
+    Ice::Long coalesced; // The number of requests which waited for the lookup of another request.
+    int pending; // The number of requests waiting for a DNS lookup.
+    int cached; // The number of cached hosts.
+};
+
 #ifndef ICE_OS_UWP
-class ICE_API EndpointHostResolver : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+class ICE_API EndpointHostResolver : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 #else
 class ICE_API EndpointHostResolver : public IceUtil::Shared
 #endif
@@ -121,16 +135,36 @@ public:
     void resolve(const std::string&, int, Ice::EndpointSelectionType, const IPEndpointIPtr&,
                  const EndpointI_connectorsPtr&);
     void destroy();
+    void joinWithThreads();
 
-    virtual void run();
     void updateObserver();
 
+    EndpointHostResolverStats getStats();
+
 private:
 
 #ifndef ICE_OS_UWP
+    class HelperThread : public IceUtil::Thread
+    {
+    public:
+
+        HelperThread(const EndpointHostResolverPtr&, const std::string&);
+        virtual void run();
+
+        void updateObserver();
+        void setState(Ice::Instrumentation::ThreadState);
+
+    private:
+
+        const EndpointHostResolverPtr _resolver;
+        ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+        Ice::Instrumentation::ThreadState _state;
+    };
+    typedef IceUtil::Handle<HelperThread> HelperThreadPtr;
+    friend class HelperThread;
+
     struct ResolveEntry
     {
-        std::string host;
         int port;
         Ice::EndpointSelectionType selType;
         IPEndpointIPtr endpoint;
@@ -138,12 +172,47 @@ private:
         Ice::Instrumentation::ObserverPtr observer;
     };
 
+    //
+    // The result of the lookup of a host. If the lookup failed with a
+    // DNS error, the addresses are empty and error is the DNS error.
+    //
+    struct CacheEntry
+    {
+        IceUtil::Time expiration;
+        std::vector<Address> addresses;
+        NetworkProxyPtr networkProxy;
+        ProtocolSupport protocol;
+        bool failed;
+        int error;
+    };
+
+    void run(const HelperThreadPtr&);
+    void lookup(const std::string&, CacheEntry&);
+    void finished(const std::vector<ResolveEntry>&, const std::string&, const CacheEntry&);
+    void cache(const std::string&, const CacheEntry&);
+
     const InstancePtr _instance;
     const IceInternal::ProtocolSupport _protocol;
     const bool _preferIPv6;
+    const IceUtil::Time _cacheTimeout;
+    const IceUtil::Time _negativeCacheTimeout;
     bool _destroyed;
-    std::deque<ResolveEntry> _queue;
-    ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+
+    //
+    // The hosts waiting for a lookup and the requests waiting for the
+    // lookup of each host, including the hosts which are being looked
+    // up by a thread. Requests for the same host share a single lookup.
+    //
+    std::deque<std::string> _queue;
+    std::map<std::string, std::vector<ResolveEntry> > _pending;
+    std::map<std::string, CacheEntry> _cache;
+
+    Ice::Long _hits;
+    Ice::Long _negativeHits;
+    Ice::Long _lookups;
+    Ice::Long _coalesced;
+
+    std::vector<HelperThreadPtr> _threads;
 #else
     const InstancePtr _instance;
 #endif
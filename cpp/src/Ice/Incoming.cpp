@@ -10,7 +10,7 @@
 #include <Ice/Incoming.h>
 #include <Ice/IncomingAsync.h>
 #include <Ice/IncomingRequest.h>
-#include <Ice/ObjectAdapter.h>
+#include <Ice/ObjectAdapterI.h>
 #include <Ice/ServantLocator.h>
 #include <Ice/ServantManager.h>
 #include <Ice/Object.h>
@@ -54,7 +54,9 @@ IceInternal::IncomingBase::IncomingBase(Instance* instance, ResponseHandler* res
     _compress(compress),
     _format(Ice::DefaultFormat),
     _os(instance, Ice::currentProtocolEncoding),
-    _responseHandler(responseHandler)
+    _responseHandler(responseHandler),
+    _dispatchAdapter(0),
+    _dispatchRejected(false)
 {
     _current.adapter = adapter;
 #ifdef ICE_CPP11_MAPPING
@@ -76,9 +78,12 @@ IceInternal::IncomingBase::IncomingBase(IncomingBase& other) :
     _format(other._format),
     _os(other._os.instance(), Ice::currentProtocolEncoding),
     _responseHandler(other._responseHandler),
+    _dispatchAdapter(other._dispatchAdapter),
+    _dispatchRejected(other._dispatchRejected),
     _interceptorCBs(other._interceptorCBs)
 {
     _observer.adopt(other._observer);
+    other._dispatchAdapter = 0;
 }
 
 OutputStream*
@@ -163,6 +168,8 @@ IceInternal::IncomingBase::response(bool amd)
             return;
         }
 
+        finishDispatch();
+
         assert(_responseHandler);
         if(_response)
         {
@@ -301,6 +308,8 @@ IceInternal::IncomingBase::handleException(const std::exception& exc, bool amd)
 {
     assert(_responseHandler);
 
+    finishDispatch();
+
     // Reset the stream, it's possible the marshalling of the response failed and left
     // the stream in an unknown state.
     _os.clear();
@@ -414,7 +423,12 @@ IceInternal::IncomingBase::handleException(const std::exception& exc, bool amd)
     }
     else if(const Exception* ex = dynamic_cast<const Exception*>(&exc))
     {
-        if(_os.instance()->initializationData().properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1) > 0)
+        //
+        // Like request failed exceptions, rejected dispatches are only
+        // warned about with Ice.Warn.Dispatch > 1.
+        //
+        int warn = _dispatchRejected ? 1 : 0;
+        if(_os.instance()->initializationData().properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1) > warn)
         {
             warning(*ex);
         }
@@ -453,6 +467,10 @@ IceInternal::IncomingBase::handleException(const std::exception& exc, bool amd)
                     str <<  '\n' << ex->ice_stackTrace();
                 }
                 _os.write(str.str(), false);
+                if(_dispatchRejected)
+                {
+                    _os.write(replyDispatchRejectedMarker);
+                }
             }
             else if(const UserException* ue = dynamic_cast<const UserException*>(&exc))
             {
@@ -522,6 +540,8 @@ IceInternal::IncomingBase::handleException(const std::exception& exc, bool amd)
 void
 IceInternal::IncomingBase::handleException(const string& msg, bool amd)
 {
+    finishDispatch();
+
     if(_os.instance()->initializationData().properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1) > 0)
     {
         warning(msg);
@@ -559,6 +579,16 @@ IceInternal::IncomingBase::handleException(const string& msg, bool amd)
 }
 
 
+void
+IceInternal::IncomingBase::finishDispatch()
+{
+    if(_dispatchAdapter)
+    {
+        _dispatchAdapter->finishDispatch();
+        _dispatchAdapter = 0;
+    }
+}
+
 IceInternal::Incoming::Incoming(Instance* instance, ResponseHandler* responseHandler, Ice::Connection* connection,
                                 const ObjectAdapterPtr& adapter, bool response, Byte compress, Int requestId) :
     IncomingBase(instance, responseHandler, connection, adapter, response, compress, requestId),
@@ -570,20 +600,20 @@ IceInternal::Incoming::Incoming(Instance* instance, ResponseHandler* responseHan
 void
 IceInternal::Incoming::push(function<bool()> response, function<bool(exception_ptr)> exception)
 {
-    _interceptorCBs.push_front(make_pair(response, exception));
+    _interceptorCBs.insert(_interceptorCBs.begin(), make_pair(response, exception));
 }
 #else
 void
 IceInternal::Incoming::push(const Ice::DispatchInterceptorAsyncCallbackPtr& cb)
 {
-    _interceptorCBs.push_front(cb);
+    _interceptorCBs.insert(_interceptorCBs.begin(), cb);
 }
 #endif
 
 void
 IceInternal::Incoming::pop()
 {
-    _interceptorCBs.pop_front();
+    _interceptorCBs.erase(_interceptorCBs.begin());
 }
 
 void
@@ -624,22 +654,18 @@ IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, InputStre
     _is->read(_current.id);
 
     //
-    // For compatibility with the old FacetPath.
+    // For compatibility with the old FacetPath. The facet is read directly
+    // rather than through a sequence of strings.
     //
-    string facet;
+    Int facetPathSize = _is->readSize();
+    if(facetPathSize > 1)
     {
-        vector<string> facetPath;
-        _is->read(facetPath);
-        if(!facetPath.empty())
-        {
-            if(facetPath.size() > 1)
-            {
-                throw MarshalException(__FILE__, __LINE__);
-            }
-            facet.swap(facetPath[0]);
-        }
+        throw MarshalException(__FILE__, __LINE__);
+    }
+    else if(facetPathSize == 1)
+    {
+        _is->read(_current.facet);
     }
-    _current.facet.swap(facet);
 
     _is->read(_current.operation, false);
 
@@ -647,13 +673,17 @@ IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, InputStre
     _is->read(b);
     _current.mode = static_cast<OperationMode>(b);
 
+    //
+    // Read the context values in place rather than copying them into the
+    // context map.
+    //
     Int sz = _is->readSize();
+    string key;
     while(sz--)
     {
-        pair<const string, string> pr;
-        _is->read(const_cast<string&>(pr.first));
-        _is->read(pr.second);
-        _current.ctx.insert(_current.ctx.end(), pr);
+        _is->read(key);
+        Context::iterator p = _current.ctx.insert(_current.ctx.end(), Context::value_type(key, string()));
+        _is->read(p->second);
     }
 
     const CommunicatorObserverPtr& obsv = _is->instance()->initializationData().observer;
@@ -667,6 +697,28 @@ IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, InputStre
         _observer.attach(obsv->getDispatchObserver(_current, static_cast<Int>(_is->i - start + sz)));
     }
 
+    //
+    // The dispatch is rejected if the object adapter reached its
+    // concurrent dispatch limit.
+    //
+    if(ObjectAdapterI* adapter = dynamic_cast<ObjectAdapterI*>(_current.adapter.get()))
+    {
+        try
+        {
+            if(adapter->startDispatch())
+            {
+                _dispatchAdapter = adapter;
+            }
+        }
+        catch(const DispatchRejectedException& ex)
+        {
+            skipReadParams(); // Required for batch requests
+            _dispatchRejected = true;
+            handleException(ex, false);
+            return;
+        }
+    }
+
     //
     // Don't put the code above into the try block below. Exceptions
     // in the code above are considered fatal, and must propagate to
@@ -66,7 +66,8 @@ Init init;
 IceInternal::IncomingAsync::IncomingAsync(Incoming& in) :
     IncomingBase(in),
     _responseSent(false),
-    _responseHandlerCopy(ICE_GET_SHARED_FROM_THIS(_responseHandler))
+    _responseHandlerCopy(ICE_GET_SHARED_FROM_THIS(_responseHandler)),
+    _requestMemory(in._is ? in._is->b.share() : BufferMemoryPtr())
 {
 #ifndef ICE_CPP11_MAPPING
     in.setAsync(this);
@@ -135,6 +136,8 @@ IceInternal::IncomingAsync::kill(Incoming& in)
 {
     checkResponseSent();
     in._observer.adopt(_observer); // Give back the observer to incoming.
+    in._dispatchAdapter = _dispatchAdapter;
+    _dispatchAdapter = 0;
 }
 
 void
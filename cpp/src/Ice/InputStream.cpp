@@ -1133,7 +1133,7 @@ Ice::InputStream::read(std::string& v, bool convert)
 
         if(!convert || !readConverted(v, sz))
         {
-            string(reinterpret_cast<const char*>(&*i), reinterpret_cast<const char*>(&*i) + sz).swap(v);
+            v.assign(reinterpret_cast<const char*>(&*i), static_cast<size_t>(sz));
         }
         i += sz;
     }
@@ -1300,9 +1300,41 @@ Ice::InputStream::read(vector<string>& v, bool convert)
     if(sz > 0)
     {
         v.resize(sz);
-        for(int j = 0; j < sz; ++j)
+
+        //
+        // Look up the string converter once for the whole sequence rather
+        // than once for each string.
+        //
+        StringConverterPtr stringConverter;
+        if(convert)
+        {
+            stringConverter = _instance ? _instance->getStringConverter() : getProcessStringConverter();
+        }
+
+        try
+        {
+            for(int j = 0; j < sz; ++j)
+            {
+                Int len = readSize();
+                if(b.end() - i < len)
+                {
+                    throwUnmarshalOutOfBoundsException(__FILE__, __LINE__);
+                }
+
+                if(stringConverter && len > 0)
+                {
+                    stringConverter->fromUTF8(i, i + len, v[j]);
+                }
+                else
+                {
+                    v[j].assign(reinterpret_cast<const char*>(&*i), static_cast<size_t>(len));
+                }
+                i += len;
+            }
+        }
+        catch(const IllegalConversionException& ex)
         {
-            read(v[j], convert);
+            throw StringConversionException(__FILE__, __LINE__, ex.reason());
         }
     }
     else
@@ -1355,9 +1387,38 @@ Ice::InputStream::read(vector<wstring>& v)
     if(sz > 0)
     {
         v.resize(sz);
-        for(int j = 0; j < sz; ++j)
+
+        //
+        // Look up the wstring converter once for the whole sequence rather
+        // than once for each string.
+        //
+        WstringConverterPtr wstringConverter =
+            _instance ? _instance->getWstringConverter() : getProcessWstringConverter();
+
+        try
+        {
+            for(int j = 0; j < sz; ++j)
+            {
+                Int len = readSize();
+                if(b.end() - i < len)
+                {
+                    throwUnmarshalOutOfBoundsException(__FILE__, __LINE__);
+                }
+
+                if(len > 0)
+                {
+                    wstringConverter->fromUTF8(i, i + len, v[j]);
+                }
+                else
+                {
+                    v[j].clear();
+                }
+                i += len;
+            }
+        }
+        catch(const IllegalConversionException& ex)
         {
-            read(v[j]);
+            throw StringConversionException(__FILE__, __LINE__, ex.reason());
         }
     }
     else
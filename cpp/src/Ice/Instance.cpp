@@ -43,6 +43,7 @@
 #include <Ice/RegisterPluginsInit.h>
 #include <Ice/ObserverHelper.h>
 #include <Ice/Functional.h>
+#include <Ice/Protocol.h>
 
 #include <IceUtil/DisableWarnings.h>
 #include <IceUtil/FileUtil.h>
@@ -949,6 +950,7 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
     _batchAutoFlushSize(0),
     _collectObjects(false),
     _toStringMode(ICE_ENUM(ToStringMode, Unicode)),
+    _compressionCodec(compressionCodecBZip2),
     _implicitContext(0),
     _stringConverter(Ice::getProcessStringConverter()),
     _wstringConverter(Ice::getProcessWstringConverter()),
@@ -1204,6 +1206,28 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
             throw InitializationException(__FILE__, __LINE__, "The value for Ice.ToStringMode must be Unicode, ASCII or Compat");
         }
 
+        string compressionCodecStr = _initData.properties->getPropertyWithDefault("Ice.Compression.Codec", "bzip2");
+        if(compressionCodecStr == "lz4")
+        {
+#ifdef ICE_HAS_LZ4
+            const_cast<Byte&>(_compressionCodec) = compressionCodecLZ4;
+#else
+            throw InitializationException(__FILE__, __LINE__, "The lz4 compression codec is not supported by this build");
+#endif
+        }
+        else if(compressionCodecStr == "zstd")
+        {
+#ifdef ICE_HAS_ZSTD
+            const_cast<Byte&>(_compressionCodec) = compressionCodecZstd;
+#else
+            throw InitializationException(__FILE__, __LINE__, "The zstd compression codec is not supported by this build");
+#endif
+        }
+        else if(compressionCodecStr != "bzip2")
+        {
+            throw InitializationException(__FILE__, __LINE__, "The value for Ice.Compression.Codec must be bzip2, lz4 or zstd");
+        }
+
 
         //
         // Client ACM enabled by default. Server ACM disabled by default.
@@ -1416,6 +1440,7 @@ IceInternal::Instance::finishSetup(int& argc, char* argv[], const Ice::Communica
         {
             CommunicatorObserverIPtr observer = ICE_MAKE_SHARED(CommunicatorObserverI, _initData);
             _initData.observer = observer;
+            observer->setLocatorManager(_locatorManager);
             _adminFacets.insert(make_pair(metricsFacetName, observer->getFacet()));
 
             //
@@ -1476,6 +1501,12 @@ IceInternal::Instance::finishSetup(int& argc, char* argv[], const Ice::Communica
         throw;
     }
 
+    CommunicatorObserverIPtr observer = ICE_DYNAMIC_CAST(CommunicatorObserverI, _initData.observer);
+    if(observer)
+    {
+        observer->setEndpointHostResolver(_endpointHostResolver);
+    }
+
     _clientThreadPool = new ThreadPool(this, "Ice.ThreadPool.Client", 0);
 
     //
@@ -1663,7 +1694,7 @@ IceInternal::Instance::destroy()
 #ifndef ICE_OS_UWP
     if(_endpointHostResolver)
     {
-        _endpointHostResolver->getThreadControl().join();
+        _endpointHostResolver->joinWithThreads();
     }
 #endif
 
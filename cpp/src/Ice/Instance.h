@@ -111,6 +111,7 @@ public:
     size_t batchAutoFlushSize() const { return _batchAutoFlushSize; }
     bool collectObjects() const { return _collectObjects; }
     Ice::ToStringMode toStringMode() const { return _toStringMode; }
+    Ice::Byte compressionCodec() const { return _compressionCodec; }
     const ACMConfig& clientACM() const;
     const ACMConfig& serverACM() const;
 
@@ -179,6 +180,7 @@ private:
     const size_t _batchAutoFlushSize; // Immutable, not reset by destroy().
     const bool _collectObjects; // Immutable, not reset by destroy().
     const Ice::ToStringMode _toStringMode; // Immutable, not reset by destroy()
+    const Ice::Byte _compressionCodec; // Immutable, not reset by destroy()
     ACMConfig _clientACM;
     ACMConfig _serverACM;
     RouterManagerPtr _routerManager;
@@ -9,6 +9,9 @@
 
 #include <Ice/InstrumentationI.h>
 
+#include <Ice/BufferPool.h>
+#include <Ice/LocatorInfo.h>
+#include <Ice/IPEndpointI.h>
 #include <Ice/Connection.h>
 #include <Ice/Endpoint.h>
 #include <Ice/ObjectAdapter.h>
@@ -72,6 +75,26 @@ struct ThreadStateChanged
     ThreadState newState;
 };
 
+struct ThreadWorkCompleted
+{
+    ThreadWorkCompleted(Long queueDelay, Long serviceTime, Int targetSize) :
+        queueDelay(queueDelay), serviceTime(serviceTime), targetSize(targetSize)
+    {
+    }
+
+    void operator()(const ThreadMetricsPtr& v)
+    {
+        ++v->executed;
+        v->queueDelay += queueDelay;
+        v->serviceTime += serviceTime;
+        v->targetSize = targetSize;
+    }
+
+    Long queueDelay;
+    Long serviceTime;
+    Int targetSize;
+};
+
 IPConnectionInfo*
 getIPConnectionInfo(const ConnectionInfoPtr& info)
 {
@@ -772,6 +795,231 @@ private:
 
 EndpointHelper::Attributes EndpointHelper::attributes;
 
+//
+// The buffer pool metrics aren't updated by observers, the metrics are
+// instead computed from the buffer pool statistics when the map is
+// retrieved. There's one metrics object for each size class, the map
+// GroupBy, Accept and Reject properties are ignored.
+//
+class BufferPoolMetricsMap : public MetricsMapI
+{
+public:
+
+    BufferPoolMetricsMap(const string& mapPrefix, const PropertiesPtr& properties) :
+        MetricsMapI(mapPrefix, properties)
+    {
+    }
+
+    virtual void destroy()
+    {
+    }
+
+    virtual MetricsFailuresSeq getFailures()
+    {
+        return MetricsFailuresSeq();
+    }
+
+    virtual MetricsFailures getFailures(const string&)
+    {
+        return MetricsFailures();
+    }
+
+    virtual MetricsMap getMetrics() const
+    {
+        MetricsMap metrics;
+        vector<BufferPoolStats> stats = getBufferPoolStats();
+        for(vector<BufferPoolStats>::const_iterator p = stats.begin(); p != stats.end(); ++p)
+        {
+            BufferPoolMetricsPtr m = ICE_MAKE_SHARED(BufferPoolMetrics);
+            ostringstream os;
+            os << p->size;
+            m->id = os.str();
+            m->total = p->allocated;
+            m->current = static_cast<Int>(max<Ice::Long>(p->allocated - p->released, 0));
+            m->hits = p->hits;
+            m->cached = p->cached;
+            metrics.push_back(m);
+        }
+        return metrics;
+    }
+
+    virtual MetricsMapIPtr clone() const
+    {
+        return ICE_MAKE_SHARED(BufferPoolMetricsMap, *this);
+    }
+};
+
+class BufferPoolMetricsMapFactory : public MetricsMapFactory
+{
+public:
+
+    BufferPoolMetricsMapFactory() : MetricsMapFactory(0)
+    {
+    }
+
+    virtual MetricsMapIPtr
+    create(const string& mapPrefix, const PropertiesPtr& properties)
+    {
+        return ICE_MAKE_SHARED(BufferPoolMetricsMap, mapPrefix, properties);
+    }
+};
+
+//
+// Like the buffer pool metrics, the locator cache metrics are computed
+// from the locator tables statistics when the map is retrieved. There's
+// one metrics object for each locator.
+//
+class LocatorCacheMetricsMap : public MetricsMapI
+{
+public:
+
+    LocatorCacheMetricsMap(const string& mapPrefix, const PropertiesPtr& properties,
+                           const LocatorManagerPtr& locatorManager) :
+        MetricsMapI(mapPrefix, properties),
+        _locatorManager(locatorManager)
+    {
+    }
+
+    virtual void destroy()
+    {
+    }
+
+    virtual MetricsFailuresSeq getFailures()
+    {
+        return MetricsFailuresSeq();
+    }
+
+    virtual MetricsFailures getFailures(const string&)
+    {
+        return MetricsFailures();
+    }
+
+    virtual MetricsMap getMetrics() const
+    {
+        MetricsMap metrics;
+        vector<LocatorTableStats> stats = _locatorManager->getStats();
+        for(vector<LocatorTableStats>::const_iterator p = stats.begin(); p != stats.end(); ++p)
+        {
+            LocatorCacheMetricsPtr m = ICE_MAKE_SHARED(LocatorCacheMetrics);
+            m->id = p->id;
+            m->total = p->added;
+            m->current = p->entries;
+            m->hits = p->hits;
+            m->misses = p->misses;
+            m->refreshes = p->refreshes;
+            m->evictions = p->evictions;
+            metrics.push_back(m);
+        }
+        return metrics;
+    }
+
+    virtual MetricsMapIPtr clone() const
+    {
+        return ICE_MAKE_SHARED(LocatorCacheMetricsMap, *this);
+    }
+
+private:
+
+    const LocatorManagerPtr _locatorManager;
+};
+
+class LocatorCacheMetricsMapFactory : public MetricsMapFactory
+{
+public:
+
+    LocatorCacheMetricsMapFactory(const LocatorManagerPtr& locatorManager) :
+        MetricsMapFactory(0),
+        _locatorManager(locatorManager)
+    {
+    }
+
+    virtual MetricsMapIPtr
+    create(const string& mapPrefix, const PropertiesPtr& properties)
+    {
+        return ICE_MAKE_SHARED(LocatorCacheMetricsMap, mapPrefix, properties, _locatorManager);
+    }
+
+private:
+
+    const LocatorManagerPtr _locatorManager;
+};
+
+//
+// The host resolver metrics are computed from the endpoint host resolver
+// statistics when the map is retrieved. The map has a single metrics
+// object.
+//
+class HostResolverMetricsMap : public MetricsMapI
+{
+public:
+
+    HostResolverMetricsMap(const string& mapPrefix, const PropertiesPtr& properties,
+                           const EndpointHostResolverPtr& resolver) :
+        MetricsMapI(mapPrefix, properties),
+        _resolver(resolver)
+    {
+    }
+
+    virtual void destroy()
+    {
+    }
+
+    virtual MetricsFailuresSeq getFailures()
+    {
+        return MetricsFailuresSeq();
+    }
+
+    virtual MetricsFailures getFailures(const string&)
+    {
+        return MetricsFailures();
+    }
+
+    virtual MetricsMap getMetrics() const
+    {
+        EndpointHostResolverStats stats = _resolver->getStats();
+        HostResolverMetricsPtr m = ICE_MAKE_SHARED(HostResolverMetrics);
+        m->id = "HostResolver";
+        m->total = stats.hits + stats.negativeHits + stats.lookups + stats.coalesced;
+        m->current = stats.pending;
+        m->hits = stats.hits;
+        m->negativeHits = stats.negativeHits;
+        m->lookups = stats.lookups;
+        m->coalesced = stats.coalesced;
+        m->cached = stats.cached;
+        return MetricsMap(1, m);
+    }
+
+    virtual MetricsMapIPtr clone() const
+    {
+        return ICE_MAKE_SHARED(HostResolverMetricsMap, *this);
+    }
+
+private:
+
+    const EndpointHostResolverPtr _resolver;
+};
+
+class HostResolverMetricsMapFactory : public MetricsMapFactory
+{
+public:
+
+    HostResolverMetricsMapFactory(const EndpointHostResolverPtr& resolver) :
+        MetricsMapFactory(0),
+        _resolver(resolver)
+    {
+    }
+
+    virtual MetricsMapIPtr
+    create(const string& mapPrefix, const PropertiesPtr& properties)
+    {
+        return ICE_MAKE_SHARED(HostResolverMetricsMap, mapPrefix, properties, _resolver);
+    }
+
+private:
+
+    const EndpointHostResolverPtr _resolver;
+};
+
 }
 
 void
@@ -805,6 +1053,12 @@ ThreadObserverI::stateChanged(ThreadState oldState, ThreadState newState)
 
 }
 
+void
+ThreadObserverI::workCompleted(Long queueDelay, Long serviceTime, Int targetSize)
+{
+    forEach(ThreadWorkCompleted(queueDelay, serviceTime, targetSize));
+}
+
 void
 DispatchObserverI::userException()
 {
@@ -920,6 +1174,7 @@ CommunicatorObserverI::CommunicatorObserverI(const InitializationData& initData)
 {
     _invocations.registerSubMap<RemoteMetrics>("Remote", &InvocationMetrics::remotes);
     _invocations.registerSubMap<CollocatedMetrics>("Collocated", &InvocationMetrics::collocated);
+    _metrics->registerMap("BufferPool", ICE_MAKE_SHARED(BufferPoolMetricsMapFactory));
 }
 
 void
@@ -1086,6 +1341,18 @@ CommunicatorObserverI::getFacet() const
     return _metrics;
 }
 
+void
+CommunicatorObserverI::setLocatorManager(const LocatorManagerPtr& locatorManager)
+{
+    _metrics->registerMap("LocatorCache", ICE_MAKE_SHARED(LocatorCacheMetricsMapFactory, locatorManager));
+}
+
+void
+CommunicatorObserverI::setEndpointHostResolver(const EndpointHostResolverPtr& resolver)
+{
+    _metrics->registerMap("HostResolver", ICE_MAKE_SHARED(HostResolverMetricsMapFactory, resolver));
+}
+
 void
 CommunicatorObserverI::destroy()
 {
@@ -1096,5 +1363,10 @@ CommunicatorObserverI::destroy()
     _connects.destroy();
     _endpointLookups.destroy();
 
+    //
+    // The host resolver map references the resolver, which references
+    // the instance.
+    //
+    _metrics->unregisterMap("HostResolver");
     _metrics->destroy();
 }
@@ -12,6 +12,8 @@
 
 #include <Ice/MetricsObserverI.h>
 #include <Ice/Connection.h>
+#include <Ice/LocatorInfoF.h>
+#include <Ice/IPEndpointIF.h>
 
 namespace IceInternal
 {
@@ -165,6 +167,12 @@ class ThreadObserverI : public ObserverWithDelegateT<IceMX::ThreadMetrics, Ice::
 public:
 
     virtual void stateChanged(Ice::Instrumentation::ThreadState, Ice::Instrumentation::ThreadState);
+
+    //
+    // Called by the thread pool threads each time they're done with a
+    // work item, this isn't part of the ThreadObserver interface.
+    //
+    void workCompleted(Ice::Long, Ice::Long, Ice::Int);
 };
 
 class DispatchObserverI : public ObserverWithDelegateT<IceMX::DispatchMetrics, Ice::Instrumentation::DispatchObserver>
@@ -240,6 +248,18 @@ public:
 
     const IceInternal::MetricsAdminIPtr& getFacet() const;
 
+    //
+    // Register the locator cache metrics map, which is computed from the
+    // statistics of the given locator manager.
+    //
+    void setLocatorManager(const IceInternal::LocatorManagerPtr&);
+
+    //
+    // Register the host resolver metrics map, which is computed from the
+    // statistics of the given endpoint host resolver.
+    //
+    void setEndpointHostResolver(const IceInternal::EndpointHostResolverPtr&);
+
     void destroy();
 
 private:
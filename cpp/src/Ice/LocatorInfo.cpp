@@ -129,6 +129,8 @@ public:
 
 IceInternal::LocatorManager::LocatorManager(const Ice::PropertiesPtr& properties) :
     _background(properties->getPropertyAsInt("Ice.BackgroundLocatorCacheUpdates") > 0),
+    _refreshThreshold(properties->getPropertyAsInt("Ice.LocatorCacheRefreshThreshold")),
+    _cacheSize(static_cast<size_t>(max(properties->getPropertyAsInt("Ice.LocatorCacheSize"), 0))),
     _tableHint(_table.end())
 {
 }
@@ -193,7 +195,7 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
         {
             t = _locatorTables.insert(_locatorTables.begin(),
                                       pair<const pair<Identity, EncodingVersion>, LocatorTablePtr>(
-                                          locatorKey, new LocatorTable()));
+                                          locatorKey, new LocatorTable(_refreshThreshold, _cacheSize)));
         }
 
         _tableHint = _table.insert(_tableHint,
@@ -209,7 +211,30 @@ IceInternal::LocatorManager::get(const LocatorPrxPtr& loc)
     return _tableHint->second;
 }
 
-IceInternal::LocatorTable::LocatorTable()
+vector<LocatorTableStats>
+IceInternal::LocatorManager::getStats()
+{
+    IceUtil::Mutex::Lock sync(*this);
+
+    vector<LocatorTableStats> stats;
+    for(map<pair<Identity, EncodingVersion>, LocatorTablePtr>::const_iterator p = _locatorTables.begin();
+        p != _locatorTables.end(); ++p)
+    {
+        LocatorTableStats s = p->second->getStats();
+        s.id = identityToString(p->first.first) + " -e " + encodingVersionToString(p->first.second);
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+IceInternal::LocatorTable::LocatorTable(int refreshThreshold, size_t maxSize) :
+    _refreshThreshold(refreshThreshold > 0 && refreshThreshold < 100 ? refreshThreshold : 0),
+    _maxSize(maxSize),
+    _added(0),
+    _hits(0),
+    _misses(0),
+    _refreshes(0),
+    _evictions(0)
 {
 }
 
@@ -219,26 +244,52 @@ IceInternal::LocatorTable::clear()
      IceUtil::Mutex::Lock sync(*this);
 
      _adapterEndpointsMap.clear();
+     _adapterLRU.clear();
      _objectMap.clear();
+     _objectLRU.clear();
 }
 
 bool
-IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, vector<EndpointIPtr>& endpoints)
+IceInternal::LocatorTable::getAdapterEndpoints(const string& adapter, int ttl, vector<EndpointIPtr>& endpoints,
+                                               bool& refresh)
 {
+    refresh = false;
+
+    IceUtil::Mutex::Lock sync(*this);
+
     if(ttl == 0) // No locator cache.
     {
+        ++_misses;
         return false;
     }
 
-    IceUtil::Mutex::Lock sync(*this);
-
-    map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::iterator p = _adapterEndpointsMap.find(adapter);
+    map<string, AdapterEntry>::iterator p = _adapterEndpointsMap.find(adapter);
 
     if(p != _adapterEndpointsMap.end())
     {
-        endpoints = p->second.second;
-        return checkTTL(p->second.first, ttl);
+        _adapterLRU.splice(_adapterLRU.begin(), _adapterLRU, p->second.lru);
+        endpoints = p->second.endpoints;
+        if(checkTTL(p->second.time, ttl, refresh))
+        {
+            ++_hits;
+
+            //
+            // Only the first lookup which finds the entry due for refresh
+            // refreshes it.
+            //
+            if(refresh && !p->second.refreshing)
+            {
+                p->second.refreshing = true;
+                ++_refreshes;
+            }
+            else
+            {
+                refresh = false;
+            }
+            return true;
+        }
     }
+    ++_misses;
     return false;
 }
 
@@ -247,17 +298,30 @@ IceInternal::LocatorTable::addAdapterEndpoints(const string& adapter, const vect
 {
     IceUtil::Mutex::Lock sync(*this);
 
-    map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::iterator p = _adapterEndpointsMap.find(adapter);
+    map<string, AdapterEntry>::iterator p = _adapterEndpointsMap.find(adapter);
 
     if(p != _adapterEndpointsMap.end())
     {
-        p->second = make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), endpoints);
+        _adapterLRU.splice(_adapterLRU.begin(), _adapterLRU, p->second.lru);
     }
     else
     {
-        _adapterEndpointsMap.insert(
-            make_pair(adapter, make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), endpoints)));
+        _adapterLRU.push_front(adapter);
+        p = _adapterEndpointsMap.insert(make_pair(adapter, AdapterEntry())).first;
+        p->second.lru = _adapterLRU.begin();
+        ++_added;
+
+        if(_maxSize > 0 && _adapterEndpointsMap.size() > _maxSize)
+        {
+            _adapterEndpointsMap.erase(_adapterLRU.back());
+            _adapterLRU.pop_back();
+            ++_evictions;
+        }
     }
+
+    p->second.time = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    p->second.endpoints = endpoints;
+    p->second.refreshing = false;
 }
 
 vector<EndpointIPtr>
@@ -265,36 +329,55 @@ IceInternal::LocatorTable::removeAdapterEndpoints(const string& adapter)
 {
     IceUtil::Mutex::Lock sync(*this);
 
-    map<string, pair<IceUtil::Time, vector<EndpointIPtr> > >::iterator p = _adapterEndpointsMap.find(adapter);
+    map<string, AdapterEntry>::iterator p = _adapterEndpointsMap.find(adapter);
     if(p == _adapterEndpointsMap.end())
     {
         return vector<EndpointIPtr>();
     }
 
-    vector<EndpointIPtr> endpoints = p->second.second;
+    vector<EndpointIPtr> endpoints = p->second.endpoints;
 
+    _adapterLRU.erase(p->second.lru);
     _adapterEndpointsMap.erase(p);
 
     return endpoints;
 }
 
 bool
-IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, ReferencePtr& ref)
+IceInternal::LocatorTable::getObjectReference(const Identity& id, int ttl, ReferencePtr& ref, bool& refresh)
 {
+    refresh = false;
+
+    IceUtil::Mutex::Lock sync(*this);
+
     if(ttl == 0) // No locator cache
     {
+        ++_misses;
         return false;
     }
 
-    IceUtil::Mutex::Lock sync(*this);
-
-    map<Identity, pair<IceUtil::Time, ReferencePtr> >::iterator p = _objectMap.find(id);
+    map<Identity, ObjectEntry>::iterator p = _objectMap.find(id);
 
     if(p != _objectMap.end())
     {
-        ref = p->second.second;
-        return checkTTL(p->second.first, ttl);
+        _objectLRU.splice(_objectLRU.begin(), _objectLRU, p->second.lru);
+        ref = p->second.reference;
+        if(checkTTL(p->second.time, ttl, refresh))
+        {
+            ++_hits;
+            if(refresh && !p->second.refreshing)
+            {
+                p->second.refreshing = true;
+                ++_refreshes;
+            }
+            else
+            {
+                refresh = false;
+            }
+            return true;
+        }
     }
+    ++_misses;
     return false;
 }
 
@@ -303,16 +386,30 @@ IceInternal::LocatorTable::addObjectReference(const Identity& id, const Referenc
 {
     IceUtil::Mutex::Lock sync(*this);
 
-    map<Identity, pair<IceUtil::Time, ReferencePtr> >::iterator p = _objectMap.find(id);
+    map<Identity, ObjectEntry>::iterator p = _objectMap.find(id);
 
     if(p != _objectMap.end())
     {
-        p->second = make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), ref);
+        _objectLRU.splice(_objectLRU.begin(), _objectLRU, p->second.lru);
     }
     else
     {
-        _objectMap.insert(make_pair(id, make_pair(IceUtil::Time::now(IceUtil::Time::Monotonic), ref)));
+        _objectLRU.push_front(id);
+        p = _objectMap.insert(make_pair(id, ObjectEntry())).first;
+        p->second.lru = _objectLRU.begin();
+        ++_added;
+
+        if(_maxSize > 0 && _objectMap.size() > _maxSize)
+        {
+            _objectMap.erase(_objectLRU.back());
+            _objectLRU.pop_back();
+            ++_evictions;
+        }
     }
+
+    p->second.time = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    p->second.reference = ref;
+    p->second.refreshing = false;
 }
 
 ReferencePtr
@@ -320,19 +417,35 @@ IceInternal::LocatorTable::removeObjectReference(const Identity& id)
 {
     IceUtil::Mutex::Lock sync(*this);
 
-    map<Identity, pair<IceUtil::Time, ReferencePtr> >::iterator p = _objectMap.find(id);
+    map<Identity, ObjectEntry>::iterator p = _objectMap.find(id);
     if(p == _objectMap.end())
     {
         return 0;
     }
 
-    ReferencePtr ref = p->second.second;
+    ReferencePtr ref = p->second.reference;
+    _objectLRU.erase(p->second.lru);
     _objectMap.erase(p);
     return ref;
 }
 
+LocatorTableStats
+IceInternal::LocatorTable::getStats()
+{
+    IceUtil::Mutex::Lock sync(*this);
+
+    LocatorTableStats stats;
+    stats.entries = static_cast<int>(_adapterEndpointsMap.size() + _objectMap.size());
+    stats.added = _added;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    stats.refreshes = _refreshes;
+    stats.evictions = _evictions;
+    return stats;
+}
+
 bool
-IceInternal::LocatorTable::checkTTL(const IceUtil::Time& time, int ttl) const
+IceInternal::LocatorTable::checkTTL(const IceUtil::Time& time, int ttl, bool& refresh) const
 {
     assert(ttl != 0);
     if (ttl < 0) // TTL = infinite
@@ -341,7 +454,14 @@ IceInternal::LocatorTable::checkTTL(const IceUtil::Time& time, int ttl) const
     }
     else
     {
-        return IceUtil::Time::now(IceUtil::Time::Monotonic) - time <= IceUtil::Time::seconds(ttl);
+        IceUtil::Time age = IceUtil::Time::now(IceUtil::Time::Monotonic) - time;
+        if(age > IceUtil::Time::seconds(ttl))
+        {
+            return false;
+        }
+        refresh = _refreshThreshold > 0 &&
+            age.toMilliSeconds() * 100 > static_cast<IceUtil::Int64>(ttl) * 1000 * _refreshThreshold;
+        return true;
     }
 }
 
@@ -613,7 +733,8 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref, const ReferenceP
     vector<EndpointIPtr> endpoints;
     if(!ref->isWellKnown())
     {
-        if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints))
+        bool refresh;
+        if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints, refresh))
         {
             if(_background && !endpoints.empty())
             {
@@ -624,11 +745,16 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref, const ReferenceP
                 return getAdapterRequest(ref)->getEndpoints(ref, wellKnownRef, ttl, cached);
             }
         }
+        else if(refresh)
+        {
+            getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, 0);
+        }
     }
     else
     {
         ReferencePtr r;
-        if(!_table->getObjectReference(ref->getIdentity(), ttl, r))
+        bool refresh;
+        if(!_table->getObjectReference(ref->getIdentity(), ttl, r, refresh))
         {
             if(_background && r)
             {
@@ -639,6 +765,10 @@ IceInternal::LocatorInfo::getEndpoints(const ReferencePtr& ref, const ReferenceP
                 return getObjectRequest(ref)->getEndpoints(ref, 0, ttl, cached);
             }
         }
+        else if(refresh)
+        {
+            getObjectRequest(ref)->addCallback(ref, 0, ttl, 0);
+        }
 
         if(!r->isIndirect())
         {
@@ -669,7 +799,8 @@ IceInternal::LocatorInfo::getEndpointsWithCallback(const ReferencePtr& ref,
     vector<EndpointIPtr> endpoints;
     if(!ref->isWellKnown())
     {
-        if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints))
+        bool refresh;
+        if(!_table->getAdapterEndpoints(ref->getAdapterId(), ttl, endpoints, refresh))
         {
             if(_background && !endpoints.empty())
             {
@@ -681,11 +812,16 @@ IceInternal::LocatorInfo::getEndpointsWithCallback(const ReferencePtr& ref,
                 return;
             }
         }
+        else if(refresh)
+        {
+            getAdapterRequest(ref)->addCallback(ref, wellKnownRef, ttl, 0);
+        }
     }
     else
     {
         ReferencePtr r;
-        if(!_table->getObjectReference(ref->getIdentity(), ttl, r))
+        bool refresh;
+        if(!_table->getObjectReference(ref->getIdentity(), ttl, r, refresh))
         {
             if(_background && r)
             {
@@ -697,6 +833,10 @@ IceInternal::LocatorInfo::getEndpointsWithCallback(const ReferencePtr& ref,
                 return;
             }
         }
+        else if(refresh)
+        {
+            getObjectRequest(ref)->addCallback(ref, 0, ttl, 0);
+        }
 
         if(!r->isIndirect())
         {
@@ -24,9 +24,25 @@
 
 #include <IceUtil/UniquePtr.h>
 
+#include <list>
+
 namespace IceInternal
 {
 
+//
+// Statistics of a locator table.
+//
+struct LocatorTableStats
+{
+    std::string id; // The identity and encoding of the locator.
+    int entries; // The number of cached entries.
+    Ice::Long added; // The number of entries added to the cache.
+    Ice::Long hits; // The number of lookups which found a valid entry.
+    Ice::Long misses; // The number of lookups which didn't find a valid entry.
+    Ice::Long refreshes; // The number of entries refreshed before they expired.
+    Ice::Long evictions; // The number of entries evicted to bound the cache size.
+};
+
 class LocatorManager : public IceUtil::Shared, public IceUtil::Mutex
 {
 public:
@@ -41,9 +57,16 @@ public:
     //
     LocatorInfoPtr get(const Ice::LocatorPrxPtr&);
 
+    //
+    // Returns the statistics of the locator tables.
+    //
+    std::vector<LocatorTableStats> getStats();
+
 private:
 
     const bool _background;
+    const int _refreshThreshold;
+    const size_t _cacheSize;
 
 #ifdef ICE_CPP11_MAPPING
     using LocatorInfoTable = std::map<std::shared_ptr<Ice::LocatorPrx>,
@@ -62,24 +85,62 @@ class LocatorTable : public IceUtil::Shared, public IceUtil::Mutex
 {
 public:
 
-    LocatorTable();
+    LocatorTable(int, size_t);
 
     void clear();
 
-    bool getAdapterEndpoints(const std::string&, int, ::std::vector<EndpointIPtr>&);
+    //
+    // The get methods return true if the cached entry is still valid,
+    // in which case the refresh parameter is set to true if the entry
+    // should be refreshed in the background before it expires.
+    //
+    bool getAdapterEndpoints(const std::string&, int, ::std::vector<EndpointIPtr>&, bool&);
     void addAdapterEndpoints(const std::string&, const ::std::vector<EndpointIPtr>&);
     ::std::vector<EndpointIPtr> removeAdapterEndpoints(const std::string&);
 
-    bool getObjectReference(const Ice::Identity&, int, ReferencePtr&);
+    bool getObjectReference(const Ice::Identity&, int, ReferencePtr&, bool&);
     void addObjectReference(const Ice::Identity&, const ReferencePtr&);
     ReferencePtr removeObjectReference(const Ice::Identity&);
 
+    LocatorTableStats getStats();
+
 private:
 
-    bool checkTTL(const IceUtil::Time&, int) const;
+    bool checkTTL(const IceUtil::Time&, int, bool&) const;
+
+    struct AdapterEntry
+    {
+        IceUtil::Time time;
+        std::vector<EndpointIPtr> endpoints;
+        bool refreshing;
+        std::list<std::string>::iterator lru;
+    };
+
+    struct ObjectEntry
+    {
+        IceUtil::Time time;
+        ReferencePtr reference;
+        bool refreshing;
+        std::list<Ice::Identity>::iterator lru;
+    };
+
+    const int _refreshThreshold; // Percentage of the TTL after which entries are refreshed, 0 if disabled.
+    const size_t _maxSize; // Maximum number of adapter and of object entries, 0 if unbounded.
 
-    std::map<std::string, std::pair<IceUtil::Time, std::vector<EndpointIPtr> > > _adapterEndpointsMap;
-    std::map<Ice::Identity, std::pair<IceUtil::Time, ReferencePtr> > _objectMap;
+    //
+    // The entries are kept in least recently used order in the lists,
+    // the least recently used entries are evicted first.
+    //
+    std::map<std::string, AdapterEntry> _adapterEndpointsMap;
+    std::list<std::string> _adapterLRU;
+    std::map<Ice::Identity, ObjectEntry> _objectMap;
+    std::list<Ice::Identity> _objectLRU;
+
+    Ice::Long _added;
+    Ice::Long _hits;
+    Ice::Long _misses;
+    Ice::Long _refreshes;
+    Ice::Long _evictions;
 };
 
 class LocatorInfo : public IceUtil::Shared, public IceUtil::Mutex
@@ -18,6 +18,7 @@
 #include <Ice/LoggerUtil.h>
 
 #include <set>
+#include <deque>
 
 using namespace Ice;
 using namespace std;
@@ -19,6 +19,16 @@ endif
 
 Ice_sliceflags		:= --include-dir Ice
 Ice_libs		:= bz2
+
+ifeq ($(LZ4),yes)
+    Ice_cppflags        += -DICE_HAS_LZ4
+    Ice_libs            += lz4
+endif
+
+ifeq ($(ZSTD),yes)
+    Ice_cppflags        += -DICE_HAS_ZSTD
+    Ice_libs            += zstd
+endif
 Ice_extra_sources       := $(wildcard src/IceUtil/*.cpp)
 Ice_excludes		= src/Ice/DLLMain.cpp
 
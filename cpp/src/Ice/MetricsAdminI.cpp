@@ -230,8 +230,10 @@ MetricsMapFactory::MetricsMapFactory(Updater* updater) : _updater(updater)
 void
 MetricsMapFactory::update()
 {
-    assert(_updater);
-    _updater->update();
+    if(_updater)
+    {
+        _updater->update();
+    }
 }
 
 MetricsViewI::MetricsViewI(const string& name) : _name(name)
@@ -676,6 +678,21 @@ MetricsAdminI::updated(const PropertyDict& props)
     }
 }
 
+void
+MetricsAdminI::registerMap(const std::string& map, const MetricsMapFactoryPtr& factory)
+{
+    bool updated;
+    {
+        Lock sync(*this);
+        _factories[map] = factory;
+        updated = addOrUpdateMap(map, factory);
+    }
+    if(updated)
+    {
+        factory->update();
+    }
+}
+
 bool
 MetricsAdminI::addOrUpdateMap(const std::string& mapName, const MetricsMapFactoryPtr& factory)
 {
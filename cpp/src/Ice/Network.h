@@ -263,6 +263,9 @@ ICE_API bool noMoreFds(int);
 ICE_API std::string errorToStringDNS(int);
 ICE_API std::vector<Address> getAddresses(const std::string&, int, ProtocolSupport, Ice::EndpointSelectionType, bool,
                                           bool);
+#ifndef ICE_OS_UWP
+ICE_API void sortAddresses(std::vector<Address>&, ProtocolSupport, Ice::EndpointSelectionType, bool);
+#endif
 ICE_API ProtocolSupport getProtocolSupport(const Address&);
 ICE_API Address getAddressForServer(const std::string&, int, ProtocolSupport, bool);
 ICE_API int compareAddress(const Address&, const Address&);
@@ -53,14 +53,6 @@ const string object_ids[] =
     "::Ice::Object"
 };
 
-const string object_all[] =
-{
-    "ice_id",
-    "ice_ids",
-    "ice_isA",
-    "ice_ping"
-};
-
 }
 
 #ifndef ICE_CPP11_MAPPING
@@ -210,37 +202,38 @@ Ice::Object::ice_dispatch(Request& request, const DispatchInterceptorAsyncCallba
 bool
 Ice::Object::_iceDispatch(Incoming& in, const Current& current)
 {
-    pair<const string*, const string*> r = equal_range(object_all, object_all + sizeof(object_all) / sizeof(string), current.operation);
-
-    if(r.first == r.second)
+    switch(current.operation.size())
     {
-        throw OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);
-    }
-
-    switch(r.first - object_all)
-    {
-        case 0:
-        {
-            return _iceD_ice_id(in, current);
-        }
-        case 1:
-        {
-            return _iceD_ice_ids(in, current);
-        }
-        case 2:
+        case 6:
         {
-            return _iceD_ice_isA(in, current);
+            if(current.operation == "ice_id")
+            {
+                return _iceD_ice_id(in, current);
+            }
+            break;
         }
-        case 3:
+        case 7:
         {
-            return _iceD_ice_ping(in, current);
+            if(current.operation == "ice_ids")
+            {
+                return _iceD_ice_ids(in, current);
+            }
+            if(current.operation == "ice_isA")
+            {
+                return _iceD_ice_isA(in, current);
+            }
+            break;
         }
-        default:
+        case 8:
         {
-            assert(false);
-            throw OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);
+            if(current.operation == "ice_ping")
+            {
+                return _iceD_ice_ping(in, current);
+            }
+            break;
         }
     }
+    throw OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);
 }
 
 #ifndef ICE_CPP11_MAPPING
@@ -859,6 +859,76 @@ Ice::ObjectAdapterI::decDirectCount()
     }
 }
 
+void
+Ice::ObjectAdapterI::queueDispatch(const ThreadPoolPtr& threadPool, int count)
+{
+    if(!hasDispatchLimits())
+    {
+        return;
+    }
+
+    //
+    // Requests are rejected as soon as they are read if the thread pool
+    // can't keep up with its target latency.
+    //
+    if(threadPool->overloaded())
+    {
+        DispatchRejectedException ex(__FILE__, __LINE__);
+        ex.reason = "thread pool `" + threadPool->prefix() + "' is overloaded";
+        throw ex;
+    }
+
+    if(_maxQueuedDispatch > 0)
+    {
+        IceUtil::Mutex::Lock sync(_dispatchMutex);
+        if(_queuedDispatch + count > _maxQueuedDispatch)
+        {
+            DispatchRejectedException ex(__FILE__, __LINE__);
+            ex.reason = "object adapter `" + _name + "' reached its queued dispatch limit";
+            throw ex;
+        }
+        _queuedDispatch += count;
+    }
+}
+
+void
+Ice::ObjectAdapterI::dequeueDispatch(int count)
+{
+    if(_maxQueuedDispatch > 0)
+    {
+        IceUtil::Mutex::Lock sync(_dispatchMutex);
+        assert(_queuedDispatch >= count);
+        _queuedDispatch -= count;
+    }
+}
+
+bool
+Ice::ObjectAdapterI::startDispatch()
+{
+    if(_maxConcurrentDispatch == 0)
+    {
+        return false;
+    }
+
+    IceUtil::Mutex::Lock sync(_dispatchMutex);
+    if(_concurrentDispatch == _maxConcurrentDispatch)
+    {
+        DispatchRejectedException ex(__FILE__, __LINE__);
+        ex.reason = "object adapter `" + _name + "' reached its concurrent dispatch limit";
+        throw ex;
+    }
+    ++_concurrentDispatch;
+    return true;
+}
+
+void
+Ice::ObjectAdapterI::finishDispatch()
+{
+    IceUtil::Mutex::Lock sync(_dispatchMutex);
+    assert(_concurrentDispatch > 0);
+    --_concurrentDispatch;
+}
+
 ThreadPoolPtr
 Ice::ObjectAdapterI::getThreadPool() const
 {
@@ -914,7 +984,11 @@ Ice::ObjectAdapterI::ObjectAdapterI(const InstancePtr& instance, const Communica
     _name(name),
     _directCount(0),
     _noConfig(noConfig),
-    _messageSizeMax(0)
+    _messageSizeMax(0),
+    _maxConcurrentDispatch(0),
+    _maxQueuedDispatch(0),
+    _concurrentDispatch(0),
+    _queuedDispatch(0)
 {
 }
 
@@ -992,6 +1066,9 @@ Ice::ObjectAdapterI::initialize(const RouterPrxPtr& router)
             }
         }
 
+        const_cast<int&>(_maxConcurrentDispatch) = max(0, properties->getPropertyAsInt(_name + ".MaxConcurrentDispatch"));
+        const_cast<int&>(_maxQueuedDispatch) = max(0, properties->getPropertyAsInt(_name + ".MaxQueuedDispatch"));
+
         int threadPoolSize = properties->getPropertyAsInt(_name + ".ThreadPool.Size");
         int threadPoolSizeMax = properties->getPropertyAsInt(_name + ".ThreadPool.SizeMax");
         bool hasPriority = properties->getProperty(_name + ".ThreadPool.ThreadPriority") != "";
@@ -1411,6 +1488,8 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "ACM.Heartbeat",
         "ACM.Timeout",
         "AdapterId",
+        "Cork.Delay",
+        "Cork.MaxBytes",
         "Endpoints",
         "Locator",
         "Locator.EncodingVersion",
@@ -1419,6 +1498,8 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "Locator.PreferSecure",
         "Locator.CollocationOptimized",
         "Locator.Router",
+        "MaxConcurrentDispatch",
+        "MaxQueuedDispatch",
         "MessageSizeMax",
         "PublishedEndpoints",
         "ReplicaGroupId",
@@ -1443,6 +1524,7 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "ThreadPool.SizeWarn",
         "ThreadPool.StackSize",
         "ThreadPool.Serialize",
+        "ThreadPool.TargetLatency",
         "ThreadPool.ThreadPriority"
     };
 
@@ -12,6 +12,7 @@
 
 #include <IceUtil/Shared.h>
 #include <IceUtil/RecMutex.h>
+#include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
 #include <Ice/ObjectAdapter.h>
 #include <Ice/InstanceF.h>
@@ -105,6 +106,22 @@ public:
     IceInternal::ACMConfig getACM() const;
     size_t messageSizeMax() const { return _messageSizeMax; }
 
+    //
+    // Dispatch admission control. The requests read from connections are
+    // queued until their dispatch returns and are dispatching from the
+    // start of their dispatch until their response is sent. The thread
+    // pool overload is only checked if the adapter has dispatch limits.
+    // queueDispatch and startDispatch raise
+    // DispatchRejectedException if the requests exceed the limits of the
+    // adapter. startDispatch returns true if the dispatch is counted, in
+    // which case finishDispatch must be called once it completes.
+    //
+    bool hasDispatchLimits() const { return _maxConcurrentDispatch > 0 || _maxQueuedDispatch > 0; }
+    void queueDispatch(const IceInternal::ThreadPoolPtr&, int);
+    void dequeueDispatch(int);
+    bool startDispatch();
+    void finishDispatch();
+
     ObjectAdapterI(const IceInternal::InstancePtr&, const CommunicatorPtr&,
                    const IceInternal::ObjectAdapterFactoryPtr&, const std::string&, bool);
     virtual ~ObjectAdapterI();
@@ -153,6 +170,12 @@ private:
     int _directCount; // The number of direct proxies dispatching on this object adapter.
     bool _noConfig;
     size_t _messageSizeMax;
+
+    const int _maxConcurrentDispatch; // The maximum number of concurrent dispatches, 0 if unlimited.
+    const int _maxQueuedDispatch; // The maximum number of queued requests, 0 if unlimited.
+    IceUtil::Mutex _dispatchMutex;
+    int _concurrentDispatch;
+    int _queuedDispatch;
 };
 
 }
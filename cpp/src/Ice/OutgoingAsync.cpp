@@ -25,6 +25,23 @@ using namespace std;
 using namespace Ice;
 using namespace IceInternal;
 
+namespace
+{
+
+//
+// Byte sequences of synchronous invocations larger than this size are
+// not copied to the request stream, see OutgoingAsync::prepare.
+//
+const Buffer::Container::size_type segmentThreshold = 64 * 1024;
+
+//
+// Shared encapsulations smaller than this size are copied to the request
+// stream, see OutgoingAsync::writeParamEncaps.
+//
+const Ice::Int sharedEncapsThreshold = 1024;
+
+}
+
 #ifndef ICE_CPP11_MAPPING
 IceUtil::Shared* IceInternal::upCast(OutgoingAsyncBase* p) { return p; }
 IceUtil::Shared* IceInternal::upCast(ProxyOutgoingAsyncBase* p) { return p; }
@@ -873,6 +890,18 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
         case Reference::ModeDatagram:
         {
             _os.writeBlob(requestHdr, sizeof(requestHdr));
+
+            //
+            // The caller of a synchronous invocation is blocked until the
+            // invocation completes so the request stream can reference the
+            // memory of large byte sequence parameters instead of copying it.
+            // The connection copies it if the request needs to outlive the
+            // invocation (e.g.: if it's canceled while being sent).
+            //
+            if(_synchronous)
+            {
+                _os.setSegmentThreshold(segmentThreshold);
+            }
             break;
         }
 
@@ -930,6 +959,24 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
     }
 }
 
+void
+OutgoingAsync::writeParamEncaps(const Byte* encaps, Int size, const IceUtil::Handle<IceUtil::Shared>& owner)
+{
+    //
+    // Batch requests are copied to the batch stream so the encapsulation
+    // is only referenced for regular requests.
+    //
+    const Reference::Mode mode = _proxy->_getReference()->getMode();
+    if(size < sharedEncapsThreshold || mode == Reference::ModeBatchOneway || mode == Reference::ModeBatchDatagram)
+    {
+        writeParamEncaps(encaps, size);
+    }
+    else
+    {
+        _os.writeEncapsulation(encaps, size, owner);
+    }
+}
+
 bool
 OutgoingAsync::sent()
 {
@@ -1035,6 +1082,22 @@ OutgoingAsync::response()
                 string unknown;
                 _is.read(unknown, false);
 
+                //
+                // Rejected dispatches are sent as unknown local exceptions
+                // for compatibility with older clients, followed by a marker
+                // which is only written by the server admission control. A
+                // DispatchRejectedException raised by a servant isn't marked.
+                //
+                if(replyStatus == replyUnknownLocalException && _is.i != _is.b.end())
+                {
+                    Byte marker;
+                    _is.read(marker);
+                    if(marker == replyDispatchRejectedMarker)
+                    {
+                        throw DispatchRejectedException(__FILE__, __LINE__, unknown);
+                    }
+                }
+
                 IceUtil::UniquePtr<UnknownException> ex;
                 switch(replyStatus)
                 {
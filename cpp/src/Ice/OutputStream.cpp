@@ -77,12 +77,14 @@ Ice::OutputStream::OutputStream() :
     _closure(0),
     _encoding(currentEncoding),
     _format(CompactFormat),
+    _segmentThreshold(0),
     _currentEncaps(0)
 {
 }
 
 Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator) :
     _closure(0),
+    _segmentThreshold(0),
     _currentEncaps(0)
 {
     initialize(communicator);
@@ -90,6 +92,7 @@ Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator) :
 
 Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator, const EncodingVersion& encoding) :
     _closure(0),
+    _segmentThreshold(0),
     _currentEncaps(0)
 {
     initialize(communicator, encoding);
@@ -99,6 +102,7 @@ Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator, const Encod
                                 const pair<const Byte*, const Byte*>& buf) :
     Buffer(buf.first, buf.second),
     _closure(0),
+    _segmentThreshold(0),
     _currentEncaps(0)
 {
     initialize(communicator, encoding);
@@ -107,6 +111,7 @@ Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator, const Encod
 
 Ice::OutputStream::OutputStream(Instance* instance, const EncodingVersion& encoding) :
     _closure(0),
+    _segmentThreshold(0),
     _currentEncaps(0)
 {
     initialize(instance, encoding);
@@ -155,6 +160,34 @@ Ice::OutputStream::setFormat(FormatType fmt)
     _format = fmt;
 }
 
+void
+Ice::OutputStream::setSegmentThreshold(Container::size_type threshold)
+{
+    _segmentThreshold = threshold;
+}
+
+void
+Ice::OutputStream::writeEncapsulation(const Byte* v, Int sz, const IceUtil::Handle<IceUtil::Shared>& owner)
+{
+    if(sz < 6)
+    {
+        throwEncapsulationException(__FILE__, __LINE__);
+    }
+
+    //
+    // The encapsulation header is copied, it's read when the request is
+    // traced.
+    //
+    Container::size_type position = b.size();
+    resize(position + sz);
+    memcpy(&b[position], &v[0], 6);
+    if(sz > 6)
+    {
+        Segment segment = { position + 6, v + 6, static_cast<Container::size_type>(sz - 6), owner };
+        segments.push_back(segment);
+    }
+}
+
 void*
 Ice::OutputStream::getClosure() const
 {
@@ -178,6 +211,7 @@ Ice::OutputStream::swap(OutputStream& other)
     std::swap(_closure, other._closure);
     std::swap(_encoding, other._encoding);
     std::swap(_format, other._format);
+    std::swap(_segmentThreshold, other._segmentThreshold);
 
     //
     // Swap is never called for streams that have encapsulations being written. However,
@@ -262,7 +296,15 @@ Ice::OutputStream::write(const Byte* begin, const Byte* end)
     {
         Container::size_type pos = b.size();
         resize(pos + sz);
-        memcpy(&b[pos], begin, sz);
+        if(_segmentThreshold > 0 && static_cast<Container::size_type>(sz) >= _segmentThreshold)
+        {
+            Segment segment = { pos, begin, static_cast<Container::size_type>(sz), 0 };
+            segments.push_back(segment);
+        }
+        else
+        {
+            memcpy(&b[pos], begin, sz);
+        }
     }
 }
 
@@ -866,12 +908,14 @@ Ice::OutputStream::writeOptImpl(Int tag, OptionalFormat type)
 void
 Ice::OutputStream::finished(vector<Byte>& bytes)
 {
+    copySegments();
     vector<Byte>(b.begin(), b.end()).swap(bytes);
 }
 
 pair<const Byte*, const Byte*>
 Ice::OutputStream::finished()
 {
+    copySegments();
     if(b.empty())
     {
         return pair<const Byte*, const Byte*>(reinterpret_cast<Ice::Byte*>(0), reinterpret_cast<Ice::Byte*>(0));
@@ -6,7 +6,7 @@
 // ICE_LICENSE file included in this distribution.
 //
 // **********************************************************************
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Wed Nov 16 09:52:45 2016
+// Generated by makeprops.py from file config/PropertyNames.xml, Sun Oct 18 08:43:44 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -33,6 +33,8 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ACM.Close", false, 0),
     IceInternal::Property("Ice.Admin.ACM", false, 0),
     IceInternal::Property("Ice.Admin.AdapterId", false, 0),
+    IceInternal::Property("Ice.Admin.Cork.Delay", false, 0),
+    IceInternal::Property("Ice.Admin.Cork.MaxBytes", false, 0),
     IceInternal::Property("Ice.Admin.Endpoints", false, 0),
     IceInternal::Property("Ice.Admin.Locator.EndpointSelection", false, 0),
     IceInternal::Property("Ice.Admin.Locator.ConnectionCached", false, 0),
@@ -44,6 +46,8 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("Ice.Admin.Locator.Context.*", false, 0),
     IceInternal::Property("Ice.Admin.Locator", false, 0),
+    IceInternal::Property("Ice.Admin.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("Ice.Admin.MaxQueuedDispatch", false, 0),
     IceInternal::Property("Ice.Admin.PublishedEndpoints", false, 0),
     IceInternal::Property("Ice.Admin.ReplicaGroupId", false, 0),
     IceInternal::Property("Ice.Admin.Router.EndpointSelection", false, 0),
@@ -62,6 +66,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.StackSize", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.Shards", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Ice.Admin.MessageSizeMax", false, 0),
@@ -78,11 +85,15 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.BatchAutoFlushSize", false, 0),
     IceInternal::Property("Ice.ChangeUser", false, 0),
     IceInternal::Property("Ice.ClientAccessPolicyProtocol", false, 0),
+    IceInternal::Property("Ice.Compression.Codec", false, 0),
     IceInternal::Property("Ice.Compression.Level", false, 0),
     IceInternal::Property("Ice.CollectObjects", false, 0),
     IceInternal::Property("Ice.Config", false, 0),
     IceInternal::Property("Ice.ConsoleListener", false, 0),
+    IceInternal::Property("Ice.Cork.Delay", false, 0),
+    IceInternal::Property("Ice.Cork.MaxBytes", false, 0),
     IceInternal::Property("Ice.Default.CollocationOptimized", false, 0),
+    IceInternal::Property("Ice.Default.ConnectionPoolSize", false, 0),
     IceInternal::Property("Ice.Default.EncodingVersion", false, 0),
     IceInternal::Property("Ice.Default.EndpointSelection", false, 0),
     IceInternal::Property("Ice.Default.Host", false, 0),
@@ -99,6 +110,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Default.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Ice.Default.InvocationTimeout", false, 0),
     IceInternal::Property("Ice.Default.Package", false, 0),
+    IceInternal::Property("Ice.Default.ParallelConnect", false, 0),
     IceInternal::Property("Ice.Default.PreferSecure", false, 0),
     IceInternal::Property("Ice.Default.Protocol", false, 0),
     IceInternal::Property("Ice.Default.Router.EndpointSelection", false, 0),
@@ -118,10 +130,15 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.FactoryAssemblies", false, 0),
     IceInternal::Property("Ice.HTTPProxyHost", false, 0),
     IceInternal::Property("Ice.HTTPProxyPort", false, 0),
+    IceInternal::Property("Ice.HostResolver.CacheTimeout", false, 0),
+    IceInternal::Property("Ice.HostResolver.NegativeCacheTimeout", false, 0),
+    IceInternal::Property("Ice.HostResolver.Size", false, 0),
     IceInternal::Property("Ice.ImplicitContext", false, 0),
     IceInternal::Property("Ice.InitPlugins", false, 0),
     IceInternal::Property("Ice.IPv4", false, 0),
     IceInternal::Property("Ice.IPv6", false, 0),
+    IceInternal::Property("Ice.LocatorCacheRefreshThreshold", false, 0),
+    IceInternal::Property("Ice.LocatorCacheSize", false, 0),
     IceInternal::Property("Ice.LogFile", false, 0),
     IceInternal::Property("Ice.LogFile.SizeMax", false, 0),
     IceInternal::Property("Ice.LogStdErr.Convert", false, 0),
@@ -153,6 +170,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Client.SizeWarn", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.StackSize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.Serialize", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.ShardAffinity", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.Shards", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.TargetLatency", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadPriority", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Size", false, 0),
@@ -160,6 +180,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Server.SizeWarn", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.StackSize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Serialize", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.ShardAffinity", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.Shards", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.TargetLatency", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadPriority", false, 0),
     IceInternal::Property("Ice.ThreadPriority", false, 0),
@@ -216,6 +239,8 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.ACM.Close", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ACM", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.AdapterId", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Cork.Delay", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Endpoints", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.ConnectionCached", false, 0),
@@ -227,6 +252,8 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.Context.*", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.PublishedEndpoints", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ReplicaGroupId", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.EndpointSelection", false, 0),
@@ -245,6 +272,9 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.MessageSizeMax", false, 0),
@@ -253,6 +283,8 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.ACM.Close", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM", false, 0),
     IceInternal::Property("IceDiscovery.Reply.AdapterId", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Cork.Delay", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Endpoints", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.ConnectionCached", false, 0),
@@ -264,6 +296,8 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.Context.*", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceDiscovery.Reply.PublishedEndpoints", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ReplicaGroupId", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.EndpointSelection", false, 0),
@@ -282,6 +316,9 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceDiscovery.Reply.MessageSizeMax", false, 0),
@@ -290,6 +327,8 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.ACM.Close", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM", false, 0),
     IceInternal::Property("IceDiscovery.Locator.AdapterId", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Cork.Delay", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Endpoints", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.ConnectionCached", false, 0),
@@ -301,6 +340,8 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.Context.*", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceDiscovery.Locator.PublishedEndpoints", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ReplicaGroupId", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.EndpointSelection", false, 0),
@@ -319,6 +360,9 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceDiscovery.Locator.MessageSizeMax", false, 0),
@@ -343,6 +387,8 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.ACM.Close", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ACM", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.AdapterId", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Cork.Delay", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Endpoints", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.ConnectionCached", false, 0),
@@ -354,6 +400,8 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.Context.*", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.PublishedEndpoints", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ReplicaGroupId", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.EndpointSelection", false, 0),
@@ -372,6 +420,9 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.MessageSizeMax", false, 0),
@@ -380,6 +431,8 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.ACM.Close", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ACM", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.AdapterId", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Cork.Delay", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Endpoints", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.ConnectionCached", false, 0),
@@ -391,6 +444,8 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.Context.*", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.PublishedEndpoints", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ReplicaGroupId", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.EndpointSelection", false, 0),
@@ -409,6 +464,9 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.MessageSizeMax", false, 0),
@@ -487,6 +545,8 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ACM.Close", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ACM", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.AdapterId", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Cork.Delay", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Endpoints", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.ConnectionCached", false, 0),
@@ -498,6 +558,8 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.Context.*", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.PublishedEndpoints", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.EndpointSelection", false, 0),
@@ -516,6 +578,9 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.MessageSizeMax", false, 0),
@@ -534,6 +599,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.ACM.Close", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ACM", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.AdapterId", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Cork.Delay", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Endpoints", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.ConnectionCached", false, 0),
@@ -545,6 +612,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.Context.*", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.PublishedEndpoints", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.EndpointSelection", false, 0),
@@ -563,6 +632,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.MessageSizeMax", false, 0),
@@ -572,6 +644,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.ACM.Close", false, 0),
     IceInternal::Property("IceGrid.Node.ACM", false, 0),
     IceInternal::Property("IceGrid.Node.AdapterId", false, 0),
+    IceInternal::Property("IceGrid.Node.Cork.Delay", false, 0),
+    IceInternal::Property("IceGrid.Node.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceGrid.Node.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.ConnectionCached", false, 0),
@@ -583,6 +657,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.Context.*", false, 0),
     IceInternal::Property("IceGrid.Node.Locator", false, 0),
+    IceInternal::Property("IceGrid.Node.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceGrid.Node.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceGrid.Node.PublishedEndpoints", false, 0),
     IceInternal::Property("IceGrid.Node.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Node.Router.EndpointSelection", false, 0),
@@ -601,6 +677,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Node.MessageSizeMax", false, 0),
@@ -649,6 +728,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ACM.Close", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ACM", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.AdapterId", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Cork.Delay", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.ConnectionCached", false, 0),
@@ -660,6 +741,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.PublishedEndpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.EndpointSelection", false, 0),
@@ -678,6 +761,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.MessageSizeMax", false, 0),
@@ -696,6 +782,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.ACM.Close", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ACM", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.AdapterId", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Cork.Delay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.ConnectionCached", false, 0),
@@ -707,6 +795,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.PublishedEndpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.EndpointSelection", false, 0),
@@ -725,6 +815,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.MessageSizeMax", false, 0),
@@ -735,6 +828,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.ACM.Close", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ACM", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.AdapterId", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Cork.Delay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.ConnectionCached", false, 0),
@@ -746,6 +841,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.PublishedEndpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.EndpointSelection", false, 0),
@@ -764,6 +861,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.MessageSizeMax", false, 0),
@@ -777,6 +877,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.ACM.Close", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ACM", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.AdapterId", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Cork.Delay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.ConnectionCached", false, 0),
@@ -788,6 +890,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.PublishedEndpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.EndpointSelection", false, 0),
@@ -806,6 +910,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.MessageSizeMax", false, 0),
@@ -831,6 +938,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.ACM.Close", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ACM", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.AdapterId", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Cork.Delay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.ConnectionCached", false, 0),
@@ -842,6 +951,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.PublishedEndpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.EndpointSelection", false, 0),
@@ -860,6 +971,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.MessageSizeMax", false, 0),
@@ -869,6 +983,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.ACM.Close", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ACM", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.AdapterId", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Cork.Delay", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Cork.MaxBytes", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.ConnectionCached", false, 0),
@@ -880,6 +996,8 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.Context.*", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.PublishedEndpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.EndpointSelection", false, 0),
@@ -898,6 +1016,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.MessageSizeMax", false, 0),
@@ -938,6 +1059,8 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.ACM.Close", false, 0),
     IceInternal::Property("IcePatch2.ACM", false, 0),
     IceInternal::Property("IcePatch2.AdapterId", false, 0),
+    IceInternal::Property("IcePatch2.Cork.Delay", false, 0),
+    IceInternal::Property("IcePatch2.Cork.MaxBytes", false, 0),
     IceInternal::Property("IcePatch2.Endpoints", false, 0),
     IceInternal::Property("IcePatch2.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IcePatch2.Locator.ConnectionCached", false, 0),
@@ -949,6 +1072,8 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("IcePatch2.Locator.Context.*", false, 0),
     IceInternal::Property("IcePatch2.Locator", false, 0),
+    IceInternal::Property("IcePatch2.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("IcePatch2.MaxQueuedDispatch", false, 0),
     IceInternal::Property("IcePatch2.PublishedEndpoints", false, 0),
     IceInternal::Property("IcePatch2.ReplicaGroupId", false, 0),
     IceInternal::Property("IcePatch2.Router.EndpointSelection", false, 0),
@@ -967,6 +1092,9 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IcePatch2.MessageSizeMax", false, 0),
@@ -1070,6 +1198,8 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.ACM.Close", false, 0),
     IceInternal::Property("Glacier2.Client.ACM", false, 0),
     IceInternal::Property("Glacier2.Client.AdapterId", false, 0),
+    IceInternal::Property("Glacier2.Client.Cork.Delay", false, 0),
+    IceInternal::Property("Glacier2.Client.Cork.MaxBytes", false, 0),
     IceInternal::Property("Glacier2.Client.Endpoints", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.EndpointSelection", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.ConnectionCached", false, 0),
@@ -1081,6 +1211,8 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.Context.*", false, 0),
     IceInternal::Property("Glacier2.Client.Locator", false, 0),
+    IceInternal::Property("Glacier2.Client.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("Glacier2.Client.MaxQueuedDispatch", false, 0),
     IceInternal::Property("Glacier2.Client.PublishedEndpoints", false, 0),
     IceInternal::Property("Glacier2.Client.ReplicaGroupId", false, 0),
     IceInternal::Property("Glacier2.Client.Router.EndpointSelection", false, 0),
@@ -1099,6 +1231,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.StackSize", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.Shards", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Glacier2.Client.MessageSizeMax", false, 0),
@@ -1145,6 +1280,8 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.ACM.Close", false, 0),
     IceInternal::Property("Glacier2.Server.ACM", false, 0),
     IceInternal::Property("Glacier2.Server.AdapterId", false, 0),
+    IceInternal::Property("Glacier2.Server.Cork.Delay", false, 0),
+    IceInternal::Property("Glacier2.Server.Cork.MaxBytes", false, 0),
     IceInternal::Property("Glacier2.Server.Endpoints", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.EndpointSelection", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.ConnectionCached", false, 0),
@@ -1156,6 +1293,8 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.Locator.CollocationOptimized", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.Context.*", false, 0),
     IceInternal::Property("Glacier2.Server.Locator", false, 0),
+    IceInternal::Property("Glacier2.Server.MaxConcurrentDispatch", false, 0),
+    IceInternal::Property("Glacier2.Server.MaxQueuedDispatch", false, 0),
     IceInternal::Property("Glacier2.Server.PublishedEndpoints", false, 0),
     IceInternal::Property("Glacier2.Server.ReplicaGroupId", false, 0),
     IceInternal::Property("Glacier2.Server.Router.EndpointSelection", false, 0),
@@ -1174,6 +1313,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.StackSize", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.ShardAffinity", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.Shards", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.TargetLatency", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Glacier2.Server.MessageSizeMax", false, 0),
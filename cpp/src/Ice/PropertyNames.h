@@ -6,7 +6,7 @@
 // ICE_LICENSE file included in this distribution.
 //
 // **********************************************************************
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Wed Nov 16 09:52:45 2016
+// Generated by makeprops.py from file config/PropertyNames.xml, Sun Oct 18 08:43:44 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
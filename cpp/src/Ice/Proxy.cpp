@@ -1189,6 +1189,9 @@ ICE_OBJECT_PRX::_handleException(const Exception& ex,
     // "at-most-once" (see the implementation of the checkRetryAfterException method
     //  of the ProxyFactory class for the reasons why it can be useful).
     //
+    // A DispatchRejectedException indicates that the server didn't dispatch the
+    // request, it can also always be retried.
+    //
     // If the request didn't get sent or if it's non-mutating or idempotent it can
     // also always be retried if the retry count isn't reached.
     //
@@ -1196,7 +1199,8 @@ ICE_OBJECT_PRX::_handleException(const Exception& ex,
     if(localEx && (!sent ||
                    mode == ICE_ENUM(OperationMode, Nonmutating) || mode == ICE_ENUM(OperationMode, Idempotent) ||
                    dynamic_cast<const CloseConnectionException*>(&ex) ||
-                   dynamic_cast<const ObjectNotExistException*>(&ex)))
+                   dynamic_cast<const ObjectNotExistException*>(&ex) ||
+                   dynamic_cast<const DispatchRejectedException*>(&ex)))
     {
         try
         {
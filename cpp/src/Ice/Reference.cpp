@@ -31,7 +31,6 @@
 #include <Ice/StringUtil.h>
 
 #include <IceUtil/Random.h>
-#include <IceUtil/MutexPtrLock.h>
 
 #include <functional>
 #include <algorithm>
@@ -45,26 +44,6 @@ IceUtil::Shared* IceInternal::upCast(IceInternal::Reference* p) { return p; }
 namespace
 {
 
-IceUtil::Mutex* hashMutex = 0;
-
-class Init
-{
-public:
-
-    Init()
-    {
-        hashMutex = new IceUtil::Mutex;
-    }
-
-    ~Init()
-    {
-        delete hashMutex;
-        hashMutex = 0;
-    }
-};
-
-Init init;
-
 struct RandomNumberGenerator : public std::unary_function<ptrdiff_t, ptrdiff_t>
 {
     ptrdiff_t operator()(ptrdiff_t d)
@@ -84,6 +63,10 @@ IceInternal::Reference::getCommunicator() const
 ReferencePtr
 IceInternal::Reference::changeContext(const Context& newContext) const
 {
+    if(newContext == _context->getValue())
+    {
+        return ReferencePtr(const_cast<Reference*>(this));
+    }
     ReferencePtr r = _instance->referenceFactory()->copy(this);
     r->_context = new SharedContext(newContext);
     return r;
@@ -177,13 +160,12 @@ IceInternal::Reference::changeCompress(bool newCompress) const
 Int
 Reference::hash() const
 {
-    IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(hashMutex);
-    if(!_hashInitialized)
+    if(!_hashInitialized.load())
     {
-        _hashValue = hashInit();
-        _hashInitialized = true;
+        _hashValue.exchange(hashInit());
+        _hashInitialized.exchange(1);
     }
-    return _hashValue;
+    return _hashValue.load();
 }
 
 void
@@ -520,7 +502,8 @@ IceInternal::Reference::Reference(const InstancePtr& instance,
                                   const EncodingVersion& encoding,
                                   int invocationTimeout,
                                   const Ice::Context& ctx) :
-    _hashInitialized(false),
+    _hashValue(0),
+    _hashInitialized(0),
     _instance(instance),
     _communicator(communicator),
     _mode(mode),
@@ -537,7 +520,8 @@ IceInternal::Reference::Reference(const InstancePtr& instance,
 }
 
 IceInternal::Reference::Reference(const Reference& r) :
-    _hashInitialized(false),
+    _hashValue(0),
+    _hashInitialized(0),
     _instance(r._instance),
     _communicator(r._communicator),
     _mode(r._mode),
@@ -898,7 +882,7 @@ IceInternal::RoutableReference::RoutableReference(const InstancePtr& instance,
                                                   int invocationTimeout,
                                                   const Ice::Context& ctx) :
     Reference(instance, communicator, id, facet, mode, secure, protocol, encoding, invocationTimeout, ctx),
-    _endpoints(endpoints),
+    _endpoints(new SharedEndpoints(endpoints)),
     _adapterId(adapterId),
     _locatorInfo(locatorInfo),
     _routerInfo(routerInfo),
@@ -910,13 +894,13 @@ IceInternal::RoutableReference::RoutableReference(const InstancePtr& instance,
     _overrideTimeout(false),
     _timeout(-1)
 {
-    assert(_adapterId.empty() || _endpoints.empty());
+    assert(_adapterId.empty() || _endpoints->getValue().empty());
 }
 
 vector<EndpointIPtr>
 IceInternal::RoutableReference::getEndpoints() const
 {
-    return _endpoints;
+    return _endpoints->getValue();
 }
 
 string
@@ -993,14 +977,15 @@ IceInternal::RoutableReference::changeCompress(bool newCompress) const
 {
     ReferencePtr r = Reference::changeCompress(newCompress);
     // Also override the compress flag on the endpoints if it was updated.
-    if(r.get() != const_cast<RoutableReference*>(this) && !_endpoints.empty())
+    const vector<EndpointIPtr>& endpoints = _endpoints->getValue();
+    if(r.get() != const_cast<RoutableReference*>(this) && !endpoints.empty())
     {
         vector<EndpointIPtr> newEndpoints;
-        for(vector<EndpointIPtr>::const_iterator p = _endpoints.begin(); p != _endpoints.end(); ++p)
+        for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
         {
             newEndpoints.push_back((*p)->compress(newCompress));
         }
-        RoutableReferencePtr::dynamicCast(r)->_endpoints = newEndpoints;
+        RoutableReferencePtr::dynamicCast(r)->_endpoints = new SharedEndpoints(newEndpoints);
     }
     return r;
 }
@@ -1008,13 +993,14 @@ IceInternal::RoutableReference::changeCompress(bool newCompress) const
 ReferencePtr
 IceInternal::RoutableReference::changeEndpoints(const vector<EndpointIPtr>& newEndpoints) const
 {
-    if(newEndpoints == _endpoints)
+    if(newEndpoints == _endpoints->getValue())
     {
         return RoutableReferencePtr(const_cast<RoutableReference*>(this));
     }
     RoutableReferencePtr r = RoutableReferencePtr::dynamicCast(getInstance()->referenceFactory()->copy(this));
-    r->_endpoints = newEndpoints;
-    r->applyOverrides(r->_endpoints);
+    vector<EndpointIPtr> endpoints = newEndpoints;
+    r->applyOverrides(endpoints);
+    r->_endpoints = new SharedEndpoints(endpoints);
     r->_adapterId.clear();
     return r;
 }
@@ -1028,7 +1014,10 @@ IceInternal::RoutableReference::changeAdapterId(const string& newAdapterId) cons
     }
     RoutableReferencePtr r = RoutableReferencePtr::dynamicCast(getInstance()->referenceFactory()->copy(this));
     r->_adapterId = newAdapterId;
-    r->_endpoints.clear();
+    if(!_endpoints->getValue().empty())
+    {
+        r->_endpoints = new SharedEndpoints(vector<EndpointIPtr>());
+    }
     return r;
 }
 
@@ -1128,14 +1117,15 @@ IceInternal::RoutableReference::changeTimeout(int newTimeout) const
     RoutableReferencePtr r = RoutableReferencePtr::dynamicCast(getInstance()->referenceFactory()->copy(this));
     r->_timeout = newTimeout;
     r->_overrideTimeout = true;
-    if(!_endpoints.empty()) // Also override the timeout on the endpoints.
+    const vector<EndpointIPtr>& endpoints = _endpoints->getValue();
+    if(!endpoints.empty()) // Also override the timeout on the endpoints.
     {
         vector<EndpointIPtr> newEndpoints;
-        for(vector<EndpointIPtr>::const_iterator p = _endpoints.begin(); p != _endpoints.end(); ++p)
+        for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
         {
             newEndpoints.push_back((*p)->timeout(newTimeout));
         }
-        r->_endpoints = newEndpoints;
+        r->_endpoints = new SharedEndpoints(newEndpoints);
     }
     return r;
 }
@@ -1149,14 +1139,15 @@ IceInternal::RoutableReference::changeConnectionId(const string& id) const
     }
     RoutableReferencePtr r = RoutableReferencePtr::dynamicCast(getInstance()->referenceFactory()->copy(this));
     r->_connectionId = id;
-    if(!_endpoints.empty()) // Also override the connection id on the endpoints.
+    const vector<EndpointIPtr>& endpoints = _endpoints->getValue();
+    if(!endpoints.empty()) // Also override the connection id on the endpoints.
     {
         vector<EndpointIPtr> newEndpoints;
-        for(vector<EndpointIPtr>::const_iterator p = _endpoints.begin(); p != _endpoints.end(); ++p)
+        for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
         {
             newEndpoints.push_back((*p)->connectionId(id));
         }
-        r->_endpoints = newEndpoints;
+        r->_endpoints = new SharedEndpoints(newEndpoints);
     }
     return r;
 }
@@ -1164,13 +1155,13 @@ IceInternal::RoutableReference::changeConnectionId(const string& id) const
 bool
 IceInternal::RoutableReference::isIndirect() const
 {
-    return _endpoints.empty();
+    return _endpoints->getValue().empty();
 }
 
 bool
 IceInternal::RoutableReference::isWellKnown() const
 {
-    return _endpoints.empty() && _adapterId.empty();
+    return _endpoints->getValue().empty() && _adapterId.empty();
 }
 
 void
@@ -1178,12 +1169,13 @@ IceInternal::RoutableReference::streamWrite(OutputStream* s) const
 {
     Reference::streamWrite(s);
 
-    Int sz = static_cast<Int>(_endpoints.size());
+    const vector<EndpointIPtr>& endpoints = _endpoints->getValue();
+    Int sz = static_cast<Int>(endpoints.size());
     s->writeSize(sz);
     if(sz)
     {
         assert(_adapterId.empty());
-        for(vector<EndpointIPtr>::const_iterator p = _endpoints.begin(); p != _endpoints.end(); ++p)
+        for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
         {
             s->write((*p)->type());
             (*p)->streamWrite(s);
@@ -1207,9 +1199,10 @@ IceInternal::RoutableReference::toString() const
     //
     string result = Reference::toString();
 
-    if(!_endpoints.empty())
+    const vector<EndpointIPtr>& endpoints = _endpoints->getValue();
+    if(!endpoints.empty())
     {
-        for(vector<EndpointIPtr>::const_iterator p = _endpoints.begin(); p != _endpoints.end(); ++p)
+        for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
         {
             string endp = (*p)->toString();
             if(!endp.empty())
@@ -1344,18 +1337,24 @@ IceInternal::RoutableReference::operator==(const Reference& r) const
     {
         return false;
     }
+    if(_endpoints.get() != rhs->_endpoints.get())
+    {
+        const vector<EndpointIPtr>& endpoints = _endpoints->getValue();
+        const vector<EndpointIPtr>& rhsEndpoints = rhs->_endpoints->getValue();
 #ifdef ICE_CPP11_MAPPING
-    //
-    // TODO: With C++14 we could use the version that receives four iterators and we don't need to explicitly
-    // check the sizes are equal.
-    //
-    if(_endpoints.size() != rhs->_endpoints.size() ||
-       !equal(_endpoints.begin(), _endpoints.end(), rhs->_endpoints.begin(), Ice::TargetCompare<shared_ptr<EndpointI>, std::equal_to>()))
+        //
+        // TODO: With C++14 we could use the version that receives four iterators and we don't need to explicitly
+        // check the sizes are equal.
+        //
+        if(endpoints.size() != rhsEndpoints.size() ||
+           !equal(endpoints.begin(), endpoints.end(), rhsEndpoints.begin(),
+                  Ice::TargetCompare<shared_ptr<EndpointI>, std::equal_to>()))
 #else
-    if(_endpoints != rhs->_endpoints)
+        if(endpoints != rhsEndpoints)
 #endif
-    {
-        return false;
+        {
+            return false;
+        }
     }
     if(_adapterId != rhs->_adapterId)
     {
@@ -1475,18 +1474,23 @@ IceInternal::RoutableReference::operator<(const Reference& r) const
     {
         return false;
     }
+    if(_endpoints.get() != rhs->_endpoints.get())
+    {
+        const vector<EndpointIPtr>& endpoints = _endpoints->getValue();
+        const vector<EndpointIPtr>& rhsEndpoints = rhs->_endpoints->getValue();
 #ifdef ICE_CPP11_MAPPING
-    if(lexicographical_compare(_endpoints.begin(), _endpoints.end(), rhs->_endpoints.begin(), rhs->_endpoints.end(),
-                               Ice::TargetCompare<shared_ptr<EndpointI>, std::less>()))
+        if(lexicographical_compare(endpoints.begin(), endpoints.end(), rhsEndpoints.begin(), rhsEndpoints.end(),
+                                   Ice::TargetCompare<shared_ptr<EndpointI>, std::less>()))
 #else
-    if(_endpoints < rhs->_endpoints)
+        if(endpoints < rhsEndpoints)
 #endif
-    {
-        return true;
-    }
-    else if(rhs->_endpoints < _endpoints)
-    {
-        return false;
+        {
+            return true;
+        }
+        else if(rhsEndpoints < endpoints)
+        {
+            return false;
+        }
     }
     if(_locatorCacheTimeout < rhs->_locatorCacheTimeout)
     {
@@ -1661,9 +1665,9 @@ IceInternal::RoutableReference::getConnectionNoRouterInfo(const GetConnectionCal
         const GetConnectionCallbackPtr _callback;
     };
 
-    if(!_endpoints.empty())
+    if(!_endpoints->getValue().empty())
     {
-        createConnection(_endpoints, callback);
+        createConnection(_endpoints->getValue(), callback);
         return;
     }
 
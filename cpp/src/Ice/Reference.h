@@ -11,6 +11,7 @@
 #define ICE_REFERENCE_H
 
 #include <IceUtil/Shared.h>
+#include <IceUtil/Atomic.h>
 #include <Ice/ReferenceF.h>
 #include <Ice/ReferenceFactoryF.h>
 #include <Ice/EndpointIF.h>
@@ -156,8 +157,13 @@ protected:
 
     virtual Ice::Int hashInit() const;
 
-    mutable Ice::Int _hashValue;
-    mutable bool _hashInitialized;
+    //
+    // The hash is computed on first use. References are immutable once
+    // shared so it's memoized without locking, concurrent threads might
+    // compute the same value.
+    //
+    mutable IceUtilInternal::Atomic _hashValue;
+    mutable IceUtilInternal::Atomic _hashInitialized;
 
 private:
 
@@ -230,6 +236,31 @@ private:
     Ice::ConnectionIPtr _fixedConnection;
 };
 
+//
+// The endpoints of a routable reference, shared by the copies of the
+// reference. The endpoints are never modified, a reference with other
+// endpoints gets its own SharedEndpoints.
+//
+class SharedEndpoints : public IceUtil::Shared
+{
+public:
+
+    SharedEndpoints(const std::vector<EndpointIPtr>& val) :
+        _val(val)
+    {
+    }
+
+    inline const std::vector<EndpointIPtr>& getValue() const
+    {
+        return _val;
+    }
+
+private:
+
+    const std::vector<EndpointIPtr> _val;
+};
+typedef IceUtil::Handle<SharedEndpoints> SharedEndpointsPtr;
+
 class RoutableReference : public Reference
 {
 public:
@@ -296,7 +327,7 @@ protected:
 
 private:
 
-    std::vector<EndpointIPtr> _endpoints; // Empty if indirect proxy.
+    SharedEndpointsPtr _endpoints; // Empty if indirect proxy.
     std::string _adapterId; // Empty if direct proxy.
 
     LocatorInfoPtr _locatorInfo; // Null if no locator is used.
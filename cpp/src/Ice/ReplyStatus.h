@@ -24,6 +24,13 @@ static const Ice::Byte replyUnknownLocalException = 5;
 static const Ice::Byte replyUnknownUserException = 6;
 static const Ice::Byte replyUnknownException = 7;
 
+//
+// Marker written after the message of an unknown local exception reply if
+// the request was rejected by the dispatch admission control of the server
+// and wasn't dispatched. Older clients ignore it.
+//
+static const Ice::Byte replyDispatchRejectedMarker = 1;
+
 }
 
 #endif
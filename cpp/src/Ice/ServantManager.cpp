@@ -20,42 +20,41 @@ using namespace IceInternal;
 
 ICE_API IceUtil::Shared* IceInternal::upCast(ServantManager* p) { return p; }
 
-void
-IceInternal::ServantManager::addServant(const ObjectPtr& object, const Identity& ident, const string& facet)
+namespace
 {
-    IceUtil::Mutex::Lock sync(*this);
-
-    assert(_instance); // Must not be called after destruction.
-
-    ServantMapMap::iterator p = _servantMapMapHint;
 
-    if(p == _servantMapMap.end() || p->first != ident)
+string
+servantId(const Identity& ident, const string& facet, ToStringMode toStringMode)
+{
+    string id = Ice::identityToString(ident, toStringMode);
+    if(!facet.empty())
     {
-        p = _servantMapMap.find(ident);
+        id += " -f " + escapeString(facet, "", toStringMode);
     }
+    return id;
+}
 
-    if(p == _servantMapMap.end())
+}
+
+void
+IceInternal::ServantManager::addServant(const ObjectPtr& object, const Identity& ident, const string& facet)
+{
+    ServantMapShard& shard = this->shard(ident);
+    IceUtil::Mutex::Lock sync(shard);
+
+    ServantMapMap::iterator p = shard.servantMapMap.find(ident);
+    if(p == shard.servantMapMap.end())
     {
-        p = _servantMapMap.insert(_servantMapMapHint, pair<const Identity, FacetMap>(ident, FacetMap()));
+        p = shard.servantMapMap.insert(pair<const Identity, FacetMap>(ident, FacetMap())).first;
     }
-    else
+    else if(p->second.find(facet) != p->second.end())
     {
-        if(p->second.find(facet) != p->second.end())
-        {
-            AlreadyRegisteredException ex(__FILE__, __LINE__);
-            ex.kindOfObject = "servant";
-            ToStringMode toStringMode = _instance->toStringMode();
-            ex.id = Ice::identityToString(ident, toStringMode);
-            if(!facet.empty())
-            {
-                ex.id += " -f " + escapeString(facet, "", toStringMode);
-            }
-            throw ex;
-        }
+        AlreadyRegisteredException ex(__FILE__, __LINE__);
+        ex.kindOfObject = "servant";
+        ex.id = servantId(ident, facet, _toStringMode);
+        throw ex;
     }
 
-    _servantMapMapHint = p;
-
     p->second.insert(pair<const string, ObjectPtr>(facet, object));
 }
 
@@ -88,28 +87,16 @@ IceInternal::ServantManager::removeServant(const Identity& ident, const string&
     //
     ObjectPtr servant = 0;
 
-    IceUtil::Mutex::Lock sync(*this);
-
-    assert(_instance); // Must not be called after destruction.
+    ServantMapShard& shard = this->shard(ident);
+    IceUtil::Mutex::Lock sync(shard);
 
-    ServantMapMap::iterator p = _servantMapMapHint;
+    ServantMapMap::iterator p = shard.servantMapMap.find(ident);
     FacetMap::iterator q;
-
-    if(p == _servantMapMap.end() || p->first != ident)
-    {
-        p = _servantMapMap.find(ident);
-    }
-
-    if(p == _servantMapMap.end() || (q = p->second.find(facet)) == p->second.end())
+    if(p == shard.servantMapMap.end() || (q = p->second.find(facet)) == p->second.end())
     {
         NotRegisteredException ex(__FILE__, __LINE__);
         ex.kindOfObject = "servant";
-        ToStringMode toStringMode = _instance->toStringMode();
-        ex.id = Ice::identityToString(ident, toStringMode);
-        if(!facet.empty())
-        {
-            ex.id += " -f " + escapeString(facet, "", toStringMode);
-        }
+        ex.id = servantId(ident, facet, _toStringMode);
         throw ex;
     }
 
@@ -118,15 +105,7 @@ IceInternal::ServantManager::removeServant(const Identity& ident, const string&
 
     if(p->second.empty())
     {
-        if(p == _servantMapMapHint)
-        {
-            _servantMapMap.erase(p++);
-            _servantMapMapHint = p;
-        }
-        else
-        {
-            _servantMapMap.erase(p);
-        }
+        shard.servantMapMap.erase(p);
     }
     return servant;
 }
@@ -163,77 +142,56 @@ IceInternal::ServantManager::removeDefaultServant(const string& category)
 FacetMap
 IceInternal::ServantManager::removeAllFacets(const Identity& ident)
 {
-    IceUtil::Mutex::Lock sync(*this);
-
-    assert(_instance); // Must not be called after destruction.
-
-    ServantMapMap::iterator p = _servantMapMapHint;
-
-    if(p == _servantMapMap.end() || p->first != ident)
-    {
-        p = _servantMapMap.find(ident);
-    }
+    ServantMapShard& shard = this->shard(ident);
+    IceUtil::Mutex::Lock sync(shard);
 
-    if(p == _servantMapMap.end())
+    ServantMapMap::iterator p = shard.servantMapMap.find(ident);
+    if(p == shard.servantMapMap.end())
     {
         NotRegisteredException ex(__FILE__, __LINE__);
         ex.kindOfObject = "servant";
-        ex.id = Ice::identityToString(ident, _instance->toStringMode());
+        ex.id = Ice::identityToString(ident, _toStringMode);
         throw ex;
     }
 
-    FacetMap result = p->second;
-
-    if(p == _servantMapMapHint)
-    {
-        _servantMapMap.erase(p++);
-        _servantMapMapHint = p;
-    }
-    else
-    {
-        _servantMapMap.erase(p);
-    }
-
+    FacetMap result;
+    result.swap(p->second);
+    shard.servantMapMap.erase(p);
     return result;
 }
 
 ObjectPtr
 IceInternal::ServantManager::findServant(const Identity& ident, const string& facet) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     //
-    // This assert is not valid if the adapter dispatch incoming
-    // requests from bidir connections. This method might be called if
-    // requests are received over the bidir connection after the
-    // adapter was deactivated.
+    // This method might be called after destruction if the adapter
+    // dispatches incoming requests from bidir connections after it
+    // was deactivated, the shards are empty in this case.
     //
-    //assert(_instance); // Must not be called after destruction.
-
-    ServantMapMap::iterator p = _servantMapMapHint;
-    FacetMap::iterator q;
-
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
-
-    if(p == servantMapMap.end() || p->first != ident)
     {
-        p = servantMapMap.find(ident);
+        ServantMapShard& shard = this->shard(ident);
+        IceUtil::Mutex::Lock sync(shard);
+
+        ServantMapMap::const_iterator p = shard.servantMapMap.find(ident);
+        if(p != shard.servantMapMap.end())
+        {
+            FacetMap::const_iterator q = p->second.find(facet);
+            if(q != p->second.end())
+            {
+                return q->second;
+            }
+        }
     }
 
-    if(p == servantMapMap.end() || (q = p->second.find(facet)) == p->second.end())
+    IceUtil::Mutex::Lock sync(*this);
+
+    DefaultServantMap::const_iterator p = _defaultServantMap.find(ident.category);
+    if(p == _defaultServantMap.end())
     {
-        DefaultServantMap::const_iterator p = _defaultServantMap.find(ident.category);
+        p = _defaultServantMap.find("");
         if(p == _defaultServantMap.end())
         {
-            p = _defaultServantMap.find("");
-            if(p == _defaultServantMap.end())
-            {
-                return 0;
-            }
-            else
-            {
-                return p->second;
-            }
+            return 0;
         }
         else
         {
@@ -242,8 +200,7 @@ IceInternal::ServantManager::findServant(const Identity& ident, const string& fa
     }
     else
     {
-        _servantMapMapHint = p;
-        return q->second;
+        return p->second;
     }
 }
 
@@ -266,26 +223,16 @@ IceInternal::ServantManager::findDefaultServant(const string& category) const
 FacetMap
 IceInternal::ServantManager::findAllFacets(const Identity& ident) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
-    assert(_instance); // Must not be called after destruction.
-
-    ServantMapMap::iterator p = _servantMapMapHint;
+    ServantMapShard& shard = this->shard(ident);
+    IceUtil::Mutex::Lock sync(shard);
 
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
-
-    if(p == servantMapMap.end() || p->first != ident)
-    {
-        p = servantMapMap.find(ident);
-    }
-
-    if(p == servantMapMap.end())
+    ServantMapMap::const_iterator p = shard.servantMapMap.find(ident);
+    if(p == shard.servantMapMap.end())
     {
         return FacetMap();
     }
     else
     {
-        _servantMapMapHint = p;
         return p->second;
     }
 }
@@ -293,34 +240,12 @@ IceInternal::ServantManager::findAllFacets(const Identity& ident) const
 bool
 IceInternal::ServantManager::hasServant(const Identity& ident) const
 {
-    IceUtil::Mutex::Lock sync(*this);
+    ServantMapShard& shard = this->shard(ident);
+    IceUtil::Mutex::Lock sync(shard);
 
-    //
-    // This assert is not valid if the adapter dispatch incoming
-    // requests from bidir connections. This method might be called if
-    // requests are received over the bidir connection after the
-    // adapter was deactivated.
-    //
-    //assert(_instance); // Must not be called after destruction.
-
-    ServantMapMap::iterator p = _servantMapMapHint;
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
-
-    if(p == servantMapMap.end() || p->first != ident)
-    {
-        p = servantMapMap.find(ident);
-    }
-
-    if(p == servantMapMap.end())
-    {
-        return false;
-    }
-    else
-    {
-        _servantMapMapHint = p;
-        assert(!p->second.empty());
-        return true;
-    }
+    ServantMapMap::const_iterator p = shard.servantMapMap.find(ident);
+    assert(p == shard.servantMapMap.end() || !p->second.empty());
+    return p != shard.servantMapMap.end();
 }
 
 void
@@ -421,7 +346,7 @@ IceInternal::ServantManager::findServantLocator(const string& category) const
 IceInternal::ServantManager::ServantManager(const InstancePtr& instance, const string& adapterName)
     : _instance(instance),
       _adapterName(adapterName),
-      _servantMapMapHint(_servantMapMap.end()),
+      _toStringMode(instance->toStringMode()),
       _locatorMapHint(_locatorMap.end())
 {
 }
@@ -439,7 +364,7 @@ IceInternal::ServantManager::~ServantManager()
 void
 IceInternal::ServantManager::destroy()
 {
-    ServantMapMap servantMapMap;
+    ServantMapMap servantMapMaps[ShardCount];
     DefaultServantMap defaultServantMap;
     map<string, ServantLocatorPtr> locatorMap;
     Ice::LoggerPtr logger;
@@ -456,8 +381,11 @@ IceInternal::ServantManager::destroy()
 
         logger = _instance->initializationData().logger;
 
-        servantMapMap.swap(_servantMapMap);
-        _servantMapMapHint = _servantMapMap.end();
+        for(int i = 0; i < ShardCount; ++i)
+        {
+            IceUtil::Mutex::Lock sync(_shards[i]);
+            servantMapMaps[i].swap(_shards[i].servantMapMap);
+        }
 
         defaultServantMap.swap(_defaultServantMap);
 
@@ -495,7 +423,29 @@ IceInternal::ServantManager::destroy()
     // hold any internal Ice mutex while running user code (such as servant
     // or servant locator destructors).
     //
-    servantMapMap.clear();
+    for(int i = 0; i < ShardCount; ++i)
+    {
+        servantMapMaps[i].clear();
+    }
     locatorMap.clear();
     defaultServantMap.clear();
 }
+
+IceInternal::ServantManager::ServantMapShard&
+IceInternal::ServantManager::shard(const Identity& ident) const
+{
+    //
+    // FNV-1a hash of the identity.
+    //
+    unsigned int h = 2166136261U;
+    for(string::const_iterator p = ident.name.begin(); p != ident.name.end(); ++p)
+    {
+        h = (h ^ static_cast<unsigned char>(*p)) * 16777619U;
+    }
+    h = (h ^ '/') * 16777619U;
+    for(string::const_iterator p = ident.category.begin(); p != ident.category.end(); ++p)
+    {
+        h = (h ^ static_cast<unsigned char>(*p)) * 16777619U;
+    }
+    return _shards[h % ShardCount];
+}
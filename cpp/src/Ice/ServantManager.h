@@ -17,6 +17,7 @@
 #include <Ice/ServantLocatorF.h>
 #include <Ice/Identity.h>
 #include <Ice/FacetMap.h>
+#include <Ice/Communicator.h>
 
 namespace Ice
 {
@@ -56,12 +57,33 @@ private:
     InstancePtr _instance;
 
     const std::string _adapterName;
+    const Ice::ToStringMode _toStringMode;
 
     typedef std::map<Ice::Identity, Ice::FacetMap> ServantMapMap;
     typedef std::map<std::string, Ice::ObjectPtr> DefaultServantMap;
 
-    ServantMapMap _servantMapMap;
-    mutable ServantMapMap::iterator _servantMapMapHint;
+    //
+    // The active servant map is split into shards, selected with a hash
+    // of the identity, each with its own mutex. Threads dispatching
+    // requests to different servants therefore rarely contend and each
+    // shard only holds a fraction of the servants. The mutex of the
+    // servant manager protects the other members.
+    //
+    enum { ShardCount = 64 };
+
+    struct ServantMapShard : public IceUtil::Mutex
+    {
+        ServantMapMap servantMapMap;
+
+        //
+        // Keep the shards on different cache lines.
+        //
+        char padding[64];
+    };
+
+    ServantMapShard& shard(const Ice::Identity&) const;
+
+    mutable ServantMapShard _shards[ShardCount];
 
     DefaultServantMap _defaultServantMap;
 
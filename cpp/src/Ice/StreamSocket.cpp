@@ -11,6 +11,10 @@
 #include <Ice/NetworkProxy.h>
 #include <Ice/ProtocolInstance.h>
 
+#if !defined(_WIN32)
+#   include <sys/uio.h>
+#endif
+
 using namespace IceInternal;
 
 #if defined(ICE_OS_UWP)
@@ -223,7 +227,16 @@ StreamSocket::write(Buffer& buf)
             }
         }
     }
-    buf.i += write(reinterpret_cast<const char*>(&*buf.i), buf.b.end() - buf.i);
+#if !defined(_WIN32)
+    if(!buf.segments.empty())
+    {
+        buf.i += writev(buf);
+    }
+    else
+#endif
+    {
+        buf.i += write(reinterpret_cast<const char*>(&*buf.i), buf.b.end() - buf.i);
+    }
 #endif
     return buf.i != buf.b.end() ? SocketOperationWrite : SocketOperationNone;
 }
@@ -368,6 +381,101 @@ StreamSocket::write(const char* buf, size_t length)
 }
 #endif
 
+#if !defined(_WIN32)
+ssize_t
+StreamSocket::writev(const Buffer& buf)
+{
+    assert(_fd != INVALID_SOCKET);
+
+    const Buffer::Container::size_type size = buf.b.size();
+    Buffer::Container::size_type pos = static_cast<Buffer::Container::size_type>(buf.i - buf.b.begin());
+    ssize_t sent = 0;
+    while(pos < size)
+    {
+        //
+        // Gather the remaining data of the buffer. The segments are sorted
+        // by offset and take the place of the space reserved for them in
+        // the buffer.
+        //
+        const int maxIov = 64;
+        struct iovec iov[maxIov];
+        int cnt = 0;
+        Buffer::Container::size_type last = pos;
+        std::vector<Buffer::Segment>::const_iterator p = buf.segments.begin();
+        for(; p != buf.segments.end() && cnt < maxIov - 2; ++p)
+        {
+            if(last >= p->offset + p->size)
+            {
+                continue; // Already sent.
+            }
+
+            if(last < p->offset)
+            {
+                iov[cnt].iov_base = const_cast<Ice::Byte*>(&buf.b[last]);
+                iov[cnt].iov_len = p->offset - last;
+                ++cnt;
+                last = p->offset;
+            }
+
+            iov[cnt].iov_base = const_cast<Ice::Byte*>(p->data + (last - p->offset));
+            iov[cnt].iov_len = p->offset + p->size - last;
+            ++cnt;
+            last = p->offset + p->size;
+        }
+
+        //
+        // If not all the segments could be gathered, the trailing data ends
+        // where the first remaining segment starts: the buffer only holds
+        // reserved space for the segment data.
+        //
+        Buffer::Container::size_type end = p == buf.segments.end() ? size : p->offset;
+        if(last < end)
+        {
+            iov[cnt].iov_base = const_cast<Ice::Byte*>(&buf.b[last]);
+            iov[cnt].iov_len = end - last;
+            ++cnt;
+        }
+
+        ssize_t ret = ::writev(_fd, iov, cnt);
+        if(ret == 0)
+        {
+            Ice::ConnectionLostException ex(__FILE__, __LINE__);
+            ex.error = 0;
+            throw ex;
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            if(wouldBlock())
+            {
+                return sent;
+            }
+
+            if(connectionLost())
+            {
+                Ice::ConnectionLostException ex(__FILE__, __LINE__);
+                ex.error = getSocketErrno();
+                throw ex;
+            }
+            else
+            {
+                Ice::SocketException ex(__FILE__, __LINE__);
+                ex.error = getSocketErrno();
+                throw ex;
+            }
+        }
+
+        pos += ret;
+        sent += ret;
+    }
+    return sent;
+}
+#endif
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
 AsyncInfo*
 StreamSocket::getAsyncInfo(SocketOperation op)
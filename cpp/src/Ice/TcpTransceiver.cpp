@@ -124,6 +124,16 @@ IceInternal::TcpTransceiver::setBufferSize(int rcvSize, int sndSize)
     _stream->setBufferSize(rcvSize, sndSize);
 }
 
+bool
+IceInternal::TcpTransceiver::supportsGatherWrite() const
+{
+#if defined(_WIN32)
+    return false;
+#else
+    return true;
+#endif
+}
+
 IceInternal::TcpTransceiver::TcpTransceiver(const ProtocolInstancePtr& instance, const StreamSocketPtr& stream) :
     _instance(instance),
     _stream(stream)
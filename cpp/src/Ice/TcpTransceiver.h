@@ -45,6 +45,7 @@ public:
     virtual Ice::ConnectionInfoPtr getInfo() const;
     virtual void checkSendSize(const Buffer&);
     virtual void setBufferSize(int rcvSize, int sndSize);
+    virtual bool supportsGatherWrite() const;
 
 private:
 
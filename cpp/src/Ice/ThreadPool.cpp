@@ -12,6 +12,7 @@
 #include <Ice/Network.h>
 #include <Ice/LocalException.h>
 #include <Ice/Instance.h>
+#include <Ice/InstrumentationI.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/Protocol.h>
 #include <Ice/ObjectAdapterFactory.h>
@@ -22,6 +23,11 @@
 #   include <Ice/StringConverter.h>
 #endif
 
+#if defined(__linux)
+#   include <pthread.h>
+#   include <sched.h>
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace Ice::Instrumentation;
@@ -248,7 +254,8 @@ IceInternal::ThreadPoolWorkQueue::getNativeInfo()
     return 0;
 }
 
-IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& prefix, int timeout) :
+IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& prefix, int timeout, int shard,
+                                    ThreadPool* parent) :
     _instance(instance),
     _dispatcher(_instance->initializationData().dispatcher),
     _destroyed(false),
@@ -265,12 +272,25 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
     _serverIdleTime(timeout),
     _threadIdleTime(0),
     _stackSize(0),
+    _shard(shard),
+    _cpu(-1),
+    _parent(parent),
+    _nextShard(0),
+    _idle(false),
     _inUse(0),
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
     _inUseIO(0),
     _nextHandler(_handlers.end()),
 #endif
-    _promote(true)
+    _promote(true),
+    _targetLatency(0),
+    _measure(false),
+    _queueDelay(0),
+    _serviceTime(0),
+    _sampleTime(IceUtil::Time::now(IceUtil::Time::Monotonic)),
+    _sampleCount(0),
+    _targetSize(0),
+    _overloaded(false)
 {
     PropertiesPtr properties = _instance->initializationData().properties;
 #ifndef ICE_OS_UWP
@@ -342,6 +362,28 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
 #endif
     const_cast<int&>(_threadIdleTime) = threadIdleTime;
 
+    int targetLatency = properties->getPropertyAsInt(_prefix + ".TargetLatency");
+    if(targetLatency < 0)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".TargetLatency < 0; TargetLatency adjusted to 0";
+        targetLatency = 0;
+    }
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
+    if(targetLatency > 0 && _shard == 0)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".TargetLatency is not supported on this platform";
+    }
+    targetLatency = 0;
+#endif
+    if(sizeMax > size)
+    {
+        const_cast<IceUtil::Int64&>(_targetLatency) = static_cast<IceUtil::Int64>(targetLatency) * 1000;
+    }
+    _measure = _targetLatency > 0; // Also enabled by the threads with a metrics observer, see updateObserver().
+    _targetSize = _targetLatency > 0 ? size : 0;
+
 #ifdef ICE_USE_IOCP
     _selector.setup(_sizeIO);
 #endif
@@ -363,14 +405,46 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
         const_cast<int&>(_priority) = properties->getPropertyAsInt("Ice.ThreadPriority");
     }
 
+    int shards = properties->getPropertyAsIntWithDefault(_prefix + ".Shards", 1);
+    if(shards < 1)
+    {
+        if(_shard == 0)
+        {
+            Warning out(_instance->initializationData().logger);
+            out << _prefix << ".Shards < 1; Shards adjusted to 1";
+        }
+        shards = 1;
+    }
+
+    if(shards > 1 && properties->getPropertyAsInt(_prefix + ".ShardAffinity") > 0)
+    {
+#if defined(__linux)
+        const_cast<int&>(_cpu) = _shard % nProcessors;
+#else
+        if(_shard == 0)
+        {
+            Warning out(_instance->initializationData().logger);
+            out << _prefix << ".ShardAffinity is not supported on this platform";
+        }
+#endif
+    }
+
     _workQueue = ICE_MAKE_SHARED(ThreadPoolWorkQueue, *this);
     _selector.initialize(_workQueue.get());
 
-    if(_instance->traceLevels()->threadPool >= 1)
+    if(_shard == 0 && _instance->traceLevels()->threadPool >= 1)
     {
         Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
         out << "creating " << _prefix << ": Size = " << _size << ", SizeMax = " << _sizeMax << ", SizeWarn = "
             << _sizeWarn;
+        if(_targetLatency > 0)
+        {
+            out << ", TargetLatency = " << _targetLatency / 1000 << "ms";
+        }
+        if(shards > 1)
+        {
+            out << ", Shards = " << shards;
+        }
     }
 
     __setNoDelete(true);
@@ -389,6 +463,18 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
             }
             _threads.insert(thread);
         }
+
+        //
+        // The thread pool itself is the first shard. Each shard monitors the
+        // server idle time with its own selector, see shardsIdle().
+        //
+        if(_shard == 0)
+        {
+            for(int i = 1; i < shards; ++i)
+            {
+                _shards.push_back(new ThreadPool(_instance, _prefix, _serverIdleTime, i, this));
+            }
+        }
     }
     catch(const IceUtil::Exception& ex)
     {
@@ -425,16 +511,27 @@ IceInternal::ThreadPool::destroy()
     }
     _destroyed = true;
     _workQueue->destroy();
+
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        (*p)->destroy();
+    }
 }
 
 void
 IceInternal::ThreadPool::updateObservers()
 {
     Lock sync(*this);
+    _measure = _targetLatency > 0;
     for(set<EventHandlerThreadPtr>::iterator p = _threads.begin(); p != _threads.end(); ++p)
     {
         (*p)->updateObserver();
     }
+
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        (*p)->updateObservers();
+    }
 }
 
 void
@@ -589,6 +686,11 @@ IceInternal::ThreadPool::joinWithAllThreads()
         (*p)->getThreadControl().join();
     }
     _selector.destroy();
+
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        (*p)->joinWithAllThreads();
+    }
 }
 
 string
@@ -597,6 +699,24 @@ IceInternal::ThreadPool::prefix() const
     return _prefix;
 }
 
+ThreadPoolPtr
+IceInternal::ThreadPool::nextShard()
+{
+    if(_shards.empty())
+    {
+        return this;
+    }
+
+    //
+    // Connections are assigned to the shards in a round-robin fashion, the
+    // thread pool itself being the first shard.
+    //
+    Lock sync(*this);
+    size_t shard = _nextShard;
+    _nextShard = (_nextShard + 1) % (_shards.size() + 1);
+    return shard == 0 ? ThreadPoolPtr(this) : _shards[shard - 1];
+}
+
 void
 IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
 {
@@ -635,9 +755,13 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
             }
             catch(const SelectorTimeoutException&)
             {
-                Lock sync(*this);
-                if(!_destroyed && _inUse == 0)
                 {
+                    Lock sync(*this);
+                    _idle = true;
+                }
+                if((_parent ? _parent : this)->shardsIdle())
+                {
+                    Lock sync(*this);
                     _workQueue->queue(new ShutdownWorkItem(_instance)); // Select timed-out.
                 }
                 continue;
@@ -646,6 +770,11 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
 
         {
             Lock sync(*this);
+            if(current._handler && _measure && current._startTime != IceUtil::Time())
+            {
+                workCompleted(current);
+            }
+
             if(!current._handler)
             {
                 if(select)
@@ -653,6 +782,11 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
                     _selector.finishSelect(_handlers);
                     _nextHandler = _handlers.begin();
                     select = false;
+                    _idle = false;
+                    if(_measure)
+                    {
+                        _readyTime = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                    }
                 }
                 else if(!current._leader && followerWait(current))
                 {
@@ -704,6 +838,15 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
                 current.operation = _nextHandler->second;
                 ++_nextHandler;
                 thread->setState(ThreadStateInUseForIO);
+                if(_measure)
+                {
+                    current._startTime = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                    current._queueDelay = (current._startTime - _readyTime).toMicroSeconds();
+                }
+                else
+                {
+                    current._startTime = IceUtil::Time();
+                }
             }
             else
             {
@@ -811,9 +954,13 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
             }
             catch(const SelectorTimeoutException&)
             {
-                Lock sync(*this);
-                if(!_destroyed)
                 {
+                    Lock sync(*this);
+                    _idle = true;
+                }
+                if((_parent ? _parent : this)->shardsIdle())
+                {
+                    Lock sync(*this);
                     _workQueue->queue(new ShutdownWorkItem(_instance));
                 }
                 continue;
@@ -822,6 +969,7 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
 
         {
             IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+            _idle = false;
             thread->setState(ThreadStateInUseForIO);
         }
 
@@ -871,6 +1019,33 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
 #endif
 }
 
+bool
+IceInternal::ThreadPool::shardsIdle()
+{
+    //
+    // Must be called on the first shard without any thread pool mutex
+    // locked. The server is idle once the selector of every shard timed
+    // out without activity since and no thread is in use.
+    //
+    {
+        Lock sync(*this);
+        if(_destroyed || !_idle || _inUse > 0)
+        {
+            return false;
+        }
+    }
+
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        Lock sync(**p);
+        if((*p)->_destroyed || !(*p)->_idle || (*p)->_inUse > 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool
 IceInternal::ThreadPool::ioCompleted(ThreadPoolCurrent& current)
 {
@@ -920,7 +1095,12 @@ IceInternal::ThreadPool::ioCompleted(ThreadPoolCurrent& current)
         if(!_destroyed)
         {
             assert(_inUse <= static_cast<int>(_threads.size()));
-            if(_inUse < _sizeMax && _inUse == static_cast<int>(_threads.size()))
+            //
+            // Grow the thread pool if all the threads are in use or if the
+            // controller needs more threads to meet the target latency.
+            //
+            int size = static_cast<int>(_threads.size());
+            if(_inUse < _sizeMax && (_inUse == size || size < _targetSize))
             {
                 if(_instance->traceLevels()->threadPool >= 1)
                 {
@@ -1094,10 +1274,33 @@ IceInternal::ThreadPool::followerWait(ThreadPoolCurrent& current)
     //
     while(!_promote || _inUseIO == _sizeIO || (_nextHandler == _handlers.end() && _inUseIO > 0))
     {
-        if(_threadIdleTime)
+        //
+        // Threads in excess of the controller target size are released
+        // after at most a second of idle time.
+        //
+        IceUtil::Time idleTime = IceUtil::Time::seconds(_threadIdleTime);
+        bool excess = false;
+        if(_targetSize > 0 && static_cast<int>(_threads.size()) > _targetSize &&
+           (idleTime == IceUtil::Time() || idleTime > IceUtil::Time::seconds(1)))
+        {
+            idleTime = IceUtil::Time::seconds(1);
+            excess = true;
+        }
+
+        if(idleTime != IceUtil::Time())
         {
-            if(!timedWait(IceUtil::Time::seconds(_threadIdleTime)))
+            if(!timedWait(idleTime))
             {
+                //
+                // Other threads might have been released or the target size
+                // might have changed while waiting, so check again that this
+                // thread is still in excess of the target size.
+                //
+                if(excess && static_cast<int>(_threads.size()) <= _targetSize)
+                {
+                    continue;
+                }
+
                 if(!_destroyed && (!_promote || _inUseIO == _sizeIO ||
                                    (_nextHandler == _handlers.end() && _inUseIO > 0)))
                 {
@@ -1122,19 +1325,89 @@ IceInternal::ThreadPool::followerWait(ThreadPoolCurrent& current)
     _promote = false;
     return false;
 }
+
+void
+IceInternal::ThreadPool::workCompleted(ThreadPoolCurrent& current)
+{
+    // Must be called with the thread pool mutex locked
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    IceUtil::Int64 serviceTime = (now - current._startTime).toMicroSeconds();
+    if(_targetLatency > 0)
+    {
+        //
+        // Smooth the measures with an exponentially weighted moving average
+        // and periodically recompute the target size. By Little's law, the
+        // number of threads kept busy is the rate of work items times their
+        // service time, we add one thread to absorb bursts and grow further
+        // as long as the queueing delay is over the target latency.
+        //
+        _queueDelay += (current._queueDelay - _queueDelay) / 8;
+        _serviceTime += (serviceTime - _serviceTime) / 8;
+        ++_sampleCount;
+
+        IceUtil::Int64 elapsed = (now - _sampleTime).toMicroSeconds();
+        if(elapsed >= 100000)
+        {
+            int targetSize = static_cast<int>((_sampleCount * _serviceTime + elapsed / 2) / elapsed) + 1;
+            if(_queueDelay > _targetLatency)
+            {
+                targetSize = max(targetSize, _targetSize + 1);
+            }
+            targetSize = max(_size, min(_sizeMax, targetSize));
+
+            bool overloaded = _queueDelay > _targetLatency && targetSize == _sizeMax &&
+                static_cast<int>(_threads.size()) == _sizeMax;
+            if(overloaded && !_overloaded)
+            {
+                Warning out(_instance->initializationData().logger);
+                out << "thread pool `" << _prefix << "' can't meet its target latency\n"
+                    << "SizeMax=" << _sizeMax << ", " << "TargetLatency=" << _targetLatency / 1000 << "ms, "
+                    << "QueueDelay=" << _queueDelay / 1000 << "ms";
+            }
+
+            if(_instance->traceLevels()->threadPool >= 2 && targetSize != _targetSize)
+            {
+                Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
+                out << "resizing " << _prefix << ": TargetSize=" << targetSize << ", QueueDelay="
+                    << _queueDelay << "us, ServiceTime=" << _serviceTime << "us";
+            }
+
+            _targetSize = targetSize;
+            _overloaded = overloaded;
+            _sampleTime = now;
+            _sampleCount = 0;
+        }
+    }
+    current._thread->workCompleted(current._queueDelay, serviceTime, _targetSize);
+}
 #endif
 
+bool
+IceInternal::ThreadPool::overloaded()
+{
+    Lock sync(*this);
+    return _overloaded;
+}
+
 string
 IceInternal::ThreadPool::nextThreadId()
 {
     ostringstream os;
-    os << _prefix << "-" << _nextThreadId++;
+    if(_shard > 0)
+    {
+        os << _prefix << ".Shard" << _shard << "-" << _nextThreadId++;
+    }
+    else
+    {
+        os << _prefix << "-" << _nextThreadId++;
+    }
     return os.str();
 }
 
 IceInternal::ThreadPool::EventHandlerThread::EventHandlerThread(const ThreadPoolPtr& pool, const string& name) :
     IceUtil::Thread(name),
     _pool(pool),
+    _metricsObserver(0),
     _state(Ice::Instrumentation::ThreadStateIdle)
 {
     updateObserver();
@@ -1148,6 +1421,17 @@ IceInternal::ThreadPool::EventHandlerThread::updateObserver()
     if(obsv)
     {
         _observer.attach(obsv->getThreadObserver(_pool->_prefix, name(), _state, _observer.get()));
+        _metricsObserver = dynamic_cast<ThreadObserverI*>(_observer.operator->());
+
+        //
+        // The queueing delay and service time are only measured if the
+        // metrics observer of the threads consumes them.
+        //
+        if(_metricsObserver && !_pool->_measure)
+        {
+            _pool->_measure = true;
+            _pool->_readyTime = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        }
     }
 }
 
@@ -1165,9 +1449,36 @@ IceInternal::ThreadPool::EventHandlerThread::setState(Ice::Instrumentation::Thre
     _state = s;
 }
 
+void
+IceInternal::ThreadPool::EventHandlerThread::workCompleted(IceUtil::Int64 queueDelay, IceUtil::Int64 serviceTime,
+                                                           int targetSize)
+{
+    // Must be called with the thread pool mutex locked
+    if(_metricsObserver)
+    {
+        _metricsObserver->workCompleted(queueDelay, serviceTime, targetSize);
+    }
+}
+
 void
 IceInternal::ThreadPool::EventHandlerThread::run()
 {
+#if defined(__linux)
+    if(_pool->_cpu >= 0)
+    {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(_pool->_cpu, &cpuset);
+        int rs = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+        if(rs != 0)
+        {
+            Warning out(_pool->_instance->initializationData().logger);
+            out << "unable to set the CPU affinity of thread `" << name() << "':\n"
+                << IceUtilInternal::errorToString(rs);
+        }
+    }
+#endif
+
 #ifdef ICE_CPP11_MAPPING
     if(_pool->_instance->initializationData().threadStart)
 #else
@@ -1249,7 +1560,8 @@ ThreadPoolCurrent::ThreadPoolCurrent(const InstancePtr& instance,
     _thread(thread),
     _ioCompleted(false)
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
-    , _leader(false)
+    , _leader(false),
+    _queueDelay(0)
 #endif
 {
 }
@@ -28,11 +28,13 @@
 
 #include <set>
 #include <list>
+#include <vector>
 
 namespace IceInternal
 {
 
 class ThreadPoolCurrent;
+class ThreadObserverI;
 
 class ThreadPoolWorkQueue;
 ICE_DEFINE_PTR(ThreadPoolWorkQueuePtr, ThreadPoolWorkQueue);
@@ -77,18 +79,20 @@ class ThreadPool : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mut
 
         void updateObserver();
         void setState(Ice::Instrumentation::ThreadState);
+        void workCompleted(IceUtil::Int64, IceUtil::Int64, int);
 
     private:
 
         ThreadPoolPtr _pool;
         ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+        ThreadObserverI* _metricsObserver; // The observer if it's a metrics observer, 0 otherwise.
         Ice::Instrumentation::ThreadState _state;
     };
     typedef IceUtil::Handle<EventHandlerThread> EventHandlerThreadPtr;
 
 public:
 
-    ThreadPool(const InstancePtr&, const std::string&, int);
+    ThreadPool(const InstancePtr&, const std::string&, int, int = 0, ThreadPool* = 0);
     virtual ~ThreadPool();
 
     void destroy();
@@ -115,9 +119,14 @@ public:
 
     std::string prefix() const;
 
+    ThreadPoolPtr nextShard();
+
+    bool overloaded();
+
 private:
 
     void run(const EventHandlerThreadPtr&);
+    bool shardsIdle();
 
     bool ioCompleted(ThreadPoolCurrent&);
 
@@ -127,6 +136,7 @@ private:
 #else
     void promoteFollower(ThreadPoolCurrent&);
     bool followerWait(ThreadPoolCurrent&);
+    void workCompleted(ThreadPoolCurrent&);
 #endif
 
     std::string nextThreadId();
@@ -157,6 +167,18 @@ private:
     const int _serverIdleTime;
     const int _threadIdleTime;
     const size_t _stackSize;
+    const int _shard; // The shard index, 0 for the thread pool itself.
+    const int _cpu; // The CPU the threads are bound to, -1 if not bound.
+
+    //
+    // The additional shards of a sharded thread pool. Each shard has its own
+    // selector and threads, connections are assigned to a shard with
+    // nextShard().
+    //
+    std::vector<ThreadPoolPtr> _shards;
+    ThreadPool* const _parent; // The first shard, 0 for the first shard itself.
+    size_t _nextShard;
+    bool _idle; // True if the selector timed out and no handler became ready since.
 
     std::set<EventHandlerThreadPtr> _threads; // All threads, running or not.
     int _inUse; // Number of threads that are currently in use.
@@ -167,6 +189,23 @@ private:
 #endif
 
     bool _promote;
+
+    //
+    // The thread pool size controller. With a target latency, the thread
+    // pool measures how long ready work waits for a thread (the queueing
+    // delay) and how long threads are busy with it (the service time), and
+    // sizes itself between Size and SizeMax to keep the queueing delay
+    // under the target latency.
+    //
+    const IceUtil::Int64 _targetLatency; // The target queueing delay in microseconds, 0 if disabled.
+    bool _measure; // True if the queueing delay and service time of work items are measured.
+    IceUtil::Time _readyTime; // The time when the handlers of the last select became ready.
+    IceUtil::Int64 _queueDelay; // The smoothed queueing delay in microseconds.
+    IceUtil::Int64 _serviceTime; // The smoothed service time in microseconds.
+    IceUtil::Time _sampleTime; // The start of the current sampling period.
+    int _sampleCount; // The number of work items completed during the current sampling period.
+    int _targetSize; // The number of threads needed to meet the target latency.
+    bool _overloaded; // True if the target latency can't be met with SizeMax threads.
 };
 
 class ThreadPoolCurrent
@@ -213,6 +252,8 @@ private:
     bool _ioCompleted;
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
     bool _leader;
+    IceUtil::Time _startTime;
+    IceUtil::Int64 _queueDelay;
 #else
     DWORD _count;
     int _error;
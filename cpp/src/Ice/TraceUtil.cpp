@@ -159,30 +159,65 @@ printHeader(ostream& s, InputStream& stream)
     stream.read(compress);
     s << "\ncompression status = "  << static_cast<int>(compress) << ' ';
 
-    switch(compress)
+    //
+    // The compression status of the validate connection message sent by
+    // the server is the set of compression codecs it supports.
+    //
+    if(type == validateConnectionMsg && compress != 0)
     {
-        case 0:
-        {
-            s << "(not compressed; do not compress response, if any)";
-            break;
-        }
-
-        case 1:
-        {
-            s << "(not compressed; compress response, if any)";
-            break;
-        }
-
-        case 2:
-        {
-            s << "(compressed; compress response, if any)";
-            break;
-        }
-
-        default:
+        s << "(supported compression codecs)";
+    }
+    else
+    {
+        switch(compress)
         {
-            s << "(unknown)";
-            break;
+            case 0:
+            {
+                s << "(not compressed; do not compress response, if any)";
+                break;
+            }
+
+            case 1:
+            {
+                s << "(not compressed; compress response, if any)";
+                break;
+            }
+
+            case 2:
+            {
+                s << "(compressed; compress response, if any)";
+                break;
+            }
+
+            case 3:
+            {
+                s << "(not compressed; compress response with lz4, if any)";
+                break;
+            }
+
+            case 4:
+            {
+                s << "(compressed with lz4; compress response with lz4, if any)";
+                break;
+            }
+
+            case 5:
+            {
+                s << "(not compressed; compress response with zstd, if any)";
+                break;
+            }
+
+            case 6:
+            {
+                s << "(compressed with zstd; compress response with zstd, if any)";
+                break;
+            }
+
+            default:
+            {
+                s << "(unknown)";
+                break;
+            }
         }
     }
 
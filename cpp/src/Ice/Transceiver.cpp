@@ -22,3 +22,8 @@ IceInternal::Transceiver::bind()
     return 0;
 }
 
+bool
+IceInternal::Transceiver::supportsGatherWrite() const
+{
+    return false;
+}
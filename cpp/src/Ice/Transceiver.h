@@ -47,6 +47,12 @@ public:
     virtual Ice::ConnectionInfoPtr getInfo() const = 0;
     virtual void checkSendSize(const Buffer&) = 0;
     virtual void setBufferSize(int, int) = 0;
+
+    //
+    // Returns true if write() supports buffers with segments, the segments
+    // are otherwise copied to the buffer before calling write().
+    //
+    virtual bool supportsGatherWrite() const;
 };
 
 }
@@ -440,6 +440,28 @@ public:
         return false;
     }
 
+    //
+    // Position the cursor on the first entry whose key is greater than
+    // or equal to the given key, the key and data of this entry are
+    // returned.
+    //
+    bool findRange(K& key, D& data)
+    {
+        unsigned char kbuf[maxKeySize];
+        MDB_val mkey = {maxKeySize, kbuf};
+        if(Codec<K, C, H>::write(key, mkey, _marshalingContext))
+        {
+            MDB_val mdata;
+            if(CursorBase::get(&mkey, &mdata, MDB_SET_RANGE))
+            {
+                Codec<K, C, H>::read(key, mkey, _marshalingContext);
+                Codec<D, C, H>::read(data, mdata, _marshalingContext);
+                return true;
+            }
+        }
+        return false;
+    }
+
 protected:
 
     C _marshalingContext;
@@ -17,6 +17,7 @@
 #include <IceGrid/UserAccountMapper.h>
 #include <IceGrid/FileCache.h>
 #include <set>
+#include <deque>
 
 namespace IceGrid
 {
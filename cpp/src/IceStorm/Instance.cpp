@@ -12,7 +12,9 @@
 #include <IceStorm/Observers.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/InstrumentationI.h>
+#include <IceStorm/Subscriber.h>
 #include <IceUtil/Timer.h>
+#include <IceUtil/FileUtil.h>
 
 #include <Ice/InstrumentationI.h>
 #include <Ice/Communicator.h>
@@ -56,10 +58,28 @@ PersistentInstance::PersistentInstance(
     Instance(instanceName, name, communicator, publishAdapter, topicAdapter, nodeAdapter, nodeProxy),
     _dbLock(communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name) + "/icedb.lock"),
     _dbEnv(communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name), 2,
-           IceDB::getMapSize(communicator->getProperties()->getPropertyAsInt(name + ".LMDB.MapSize")))
+           IceDB::getMapSize(communicator->getProperties()->getPropertyAsInt(name + ".LMDB.MapSize"))),
+    _eventLogAllTopics(false),
+    _eventLogMaxEvents(communicator->getProperties()->getPropertyAsIntWithDefault(name + ".EventLog.MaxEvents", 10000)),
+    _eventLogMaxSize(static_cast<Ice::Long>(
+                         communicator->getProperties()->getPropertyAsInt(name + ".EventLog.MaxSize")) * 1024),
+    _eventLogMaxAge(IceUtil::Time::seconds(communicator->getProperties()->getPropertyAsInt(name + ".EventLog.MaxAge")))
 {
     try
     {
+        Ice::StringSeq topics = communicator->getProperties()->getPropertyAsList(name + ".EventLog.Topics");
+        for(Ice::StringSeq::const_iterator p = topics.begin(); p != topics.end(); ++p)
+        {
+            if(*p == "*")
+            {
+                _eventLogAllTopics = true;
+            }
+            else
+            {
+                _eventLogTopics.insert(*p);
+            }
+        }
+
         dbContext.communicator = communicator;
         dbContext.encoding.minor = 1;
         dbContext.encoding.major = 1;
@@ -70,6 +90,26 @@ PersistentInstance::PersistentInstance(
         _subscriberMap = SubscriberMap(txn, "subscribers", dbContext, MDB_CREATE, compareSubscriberRecordKey);
 
         txn.commit();
+
+        if(_eventLogAllTopics || !_eventLogTopics.empty())
+        {
+            string path = communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name) +
+                "/events";
+            if(!IceUtilInternal::directoryExists(path) && IceUtilInternal::mkdir(path, 0777) != 0)
+            {
+                Ice::FileException ex(__FILE__, __LINE__);
+                ex.path = path;
+                ex.error = IceInternal::getSystemErrno();
+                throw ex;
+            }
+            _eventLogEnv.reset(new IceDB::Env(path, 1, IceDB::getMapSize(
+                                                  communicator->getProperties()->getPropertyAsInt(
+                                                      name + ".EventLog.MapSize"))));
+
+            IceDB::ReadWriteTxn eventLogTxn(*_eventLogEnv);
+            _eventMap = EventMap(eventLogTxn, "events", dbContext, MDB_CREATE);
+            eventLogTxn.commit();
+        }
     }
     catch(...)
     {
@@ -80,10 +120,20 @@ PersistentInstance::PersistentInstance(
     }
 }
 
+bool
+PersistentInstance::eventLogEnabled(const string& topic) const
+{
+    return _eventLogAllTopics || _eventLogTopics.find(topic) != _eventLogTopics.end();
+}
+
 void
 PersistentInstance::destroy()
 {
     _dbEnv.close();
+    if(_eventLogEnv.get())
+    {
+        _eventLogEnv->close();
+    }
     dbContext.communicator = 0;
 
     Instance::destroy();
@@ -136,6 +186,9 @@ Instance::Instance(
         _observers = new Observers(this);
         _batchFlusher = new IceUtil::Timer();
         _timer = new IceUtil::Timer();
+        _fanOutPool = new FanOutPool(_traceLevels->logger,
+                                     properties->getPropertyAsIntWithDefault(name + ".FanOut.Size", 0),
+                                     properties->getPropertyAsIntWithDefault(name + ".FanOut.ShardSize", 64));
 
         string policy = properties->getProperty(name + ".Send.QueueSizeMaxPolicy");
         if(policy == "RemoveSubscriber")
@@ -263,6 +316,12 @@ Instance::timer() const
     return _timer;
 }
 
+FanOutPoolPtr
+Instance::fanOutPool() const
+{
+    return _fanOutPool;
+}
+
 Ice::ObjectPrx
 Instance::topicReplicaProxy() const
 {
@@ -334,6 +393,11 @@ Instance::shutdown()
     {
         _timer->destroy();
     }
+
+    if(_fanOutPool)
+    {
+        _fanOutPool->destroy();
+    }
 }
 
 void
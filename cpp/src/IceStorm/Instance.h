@@ -15,10 +15,13 @@
 #include <Ice/ObjectAdapterF.h>
 #include <Ice/PropertiesF.h>
 #include <IceUtil/Time.h>
+#include <IceUtil/UniquePtr.h>
 #include <IceStorm/Election.h>
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Util.h>
 
+#include <set>
+
 namespace IceUtil
 {
 
@@ -44,6 +47,9 @@ namespace IceStorm
 class TraceLevels;
 typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
 
+class FanOutPool;
+typedef IceUtil::Handle<FanOutPool> FanOutPoolPtr;
+
 class TopicReaper : public IceUtil::Shared, private IceUtil::Mutex
 {
 public:
@@ -86,6 +92,7 @@ public:
     TraceLevelsPtr traceLevels() const;
     IceUtil::TimerPtr batchFlusher() const;
     IceUtil::TimerPtr timer() const;
+    FanOutPoolPtr fanOutPool() const;
     Ice::ObjectPrx topicReplicaProxy() const;
     Ice::ObjectPrx publisherReplicaProxy() const;
     IceStorm::Instrumentation::TopicManagerObserverPtr observer() const;
@@ -122,6 +129,7 @@ private:
     IceStormElection::ObserversPtr _observers;
     IceUtil::TimerPtr _batchFlusher;
     IceUtil::TimerPtr _timer;
+    FanOutPoolPtr _fanOutPool;
     IceStorm::Instrumentation::TopicManagerObserverPtr _observer;
 
 
@@ -130,6 +138,8 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 
 typedef IceDB::ReadWriteCursor<SubscriberRecordKey, SubscriberRecord, IceDB::IceContext, Ice::OutputStream>
         SubscriberMapRWCursor;
+typedef IceDB::ReadWriteCursor<EventRecordKey, EventRecord, IceDB::IceContext, Ice::OutputStream> EventMapRWCursor;
+typedef IceDB::ReadOnlyCursor<EventRecordKey, EventRecord, IceDB::IceContext, Ice::OutputStream> EventMapROCursor;
 
 class PersistentInstance : public Instance
 {
@@ -143,6 +153,21 @@ public:
     LLUMap lluMap() const { return _lluMap; }
     SubscriberMap subscriberMap() const { return _subscriberMap; }
 
+    //
+    // The event log configuration. Events published on the topics
+    // listed by the EventLog.Topics property are recorded in the
+    // event map and can be replayed to new subscribers. The event map
+    // is stored in its own LMDB environment, in the events directory
+    // of the database, so that a full event log doesn't prevent the
+    // updates of the subscriber records.
+    //
+    const IceDB::Env& eventLogEnv() const { return *_eventLogEnv; }
+    EventMap eventMap() const { return _eventMap; }
+    bool eventLogEnabled(const std::string&) const;
+    int eventLogMaxEvents() const { return _eventLogMaxEvents; }
+    Ice::Long eventLogMaxSize() const { return _eventLogMaxSize; }
+    IceUtil::Time eventLogMaxAge() const { return _eventLogMaxAge; }
+
     virtual void destroy();
 
 private:
@@ -151,6 +176,13 @@ private:
     IceDB::Env _dbEnv;
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
+    IceUtil::UniquePtr<IceDB::Env> _eventLogEnv;
+    EventMap _eventMap;
+    std::set<std::string> _eventLogTopics;
+    bool _eventLogAllTopics;
+    int _eventLogMaxEvents;
+    Ice::Long _eventLogMaxSize;
+    IceUtil::Time _eventLogMaxAge;
 };
 typedef IceUtil::Handle<PersistentInstance> PersistentInstancePtr;
 
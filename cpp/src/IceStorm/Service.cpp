@@ -320,6 +320,17 @@ ServiceI::start(
             throw IceBox::FailureException(__FILE__, __LINE__, "Replication requires at least 3 Nodes");
         }
 
+        //
+        // The event log offsets are assigned by each replica and the
+        // replicas don't replicate their event log.
+        //
+        if(!properties->getProperty(name + ".EventLog.Topics").empty())
+        {
+            Ice::Error error(communicator->getLogger());
+            error << "The event log is not supported with replication";
+            throw IceBox::FailureException(__FILE__, __LINE__, "The event log is not supported with replication");
+        }
+
         try
         {
             // If the node thread pool size is not set then initialize
@@ -538,8 +549,15 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "Send.QueueSizeMax",
         "Send.QueueSizeMaxPolicy",
         "Discard.Interval",
+        "FanOut.Size",
+        "FanOut.ShardSize",
         "LMDB.Path",
-        "LMDB.MapSize"
+        "LMDB.MapSize",
+        "EventLog.Topics",
+        "EventLog.MaxEvents",
+        "EventLog.MaxSize",
+        "EventLog.MaxAge",
+        "EventLog.MapSize"
     };
 
     vector<string> unknownProps;
@@ -13,6 +13,8 @@
 #include <IceStorm/NodeI.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
+#include <Ice/OutgoingAsync.h>
+#include <IceUtil/StringUtil.h>
 #include <iterator>
 
 using namespace std;
@@ -96,6 +98,43 @@ toSubscriberState(Subscriber::SubscriberState s)
     }
 }
 
+const string iceInvokeName = "ice_invoke";
+
+//
+// The maximum number of replayed events queued at once.
+//
+const int replayChunkSize = 100;
+
+//
+// Send the event to the given subscriber proxy, this is equivalent to
+// begin_ice_invoke except that the request references the event data
+// instead of copying it. The event data is immutable once queued so the
+// requests sent to all the subscribers of the topic share the same data.
+//
+Ice::AsyncResultPtr
+invokeEvent(const Ice::ObjectPrx& obj, const EventDataPtr& event, const IceInternal::CallbackBasePtr& cb)
+{
+    IceInternal::OutgoingAsyncPtr result = new IceInternal::CallbackOutgoing(obj, iceInvokeName, cb, 0, false);
+    try
+    {
+        result->prepare(event->op, event->mode, event->context);
+        if(event->data.empty())
+        {
+            result->writeParamEncaps(0, 0);
+        }
+        else
+        {
+            result->writeParamEncaps(&event->data[0], static_cast<Ice::Int>(event->data.size()), event);
+        }
+        result->invoke(event->op);
+    }
+    catch(const Ice::Exception& ex)
+    {
+        result->abort(ex);
+    }
+    return result;
+}
+
 }
 
 // Each of the various Subscriber types.
@@ -152,13 +191,20 @@ class SubscriberTwoway : public Subscriber
 public:
 
     SubscriberTwoway(const InstancePtr&, const SubscriberRecord&, const Ice::ObjectPrx&, int, int,
-                     const Ice::ObjectPrx&);
+                     const Ice::ObjectPrx&, bool);
 
     virtual void flush();
 
+    void connected(const Ice::ConnectionPtr&);
+    void exception(const Ice::Exception&);
+    void completedFixed(const Ice::AsyncResultPtr&);
+
 private:
 
     const Ice::ObjectPrx _obj;
+    const bool _fixed; // Whether the events are sent over a fixed connection.
+    Ice::ObjectPrx _fixedObj; // The subscriber proxy bound to the connection, if established.
+    bool _connecting;
 };
 
 class SubscriberLink : public Subscriber
@@ -338,13 +384,13 @@ SubscriberOneway::flush()
     //
     // If the subscriber isn't online we're done.
     //
-    if(_state != SubscriberStateOnline || _events.empty())
+    if(_state != SubscriberStateOnline || !nextEvents())
     {
         return;
     }
 
     // Send up to _maxOutstanding pending events.
-    while(_outstanding < _maxOutstanding && !_events.empty())
+    while(_outstanding < _maxOutstanding && nextEvents())
     {
         //
         // Dequeue the head event, count one more outstanding AMI
@@ -359,8 +405,8 @@ SubscriberOneway::flush()
 
         try
         {
-            Ice::AsyncResultPtr result = _obj->begin_ice_invoke(
-                e->op, e->mode, e->data, e->context, Ice::newCallback_Object_ice_invoke(this,
+            Ice::AsyncResultPtr result = invokeEvent(_obj, e,
+                                                     Ice::newCallback_Object_ice_invoke(this,
                                                                                         &SubscriberOneway::exception,
                                                                                         &SubscriberOneway::sent));
             if(!result->sentSynchronously())
@@ -407,7 +453,7 @@ SubscriberOneway::sent(bool sentSynchronously)
     {
         _lock.notify();
     }
-    else if(_outstanding <= 0 && !_events.empty())
+    else if(_outstanding <= 0 && nextEvents())
     {
         flush();
     }
@@ -419,9 +465,12 @@ SubscriberTwoway::SubscriberTwoway(
     const Ice::ObjectPrx& proxy,
     int retryCount,
     int maxOutstanding,
-    const Ice::ObjectPrx& obj) :
+    const Ice::ObjectPrx& obj,
+    bool fixed) :
     Subscriber(instance, rec, proxy, retryCount, maxOutstanding),
-    _obj(obj)
+    _obj(obj),
+    _fixed(fixed),
+    _connecting(false)
 {
 }
 
@@ -433,13 +482,40 @@ SubscriberTwoway::flush()
     //
     // If the subscriber isn't online we're done.
     //
-    if(_state != SubscriberStateOnline || _events.empty())
+    if(_state != SubscriberStateOnline || !nextEvents())
     {
         return;
     }
 
+    //
+    // Ordered events sent with a window larger than 1 must all be sent
+    // over the same connection, which sends them in order. Otherwise,
+    // the proxy could send them over different connections. The
+    // connection is established before sending the events and again
+    // after a failure.
+    //
+    if(_fixed && !_fixedObj)
+    {
+        if(!_connecting)
+        {
+            _connecting = true;
+            try
+            {
+                _obj->begin_ice_getConnection(Ice::newCallback_Object_ice_getConnection(this,
+                                                                                        &SubscriberTwoway::connected,
+                                                                                        &SubscriberTwoway::exception));
+            }
+            catch(const Ice::Exception& ex)
+            {
+                _connecting = false;
+                error(false, ex);
+            }
+        }
+        return;
+    }
+
     // Send up to _maxOutstanding pending events.
-    while(_outstanding < _maxOutstanding && !_events.empty())
+    while(_outstanding < _maxOutstanding && nextEvents())
     {
         //
         // Dequeue the head event, count one more outstanding AMI
@@ -455,8 +531,14 @@ SubscriberTwoway::flush()
 
         try
         {
-            _obj->begin_ice_invoke(e->op, e->mode, e->data, e->context,
-                                   Ice::newCallback(static_cast<Subscriber*>(this), &Subscriber::completed));
+            if(_fixed)
+            {
+                invokeEvent(_fixedObj, e, Ice::newCallback(this, &SubscriberTwoway::completedFixed));
+            }
+            else
+            {
+                invokeEvent(_obj, e, Ice::newCallback(static_cast<Subscriber*>(this), &Subscriber::completed));
+            }
         }
         catch(const Ice::Exception& ex)
         {
@@ -466,6 +548,59 @@ SubscriberTwoway::flush()
     }
 }
 
+void
+SubscriberTwoway::connected(const Ice::ConnectionPtr& connection)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+
+    _connecting = false;
+    try
+    {
+        //
+        // A collocated subscriber doesn't have a connection.
+        //
+        _fixedObj = connection ? connection->createProxy(_obj->ice_getIdentity())->ice_facet(_obj->ice_getFacet()) :
+            _obj;
+    }
+    catch(const Ice::Exception& ex)
+    {
+        error(false, ex);
+        return;
+    }
+    flush();
+}
+
+void
+SubscriberTwoway::exception(const Ice::Exception& ex)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+
+    _connecting = false;
+    error(false, ex);
+}
+
+void
+SubscriberTwoway::completedFixed(const Ice::AsyncResultPtr& result)
+{
+    try
+    {
+        result->throwLocalException();
+    }
+    catch(const Ice::LocalException&)
+    {
+        //
+        // Establish the connection again once the subscriber is back
+        // online, unless it's already established again.
+        //
+        IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+        if(result->getProxy() == _fixedObj)
+        {
+            _fixedObj = 0;
+        }
+    }
+    completed(result);
+}
+
 namespace
 {
 
@@ -531,6 +666,63 @@ SubscriberLink::flush()
 
 }
 
+EventFilterPtr
+EventFilter::create(const QoS& qos)
+{
+    EventFilterPtr filter;
+    for(QoS::const_iterator p = qos.begin(); p != qos.end(); ++p)
+    {
+        if(p->first.compare(0, 7, "filter.") != 0)
+        {
+            continue;
+        }
+
+        vector<string> values;
+        if(!IceUtilInternal::splitString(p->second, ", \t", values) || values.empty())
+        {
+            throw BadQoS("invalid " + p->first + ": " + p->second);
+        }
+
+        if(!filter)
+        {
+            filter = new EventFilter;
+        }
+
+        if(p->first == "filter.operation")
+        {
+            filter->_operations.insert(values.begin(), values.end());
+        }
+        else if(p->first.compare(0, 15, "filter.context.") == 0 && p->first.size() > 15)
+        {
+            filter->_context[p->first.substr(15)].insert(values.begin(), values.end());
+        }
+        else
+        {
+            throw BadQoS("unknown filter: " + p->first);
+        }
+    }
+    return filter;
+}
+
+bool
+EventFilter::matches(const EventDataPtr& event) const
+{
+    if(!_operations.empty() && _operations.find(event->op) == _operations.end())
+    {
+        return false;
+    }
+
+    for(map<string, set<string> >::const_iterator p = _context.begin(); p != _context.end(); ++p)
+    {
+        Ice::Context::const_iterator q = event->context.find(p->first);
+        if(q == event->context.end() || p->second.find(q->second) == p->second.end())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 SubscriberPtr
 Subscriber::create(
     const InstancePtr& instance,
@@ -571,6 +763,21 @@ Subscriber::create(
                 throw BadQoS("invalid reliability: " + reliability);
             }
 
+            //
+            // The window is the maximum number of events sent to a
+            // twoway subscriber and not yet acknowledged.
+            //
+            int window = 0;
+            p = rec.theQoS.find("window");
+            if(p != rec.theQoS.end())
+            {
+                window = atoi(p->second.c_str());
+                if(window < 1)
+                {
+                    throw BadQoS("invalid window: " + p->second);
+                }
+            }
+
             //
             // Override the timeout.
             //
@@ -594,7 +801,15 @@ Subscriber::create(
                 {
                     throw BadQoS("ordered reliability requires a twoway proxy");
                 }
-                subscriber = new SubscriberTwoway(instance, rec, proxy, retryCount, 1, newObj);
+
+                //
+                // Without a window, an ordered subscriber waits for the
+                // response to an event before sending the next one. With
+                // a window, the events are pipelined on a connection bound
+                // to the subscriber, which sends them in order.
+                //
+                subscriber = new SubscriberTwoway(instance, rec, proxy, retryCount, window > 0 ? window : 1, newObj,
+                                                  window > 1);
             }
             else if(newObj->ice_isOneway() || newObj->ice_isDatagram())
             {
@@ -602,6 +817,10 @@ Subscriber::create(
                 {
                     throw BadQoS("non-zero retryCount QoS requires a twoway proxy");
                 }
+                if(window > 0)
+                {
+                    throw BadQoS("window QoS requires a twoway proxy");
+                }
                 subscriber = new SubscriberOneway(instance, rec, proxy, retryCount, newObj);
             }
             else if(newObj->ice_isBatchOneway() || newObj->ice_isBatchDatagram())
@@ -610,12 +829,17 @@ Subscriber::create(
                 {
                     throw BadQoS("non-zero retryCount QoS requires a twoway proxy");
                 }
+                if(window > 0)
+                {
+                    throw BadQoS("window QoS requires a twoway proxy");
+                }
                 subscriber = new SubscriberBatch(instance, rec, proxy, retryCount, newObj);
             }
             else //if(newObj->ice_isTwoway())
             {
                 assert(newObj->ice_isTwoway());
-                subscriber = new SubscriberTwoway(instance, rec, proxy, retryCount, 5, newObj);
+                subscriber = new SubscriberTwoway(instance, rec, proxy, retryCount, window > 0 ? window : 5, newObj,
+                                                  false);
             }
             per->setSubscriber(subscriber);
         }
@@ -652,6 +876,12 @@ Subscriber::record() const
     return _rec;
 }
 
+EventFilterPtr
+Subscriber::filter() const
+{
+    return _filter;
+}
+
 bool
 Subscriber::queue(bool forwarded, const EventDataSeq& events)
 {
@@ -674,6 +904,24 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
             break;
         }
 
+        //
+        // The subscriber stays offline if its filter rejects all the
+        // events, it would otherwise be back online without sending
+        // any event to find out if it's reachable again.
+        //
+        if(_filter)
+        {
+            EventDataSeq::const_iterator p = events.begin();
+            while(p != events.end() && !_filter->matches(*p))
+            {
+                ++p;
+            }
+            if(p == events.end())
+            {
+                break;
+            }
+        }
+
         //
         // State transition to online.
         //
@@ -683,9 +931,21 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
 
     case SubscriberStateOnline:
     {
+        //
+        // The events queued during a replay are deferred until the
+        // replay completes.
+        //
+        EventDataSeq& pending = _replay ? _deferred : _events;
+
+        Ice::Int queued = 0;
         for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
         {
-            if(static_cast<int>(_events.size()) == _instance->sendQueueSizeMax())
+            if(_filter && !_filter->matches(*p))
+            {
+                continue;
+            }
+
+            if(static_cast<int>(pending.size()) == _instance->sendQueueSizeMax())
             {
                 if(_instance->sendQueueSizeMaxPolicy() == Instance::RemoveSubscriber)
                 {
@@ -694,15 +954,21 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
                 }
                 else // DropEvents
                 {
-                    _events.pop_front();
+                    pending.pop_front();
                 }
             }
-            _events.push_back(*p);
+            pending.push_back(*p);
+            ++queued;
+        }
+
+        if(queued == 0)
+        {
+            break;
         }
 
         if(_observer)
         {
-            _observer->queued(static_cast<Ice::Int>(events.size()));
+            _observer->queued(queued);
         }
         flush();
         break;
@@ -717,6 +983,25 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
     return true;
 }
 
+void
+Subscriber::replay(const EventReplayPtr& replay)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+
+    assert(!_replay);
+    if(_state >= SubscriberStateError)
+    {
+        return;
+    }
+
+    _replay = replay;
+    _deferred.swap(_events);
+    if(_state == SubscriberStateOnline)
+    {
+        flush();
+    }
+}
+
 bool
 Subscriber::reap()
 {
@@ -858,12 +1143,16 @@ Subscriber::error(bool dec, const Ice::Exception& e)
         _next = now + _instance->discardInterval();
         ++_currentRetry;
         _events.clear();
+        _replay = 0;
+        _deferred.clear();
         setState(SubscriberStateOffline);
     }
     // Errored out.
     else if(_state < SubscriberStateError)
     {
         _events.clear();
+        _replay = 0;
+        _deferred.clear();
         setState(SubscriberStateError);
 
         TraceLevelsPtr traceLevels = _instance->traceLevels();
@@ -967,6 +1256,7 @@ Subscriber::Subscriber(
     _maxOutstanding(maxOutstanding),
     _proxy(proxy),
     _proxyReplica(proxy),
+    _filter(EventFilter::create(rec.theQoS)),
     _shutdown(false),
     _state(SubscriberStateOnline),
     _outstanding(0),
@@ -1014,6 +1304,52 @@ stateToString(Subscriber::SubscriberState state)
 
 }
 
+bool
+Subscriber::nextEvents()
+{
+    //
+    // The replayed events are read in chunks no larger than the maximum
+    // size of the send queue.
+    //
+    while(_events.empty() && _replay)
+    {
+        int max = _instance->sendQueueSizeMax();
+        EventDataSeq events;
+        bool more = false;
+        try
+        {
+            more = _replay->read(events, max > 0 ? min(max, replayChunkSize) : replayChunkSize);
+        }
+        catch(const std::exception& ex)
+        {
+            Ice::Warning warn(_instance->traceLevels()->logger);
+            warn << "unexpected exception while replaying events:\n" << ex;
+        }
+
+        Ice::Int queued = 0;
+        for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+        {
+            if(!_filter || _filter->matches(*p))
+            {
+                _events.push_back(*p);
+                ++queued;
+            }
+        }
+        if(queued > 0 && _observer)
+        {
+            _observer->queued(queued);
+        }
+
+        if(!more)
+        {
+            _replay = 0;
+            _events.insert(_events.end(), _deferred.begin(), _deferred.end());
+            _deferred.clear();
+        }
+    }
+    return !_events.empty();
+}
+
 void
 Subscriber::setState(Subscriber::SubscriberState state)
 {
@@ -1041,6 +1377,312 @@ Subscriber::setState(Subscriber::SubscriberState state)
     }
 }
 
+SubscriberList::SubscriberList() :
+    _indexed(false)
+{
+}
+
+void
+SubscriberList::index()
+{
+    if(_indexed)
+    {
+        return;
+    }
+
+    for(vector<SubscriberPtr>::const_iterator p = subscribers.begin(); p != subscribers.end(); ++p)
+    {
+        EventFilterPtr filter = (*p)->filter();
+        if(!filter)
+        {
+            _unfiltered.push_back(*p);
+            continue;
+        }
+
+        //
+        // Index the subscriber with the values of the first context
+        // predicate or with its operations. The other predicates are
+        // checked when the events are queued.
+        //
+        const set<string>* values;
+        SubscriberIndex* index;
+        if(!filter->context().empty())
+        {
+            values = &filter->context().begin()->second;
+            index = &_context[filter->context().begin()->first];
+        }
+        else
+        {
+            values = &filter->operations();
+            index = &_operations;
+        }
+        for(set<string>::const_iterator q = values->begin(); q != values->end(); ++q)
+        {
+            (*index)[*q].push_back(*p);
+        }
+    }
+    _indexed = true;
+}
+
+SubscriberListPtr
+SubscriberList::select(const EventDataSeq& events)
+{
+    assert(_indexed);
+    if(_unfiltered.size() == subscribers.size())
+    {
+        return this;
+    }
+
+    vector<SubscriberPtr> selected;
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        SubscriberIndex::const_iterator q = _operations.find((*p)->op);
+        if(q != _operations.end())
+        {
+            selected.insert(selected.end(), q->second.begin(), q->second.end());
+        }
+
+        for(map<string, SubscriberIndex>::const_iterator r = _context.begin(); r != _context.end(); ++r)
+        {
+            Ice::Context::const_iterator value = (*p)->context.find(r->first);
+            if(value != (*p)->context.end())
+            {
+                q = r->second.find(value->second);
+                if(q != r->second.end())
+                {
+                    selected.insert(selected.end(), q->second.begin(), q->second.end());
+                }
+            }
+        }
+    }
+
+    if(events.size() > 1)
+    {
+        sort(selected.begin(), selected.end());
+        selected.erase(unique(selected.begin(), selected.end()), selected.end());
+    }
+
+    SubscriberListPtr list = new SubscriberList;
+    list->subscribers.reserve(_unfiltered.size() + selected.size());
+    list->subscribers.insert(list->subscribers.end(), _unfiltered.begin(), _unfiltered.end());
+    list->subscribers.insert(list->subscribers.end(), selected.begin(), selected.end());
+    return list;
+}
+
+vector<SubscriberPtr>&
+IceStorm::modifySubscribers(SubscriberListPtr& list)
+{
+    //
+    // The reference count of the list can only be increased by the
+    // topic, with the topic locked, so the list isn't shared if the
+    // topic holds the only reference.
+    //
+    if(list->__getRef() > 1)
+    {
+        SubscriberListPtr copy = new SubscriberList;
+        copy->subscribers = list->subscribers;
+        list = copy;
+    }
+    else if(list->_indexed)
+    {
+        list->_indexed = false;
+        list->_unfiltered.clear();
+        list->_operations.clear();
+        list->_context.clear();
+    }
+    return list->subscribers;
+}
+
+FanOutPool::FanOutThread::FanOutThread(FanOutPool* pool) :
+    IceUtil::Thread("IceStorm fan-out thread"),
+    _pool(pool)
+{
+}
+
+void
+FanOutPool::FanOutThread::run()
+{
+    _pool->run();
+}
+
+FanOutPool::FanOutPool(const Ice::LoggerPtr& logger, int size, int shardSize) :
+    _logger(logger),
+    _shardSize(static_cast<size_t>(max(shardSize, 1))),
+    _destroyed(false)
+{
+    try
+    {
+        for(int i = 0; i < size; ++i)
+        {
+            IceUtil::ThreadPtr thread = new FanOutThread(this);
+            thread->start();
+            _threads.push_back(thread);
+        }
+    }
+    catch(...)
+    {
+        destroy();
+        throw;
+    }
+}
+
+void
+FanOutPool::publish(const SubscriberListPtr& list, bool forwarded, const EventDataSeq& events,
+                    Ice::IdentitySeq& reap)
+{
+    const vector<SubscriberPtr>& subscribers = list->subscribers;
+    if(subscribers.empty())
+    {
+        return;
+    }
+
+    //
+    // The list is shared with the topic until we return so the
+    // subscribers can be referenced by the queued shards.
+    //
+    Shard first;
+    first.begin = &subscribers[0];
+    first.end = first.begin + subscribers.size();
+    first.forwarded = forwarded;
+    first.events = &events;
+    first.batch = 0;
+
+    Batch batch;
+    batch.pending = 0;
+    if(subscribers.size() > _shardSize)
+    {
+        Lock sync(*this);
+        if(!_destroyed && !_threads.empty())
+        {
+            //
+            // Queue all the shards but the first one which is processed
+            // by this thread.
+            //
+            Shard shard = first;
+            shard.batch = &batch;
+            for(shard.begin = first.begin + _shardSize; shard.begin < first.end; shard.begin = shard.end)
+            {
+                shard.end = shard.begin + min(_shardSize, static_cast<size_t>(first.end - shard.begin));
+                _shards.push_back(shard);
+                ++batch.pending;
+            }
+            first.end = first.begin + _shardSize;
+            notifyAll();
+        }
+    }
+
+    process(first, reap);
+
+    if(first.end != &subscribers[0] + subscribers.size())
+    {
+        Lock sync(*this);
+        while(batch.pending > 0)
+        {
+            //
+            // Process the shards of this batch which are still queued
+            // instead of waiting for the pool threads to process them.
+            //
+            deque<Shard>::iterator p = _shards.begin();
+            while(p != _shards.end() && p->batch != &batch)
+            {
+                ++p;
+            }
+
+            if(p != _shards.end())
+            {
+                Shard shard = *p;
+                _shards.erase(p);
+                sync.release();
+                process(shard, reap);
+                sync.acquire();
+                --batch.pending;
+            }
+            else
+            {
+                wait();
+            }
+        }
+        reap.insert(reap.end(), batch.reap.begin(), batch.reap.end());
+    }
+}
+
+void
+FanOutPool::destroy()
+{
+    vector<IceUtil::ThreadPtr> threads;
+    {
+        Lock sync(*this);
+        _destroyed = true;
+        notifyAll();
+        threads.swap(_threads);
+    }
+
+    //
+    // The shards still queued are processed by the publishing threads.
+    //
+    for(vector<IceUtil::ThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+}
+
+void
+FanOutPool::run()
+{
+    Lock sync(*this);
+    while(true)
+    {
+        while(_shards.empty() && !_destroyed)
+        {
+            wait();
+        }
+
+        if(_destroyed)
+        {
+            return;
+        }
+
+        Shard shard = _shards.front();
+        _shards.pop_front();
+
+        sync.release();
+        Ice::IdentitySeq reap;
+        process(shard, reap);
+        sync.acquire();
+
+        shard.batch->reap.insert(shard.batch->reap.end(), reap.begin(), reap.end());
+        if(--shard.batch->pending == 0)
+        {
+            notifyAll();
+        }
+    }
+}
+
+void
+FanOutPool::process(const Shard& shard, Ice::IdentitySeq& reap)
+{
+    for(const SubscriberPtr* p = shard.begin; p != shard.end; ++p)
+    {
+        //
+        // Queuing events doesn't raise exceptions, subscriber errors are
+        // reported through the subscriber state. We don't let unexpected
+        // exceptions escape as the batch could still have queued shards.
+        //
+        try
+        {
+            if(!(*p)->queue(shard.forwarded, *shard.events) && (*p)->reap())
+            {
+                reap.push_back((*p)->id());
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            Ice::Warning warn(_logger);
+            warn << "unexpected exception while queuing events:\n" << ex;
+        }
+    }
+}
+
 bool
 IceStorm::operator==(const SubscriberPtr& subscriber, const Ice::Identity& id)
 {
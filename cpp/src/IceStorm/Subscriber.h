@@ -15,6 +15,10 @@
 #include <IceStorm/Instrumentation.h>
 #include <Ice/ObserverHelper.h>
 #include <IceUtil/RecMutex.h>
+#include <IceUtil/Thread.h>
+#include <deque>
+#include <map>
+#include <set>
 
 namespace IceStorm
 {
@@ -25,6 +29,56 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class EventFilter;
+typedef IceUtil::Handle<EventFilter> EventFilterPtr;
+
+//
+// The content filter of a subscriber, compiled from the subscriber
+// QoS. The filter.operation QoS is the list of accepted operations and
+// each filter.context.<key> QoS the list of accepted values for the
+// context entry <key>. An event is accepted if it matches all the
+// predicates.
+//
+class EventFilter : public IceUtil::Shared
+{
+public:
+
+    //
+    // Returns a null filter if the QoS doesn't specify a filter,
+    // throws BadQoS if the filter is invalid.
+    //
+    static EventFilterPtr create(const IceStorm::QoS&);
+
+    bool matches(const EventDataPtr&) const;
+
+    const std::set<std::string>& operations() const { return _operations; }
+    const std::map<std::string, std::set<std::string> >& context() const { return _context; }
+
+private:
+
+    std::set<std::string> _operations; // The accepted operations, empty if any operation is accepted.
+    std::map<std::string, std::set<std::string> > _context; // The accepted values of each context key.
+};
+
+class EventReplay;
+typedef IceUtil::Handle<EventReplay> EventReplayPtr;
+
+//
+// The logged events replayed to a subscriber. The subscriber reads the
+// events in chunks as it sends them instead of queuing all of them at
+// once.
+//
+class EventReplay : public IceUtil::Shared
+{
+public:
+
+    //
+    // Adds at most the given number of events to the sequence, returns
+    // false once all the events are read.
+    //
+    virtual bool read(EventDataSeq&, int) = 0;
+};
+
 class Subscriber : public IceUtil::Shared
 {
 public:
@@ -36,9 +90,17 @@ public:
     Ice::ObjectPrx proxy() const; // Get the per subscriber object.
     Ice::Identity id() const; // Return the id of the subscriber.
     IceStorm::SubscriberRecord record() const; // Get the subscriber record.
+    EventFilterPtr filter() const; // Get the content filter, null if events aren't filtered.
 
     // Returns false if the subscriber should be reaped.
     bool queue(bool, const EventDataSeq&);
+
+    //
+    // Replay the given events before the events queued from now on,
+    // which are deferred until the replay completes.
+    //
+    void replay(const EventReplayPtr&);
+
     bool reap();
     void resetIfReaped();
     bool errored() const;
@@ -67,6 +129,13 @@ protected:
 
     void setState(SubscriberState);
 
+    //
+    // Returns true if there are events to send. If the queue is empty,
+    // the next replayed events are queued first. Must be called with
+    // _lock locked.
+    //
+    bool nextEvents();
+
     Subscriber(const InstancePtr&, const IceStorm::SubscriberRecord&, const Ice::ObjectPrx&, int, int);
 
     // Immutable
@@ -76,6 +145,7 @@ protected:
     const int _maxOutstanding; // The maximum number of oustanding events.
     const Ice::ObjectPrx _proxy; // The per subscriber object proxy, if any.
     const Ice::ObjectPrx _proxyReplica; // The replicated per subscriber object proxy, if any.
+    const EventFilterPtr _filter; // The content filter, if any.
 
     IceUtil::Monitor<IceUtil::RecMutex> _lock;
 
@@ -86,6 +156,8 @@ protected:
     int _outstanding; // The current number of outstanding responses.
     int _outstandingCount; // The current number of outstanding events when batching events (only used for metrics).
     EventDataSeq _events; // The queue of events to send.
+    EventReplayPtr _replay; // The events to replay, if any.
+    EventDataSeq _deferred; // The events queued during the replay.
 
     // The next time to try sending a new event if we're offline.
     IceUtil::Time _next;
@@ -94,6 +166,117 @@ protected:
     IceInternal::ObserverHelperT<IceStorm::Instrumentation::SubscriberObserver> _observer;
 };
 
+class SubscriberList;
+typedef IceUtil::Handle<SubscriberList> SubscriberListPtr;
+
+//
+// The subscribers of a topic. The list is shared by the topic with the
+// threads publishing events and it's copied on write: the topic only
+// copies the list if it's modified while events are being published.
+//
+// Subscribers with a content filter are indexed by the values of one
+// of their filter predicates so that publishing events only queues
+// them to the subscribers which might accept them.
+//
+class SubscriberList : public IceUtil::Shared
+{
+public:
+
+    SubscriberList();
+
+    //
+    // Builds the index of the filtered subscribers if it's not built
+    // yet. Must be called with the topic locked.
+    //
+    void index();
+
+    //
+    // Returns the subscribers which might accept one of the given
+    // events, the list must be indexed.
+    //
+    SubscriberListPtr select(const EventDataSeq&);
+
+    std::vector<SubscriberPtr> subscribers;
+
+private:
+
+    friend std::vector<SubscriberPtr>& modifySubscribers(SubscriberListPtr&);
+
+    typedef std::map<std::string, std::vector<SubscriberPtr> > SubscriberIndex;
+
+    bool _indexed;
+    std::vector<SubscriberPtr> _unfiltered; // The subscribers without filter.
+    SubscriberIndex _operations; // The filtered subscribers indexed by operation.
+    std::map<std::string, SubscriberIndex> _context; // The filtered subscribers indexed by context key and value.
+};
+
+//
+// Returns the subscribers of the given list for modification, the list
+// is first copied if it's shared. Must be called with the topic locked.
+//
+std::vector<SubscriberPtr>& modifySubscribers(SubscriberListPtr&);
+
+//
+// The fan-out pool queues published events to the subscribers of a
+// topic. The subscribers of topics with more subscribers than the shard
+// size are split in shards which are processed in parallel by the pool
+// threads and the publishing thread.
+//
+class FanOutPool : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    FanOutPool(const Ice::LoggerPtr&, int, int);
+
+    //
+    // Queue the events to the given subscribers, the identities of the
+    // subscribers which must be reaped are added to the given sequence.
+    // Returns once the events are queued to all the subscribers.
+    //
+    void publish(const SubscriberListPtr&, bool, const EventDataSeq&, Ice::IdentitySeq&);
+
+    void destroy();
+
+private:
+
+    struct Batch
+    {
+        int pending; // The number of shards not processed yet.
+        Ice::IdentitySeq reap;
+    };
+
+    struct Shard
+    {
+        const SubscriberPtr* begin;
+        const SubscriberPtr* end;
+        bool forwarded;
+        const EventDataSeq* events;
+        Batch* batch;
+    };
+
+    class FanOutThread : public IceUtil::Thread
+    {
+    public:
+
+        FanOutThread(FanOutPool*);
+        virtual void run();
+
+    private:
+
+        FanOutPool* _pool;
+    };
+
+    void run();
+    void process(const Shard&, Ice::IdentitySeq&);
+
+    const Ice::LoggerPtr _logger;
+    const size_t _shardSize;
+    std::vector<IceUtil::ThreadPtr> _threads;
+    std::deque<Shard> _shards;
+    bool _destroyed;
+};
+typedef IceUtil::Handle<FanOutPool> FanOutPoolPtr;
+
 bool operator==(const IceStorm::SubscriberPtr&, const Ice::Identity&);
 bool operator==(const IceStorm::Subscriber&, const IceStorm::Subscriber&);
 bool operator!=(const IceStorm::Subscriber&, const IceStorm::Subscriber&);
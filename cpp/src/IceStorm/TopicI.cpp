@@ -15,6 +15,8 @@
 #include <IceStorm/Observers.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
+#include <IceUtil/InputUtil.h>
+#include <IceUtil/OutputUtil.h>
 #include <algorithm>
 
 using namespace std;
@@ -32,6 +34,95 @@ logError(const Ice::CommunicatorPtr& com, const IceDB::LMDBException& ex)
     error << "LMDB error: " << ex;
 }
 
+//
+// The context key used to provide the event log offset of an event
+// to subscribers.
+//
+const string offsetContextKey = "IceStorm.Offset";
+
+EventDataPtr
+toEventData(const EventRecordKey& key, const EventRecord& record)
+{
+    EventDataPtr event = new EventData(record.op, record.mode, record.data, record.context);
+    event->context[offsetContextKey] = IceUtilInternal::int64ToString(key.offset);
+    return event;
+}
+
+//
+// Reads the events of the event log of a topic from the given offset up
+// to the given end offset (excluded). The events pruned from the log
+// before they are read are skipped.
+//
+class EventLogReplay : public EventReplay
+{
+public:
+
+    EventLogReplay(const PersistentInstancePtr& instance, const Ice::Identity& topic, Ice::Long offset,
+                   Ice::Long end) :
+        _instance(instance), _eventMap(instance->eventMap()), _topic(topic), _offset(offset), _end(end)
+    {
+    }
+
+    virtual bool
+    read(EventDataSeq& events, int max)
+    {
+        try
+        {
+            IceDB::ReadOnlyTxn txn(_instance->eventLogEnv());
+            EventMapROCursor cursor(_eventMap, txn);
+
+            EventRecordKey key;
+            key.topic = _topic;
+            key.offset = _offset;
+            EventRecord record;
+            bool found = cursor.findRange(key, record) && key.topic == _topic && key.offset < _end;
+            while(found && static_cast<int>(events.size()) < max)
+            {
+                events.push_back(toEventData(key, record));
+                found = cursor.get(key, record, MDB_NEXT) && key.topic == _topic && key.offset < _end;
+            }
+            _offset = found ? key.offset : _end;
+        }
+        catch(const IceDB::LMDBException& ex)
+        {
+            logError(_instance->communicator(), ex);
+            _offset = _end;
+        }
+        return _offset < _end;
+    }
+
+private:
+
+    const PersistentInstancePtr _instance;
+    EventMap _eventMap;
+    const Ice::Identity _topic;
+    Ice::Long _offset;
+    const Ice::Long _end;
+};
+
+//
+// Removes the events which exceed the age limit of the event log of a
+// topic, the events are otherwise only removed when events are logged.
+//
+class EventLogTrimTask : public IceUtil::TimerTask
+{
+public:
+
+    EventLogTrimTask(const TopicImplPtr& topic) : _topic(topic)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        _topic->trimEventLog();
+    }
+
+private:
+
+    const TopicImplPtr _topic;
+};
+
 //
 // The servant has a 1-1 association with a topic. It is used to
 // receive events from Publishers.
@@ -346,14 +437,47 @@ TopicImpl::TopicImpl(
     _instance(instance),
     _name(name),
     _id(id),
+    _subscribers(new SubscriberList),
     _destroyed(false),
     _lluMap(_instance->lluMap()),
-    _subscriberMap(_instance->subscriberMap())
+    _subscriberMap(_instance->subscriberMap()),
+    _eventLog(_instance->eventLogEnabled(name)),
+    _eventMap(_instance->eventMap()),
+    _nextOffset(1),
+    _eventLogWriting(false),
+    _loggedOffset(1),
+    _firstOffset(1),
+    _eventLogSize(0)
 {
     try
     {
         __setNoDelete(true);
 
+        //
+        // Recover the bounds and size of the event log.
+        //
+        if(_eventLog)
+        {
+            IceDB::ReadOnlyTxn txn(_instance->eventLogEnv());
+            EventMapROCursor cursor(_eventMap, txn);
+
+            EventRecordKey key;
+            key.topic = _id;
+            key.offset = 0;
+            EventRecord record;
+            if(cursor.findRange(key, record) && key.topic == _id)
+            {
+                _firstOffset = key.offset;
+                do
+                {
+                    _nextOffset = key.offset + 1;
+                    _eventLogSize += static_cast<Ice::Long>(record.data.size());
+                }
+                while(cursor.get(key, record, MDB_NEXT) && key.topic == _id);
+            }
+            _loggedOffset = _nextOffset;
+        }
+
         // TODO: If we want to improve the performance of the
         // non-replicated case we could allocate a null-topic impl here.
         _servant = new TopicI(this, instance);
@@ -413,7 +537,7 @@ TopicImpl::TopicImpl(
                 // subscribers.
                 //
                 SubscriberPtr subscriber = Subscriber::create(_instance, *p);
-                _subscribers.push_back(subscriber);
+                modifySubscribers(_subscribers).push_back(subscriber);
             }
             catch(const Ice::Exception& ex)
             {
@@ -431,6 +555,13 @@ TopicImpl::TopicImpl(
         {
             _observer.attach(_instance->observer()->getTopicObserver(_instance->serviceName(), _name, 0));
         }
+
+        if(_eventLog && _instance->eventLogMaxAge() != IceUtil::Time())
+        {
+            _eventLogTrimmer = new EventLogTrimTask(this);
+            _instance->timer()->scheduleRepeated(_eventLogTrimmer,
+                                                 max(_instance->eventLogMaxAge() / 2, IceUtil::Time::seconds(1)));
+        }
     }
     catch(...)
     {
@@ -531,7 +662,26 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
 
             }
             out << " subscriptions: ";
-            trace(out, _instance, _subscribers);
+            IceUtil::Mutex::Lock sync(_subscribersMutex);
+            trace(out, _instance, _subscribers->subscribers);
+        }
+    }
+
+    Ice::Long resumeFrom = -1;
+    QoS::const_iterator q = qos.find("resumeFrom");
+    if(q != qos.end())
+    {
+        if(!_eventLog)
+        {
+            throw BadQoS("resumeFrom requires the event log to be enabled for topic `" + _name + "'");
+        }
+        if(!IceUtilInternal::stringToInt64(q->second, resumeFrom) || resumeFrom < 0)
+        {
+            throw BadQoS("invalid resumeFrom: " + q->second);
+        }
+        if(obj->ice_isBatchOneway() || obj->ice_isBatchDatagram())
+        {
+            throw BadQoS("resumeFrom is not supported by batch subscribers");
         }
     }
 
@@ -545,12 +695,26 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
     record.link = false;
     record.cost = 0;
 
-    vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
-    if(p != _subscribers.end())
+    bool subscribed = find(_subscribers->subscribers.begin(), _subscribers->subscribers.end(), record.id) !=
+        _subscribers->subscribers.end();
+    if(subscribed && resumeFrom < 0)
     {
         throw AlreadySubscribed();
     }
 
+    //
+    // Subscribing again with resumeFrom replaces the subscription, this
+    // allows a subscriber to replay the events it missed after a restart
+    // of IceStorm or of the subscriber. The subscription is removed first
+    // as its per-subscriber object has the same identity.
+    //
+    if(subscribed)
+    {
+        Ice::IdentitySeq ids;
+        ids.push_back(id);
+        removeSubscribers(ids);
+    }
+
     LogUpdate llu;
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
@@ -574,7 +738,18 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
         throw; // will become UnknownException in caller
     }
 
-    _subscribers.push_back(subscriber);
+    modifySubscribers(_subscribers).push_back(subscriber);
+
+    //
+    // Replay the logged events before the subscriber receives new
+    // events. Events published concurrently are either logged before
+    // the lock was acquired or are published to the subscriber after
+    // it's released.
+    //
+    if(resumeFrom >= 0)
+    {
+        replayEvents(subscriber, resumeFrom);
+    }
 
     _instance->observers()->addSubscriber(llu, _name, record);
 
@@ -605,7 +780,8 @@ TopicImpl::unsubscribe(const Ice::ObjectPrx& subscriber)
         if(traceLevels->topic > 1)
         {
             out << " endpoints: " << IceStormInternal::describeEndpoints(subscriber);
-            trace(out, _instance, _subscribers);
+            IceUtil::Mutex::Lock sync(_subscribersMutex);
+            trace(out, _instance, _subscribers->subscribers);
         }
     }
 
@@ -653,8 +829,9 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
     record.link = true;
     record.cost = cost;
 
-    vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
-    if(p != _subscribers.end())
+    vector<SubscriberPtr>::const_iterator p = find(_subscribers->subscribers.begin(), _subscribers->subscribers.end(),
+                                                   record.id);
+    if(p != _subscribers->subscribers.end())
     {
         string name = IceStormInternal::identityToTopicName(id);
         LinkExists ex;
@@ -686,7 +863,7 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
         throw; // will become UnknownException in caller
     }
 
-    _subscribers.push_back(subscriber);
+    modifySubscribers(_subscribers).push_back(subscriber);
 
     _instance->observers()->addSubscriber(llu, _name, record);
 }
@@ -702,8 +879,9 @@ TopicImpl::unlink(const TopicPrx& topic)
 
     Ice::Identity id = topic->ice_getIdentity();
 
-    vector<SubscriberPtr>::const_iterator p = find(_subscribers.begin(), _subscribers.end(), id);
-    if(p == _subscribers.end())
+    vector<SubscriberPtr>::const_iterator p = find(_subscribers->subscribers.begin(), _subscribers->subscribers.end(),
+                                                   id);
+    if(p == _subscribers->subscribers.end())
     {
         string name = IceStormInternal::identityToTopicName(id);
         TraceLevelsPtr traceLevels = _instance->traceLevels();
@@ -759,8 +937,15 @@ TopicImpl::shutdown()
     IceUtil::Mutex::Lock sync(_subscribersMutex);
     _servant = 0;
 
+    if(_eventLogTrimmer)
+    {
+        _instance->timer()->cancel(_eventLogTrimmer);
+        _eventLogTrimmer = 0;
+    }
+
     // Shutdown each subscriber. This waits for the event queues to drain.
-    for(vector<SubscriberPtr>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = _subscribers->subscribers.begin();
+        p != _subscribers->subscribers.end(); ++p)
     {
         (*p)->shutdown();
     }
@@ -774,7 +959,8 @@ TopicImpl::getLinkInfoSeq() const
     IceUtil::Mutex::Lock sync(_subscribersMutex);
 
     LinkInfoSeq seq;
-    for(vector<SubscriberPtr>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = _subscribers->subscribers.begin();
+        p != _subscribers->subscribers.end(); ++p)
     {
         SubscriberRecord record = (*p)->record();
         if(record.link && !(*p)->errored())
@@ -795,7 +981,8 @@ TopicImpl::getSubscribers() const
     IceUtil::Mutex::Lock sync(_subscribersMutex);
 
     Ice::IdentitySeq subscribers;
-    for(vector<SubscriberPtr>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = _subscribers->subscribers.begin();
+        p != _subscribers->subscribers.end(); ++p)
     {
         subscribers.push_back((*p)->id());
     }
@@ -834,7 +1021,8 @@ TopicImpl::getContent() const
 
     TopicContent content;
     content.id = _id;
-    for(vector<SubscriberPtr>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = _subscribers->subscribers.begin();
+        p != _subscribers->subscribers.end(); ++p)
     {
         // Don't return errored subscribers (subscribers that have
         // errored out, but not reaped due to a failure with the
@@ -857,9 +1045,10 @@ TopicImpl::update(const SubscriberRecordSeq& records)
     // runs through the init list and add the ones that don't
     // exist.
 
+    vector<SubscriberPtr>& subscribers = modifySubscribers(_subscribers);
     {
-        vector<SubscriberPtr>::iterator p = _subscribers.begin();
-        while(p != _subscribers.end())
+        vector<SubscriberPtr>::iterator p = subscribers.begin();
+        while(p != subscribers.end())
         {
             SubscriberRecordSeq::const_iterator q;
             for(q = records.begin(); q != records.end(); ++q)
@@ -874,7 +1063,7 @@ TopicImpl::update(const SubscriberRecordSeq& records)
             if(q == records.end())
             {
                 (*p)->destroy();
-                p = _subscribers.erase(p);
+                p = subscribers.erase(p);
             }
             else
             {
@@ -888,17 +1077,17 @@ TopicImpl::update(const SubscriberRecordSeq& records)
     for(SubscriberRecordSeq::const_iterator p = records.begin(); p != records.end(); ++p)
     {
         vector<SubscriberPtr>::iterator q;
-        for(q = _subscribers.begin(); q != _subscribers.end(); ++q)
+        for(q = subscribers.begin(); q != subscribers.end(); ++q)
         {
             if((*q)->id() == p->id)
             {
                 break;
             }
         }
-        if(q == _subscribers.end())
+        if(q == subscribers.end())
         {
             SubscriberPtr subscriber = Subscriber::create(_instance, *p);
-            _subscribers.push_back(subscriber);
+            subscribers.push_back(subscriber);
         }
     }
 }
@@ -970,15 +1159,17 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
     TopicInternalPrx masterInternal;
     Ice::Long generation = -1;
     Ice::IdentitySeq reap;
+    Ice::Long logged = 0;
     {
         // Use cached reads.
         CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
 
         //
-        // Copy of the subscriber list so that event publishing can occur
-        // in parallel.
+        // Reference to the subscriber list so that event publishing can
+        // occur in parallel, the list is copied if it's modified while
+        // the events are queued.
         //
-        vector<SubscriberPtr> copy;
+        SubscriberListPtr list;
         {
             IceUtil::Mutex::Lock sync(_subscribersMutex);
             if(_observer)
@@ -992,21 +1183,31 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
                     _observer->published();
                 }
             }
-            copy = _subscribers;
+            if(_eventLog)
+            {
+                logged = queueEvents(events);
+            }
+            _subscribers->index();
+            list = _subscribers;
         }
 
         //
-        // Queue each event, gathering a list of those subscribers that
-        // must be reaped.
+        // Wait for the events to be written to the event log before
+        // they are queued to the subscribers.
         //
-        for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
+        if(logged > 0)
         {
-            if(!(*p)->queue(forwarded, events) && (*p)->reap())
-            {
-                reap.push_back((*p)->id());
-            }
+            flushEventLog(logged);
         }
 
+        //
+        // Queue each event to the subscribers which might accept it,
+        // gathering a list of those subscribers that must be reaped.
+        //
+        list = list->select(events);
+        _instance->fanOutPool()->publish(list, forwarded, events, reap);
+        list = 0; // Release the list so that it's not copied if it's modified below.
+
         // If there are no subscribers in error then we're done.
         if(reap.empty())
         {
@@ -1063,8 +1264,9 @@ TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& r
         out << " llu: " << llu.generation << "/" << llu.iteration;
     }
 
-    vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
-    if(p != _subscribers.end())
+    vector<SubscriberPtr>::const_iterator p = find(_subscribers->subscribers.begin(), _subscribers->subscribers.end(),
+                                                   record.id);
+    if(p != _subscribers->subscribers.end())
     {
         // If the subscriber is already in the database display a
         // diagnostic.
@@ -1099,7 +1301,7 @@ TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& r
         throw; // will become UnknownException in caller
     }
 
-    _subscribers.push_back(subscriber);
+    modifySubscribers(_subscribers).push_back(subscriber);
 }
 
 void
@@ -1151,13 +1353,14 @@ TopicImpl::observerRemoveSubscriber(const LogUpdate& llu, const Ice::IdentitySeq
     // Then remove the subscriber from the subscribers list. If the
     // subscriber had a local failure and was removed from the
     // subscriber list it could already be gone. That's not a problem.
+    vector<SubscriberPtr>& subscribers = modifySubscribers(_subscribers);
     for(Ice::IdentitySeq::const_iterator id = ids.begin(); id != ids.end(); ++id)
     {
-        vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), *id);
-        if(p != _subscribers.end())
+        vector<SubscriberPtr>::iterator p = find(subscribers.begin(), subscribers.end(), *id);
+        if(p != subscribers.end())
         {
             (*p)->destroy();
-            _subscribers.erase(p);
+            subscribers.erase(p);
         }
     }
 }
@@ -1203,7 +1406,8 @@ void
 TopicImpl::updateSubscriberObservers()
 {
     IceUtil::Mutex::Lock sync(_subscribersMutex);
-    for(vector<SubscriberPtr>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = _subscribers->subscribers.begin();
+        p != _subscribers->subscribers.end(); ++p)
     {
         (*p)->updateObserver();
     }
@@ -1255,16 +1459,27 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
         throw; // will become UnknownException in caller
     }
 
+    if(_eventLog)
+    {
+        if(_eventLogTrimmer)
+        {
+            _instance->timer()->cancel(_eventLogTrimmer);
+            _eventLogTrimmer = 0;
+        }
+        eraseEventLog();
+    }
+
     _instance->publishAdapter()->remove(_linkPrx->ice_getIdentity());
     _instance->publishAdapter()->remove(_publisherPrx->ice_getIdentity());
     _instance->topicReaper()->add(_name);
 
     // Destroy each of the subscribers.
-    for(vector<SubscriberPtr>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = _subscribers->subscribers.begin();
+        p != _subscribers->subscribers.end(); ++p)
     {
         (*p)->destroy();
     }
-    _subscribers.clear();
+    _subscribers = new SubscriberList;
 
     _instance->topicAdapter()->remove(_id);
 
@@ -1273,6 +1488,260 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
     return llu;
 }
 
+Ice::Long
+TopicImpl::queueEvents(const EventDataSeq& events)
+{
+    //
+    // Must be called with _subscribersMutex locked, the events are
+    // queued in the order of their offsets.
+    //
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        (*p)->context[offsetContextKey] = IceUtilInternal::int64ToString(_nextOffset++);
+    }
+
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_eventLogMonitor);
+    _pendingEvents.insert(_pendingEvents.end(), events.begin(), events.end());
+    return _nextOffset;
+}
+
+void
+TopicImpl::flushEventLog(Ice::Long end)
+{
+    //
+    // Wait for the events queued before the given offset to be written,
+    // writing the queued events if no other thread is writing them.
+    //
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_eventLogMonitor);
+    while(_loggedOffset < end)
+    {
+        if(_eventLogWriting)
+        {
+            _eventLogMonitor.wait();
+        }
+        else
+        {
+            writeEventLog(sync);
+        }
+    }
+}
+
+void
+TopicImpl::trimEventLog()
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_eventLogMonitor);
+    if(!_eventLogWriting)
+    {
+        writeEventLog(sync);
+    }
+}
+
+void
+TopicImpl::writeEventLog(IceUtil::Monitor<IceUtil::Mutex>::Lock& sync)
+{
+    //
+    // Must be called with _eventLogMonitor locked by the given lock. The
+    // queued events are written with the monitor unlocked so that the
+    // publishers can queue events in the meantime.
+    //
+    assert(!_eventLogWriting);
+    _eventLogWriting = true;
+
+    EventDataSeq events;
+    events.swap(_pendingEvents);
+    const Ice::Long offset = _loggedOffset;
+    Ice::Long firstOffset = _firstOffset;
+    Ice::Long size = _eventLogSize;
+    bool written = false;
+    sync.release();
+    try
+    {
+        written = writeEvents(events, offset, firstOffset, size);
+    }
+    catch(...)
+    {
+        sync.acquire();
+        _loggedOffset = offset + static_cast<Ice::Long>(events.size());
+        _eventLogWriting = false;
+        _eventLogMonitor.notifyAll();
+        throw;
+    }
+
+    sync.acquire();
+
+    //
+    // The events which failed to be written are still published to the
+    // subscribers.
+    //
+    _loggedOffset = offset + static_cast<Ice::Long>(events.size());
+    if(written)
+    {
+        _firstOffset = firstOffset;
+        _eventLogSize = size;
+    }
+    _eventLogWriting = false;
+    _eventLogMonitor.notifyAll();
+}
+
+bool
+TopicImpl::writeEvents(const EventDataSeq& events, Ice::Long offset, Ice::Long& firstOffset, Ice::Long& size)
+{
+    const Ice::Long nextOffset = offset + static_cast<Ice::Long>(events.size());
+    const Ice::Long maxEvents = _instance->eventLogMaxEvents();
+    const Ice::Long maxSize = _instance->eventLogMaxSize();
+    const IceUtil::Time maxAge = _instance->eventLogMaxAge();
+    const IceUtil::Time now = IceUtil::Time::now();
+
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        size += static_cast<Ice::Long>((*p)->data.size());
+    }
+
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->eventLogEnv());
+        bool modified = false;
+
+        //
+        // Remove the oldest events which exceed the retention limits
+        // before writing the new events, the most recent event is always
+        // kept.
+        //
+        EventRecordKey key;
+        key.topic = _id;
+        key.offset = firstOffset;
+        EventRecord record;
+        EventMapRWCursor cursor(_eventMap, txn);
+        bool found = cursor.findRange(key, record) && key.topic == _id;
+        while(found && key.offset < offset && (!events.empty() || key.offset < offset - 1))
+        {
+            if((maxEvents <= 0 || nextOffset - key.offset <= maxEvents) &&
+               (maxSize <= 0 || size <= maxSize) &&
+               (maxAge == IceUtil::Time() || now - IceUtil::Time::milliSeconds(record.timestamp) <= maxAge))
+            {
+                break;
+            }
+
+            cursor.del();
+            modified = true;
+            size -= static_cast<Ice::Long>(record.data.size());
+            firstOffset = key.offset + 1;
+            found = cursor.get(key, record, MDB_NEXT) && key.topic == _id;
+        }
+
+        //
+        // Write the new events, skipping those which would be removed
+        // right away.
+        //
+        record.timestamp = now.toMilliSeconds();
+        key.offset = offset;
+        for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p, ++key.offset)
+        {
+            if(firstOffset >= key.offset && key.offset < nextOffset - 1 &&
+               ((maxEvents > 0 && nextOffset - key.offset > maxEvents) || (maxSize > 0 && size > maxSize)))
+            {
+                size -= static_cast<Ice::Long>((*p)->data.size());
+                firstOffset = key.offset + 1;
+                continue;
+            }
+
+            record.op = (*p)->op;
+            record.mode = (*p)->mode;
+            record.data = (*p)->data;
+            record.context = (*p)->context;
+            record.context.erase(offsetContextKey);
+            _eventMap.put(txn, key, record);
+            modified = true;
+        }
+
+        if(modified)
+        {
+            txn.commit();
+        }
+        else
+        {
+            txn.rollback();
+        }
+        return true;
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_instance->communicator(), ex);
+        return false;
+    }
+}
+
+void
+TopicImpl::eraseEventLog()
+{
+    //
+    // Must be called with _subscribersMutex locked. The events queued
+    // for the log are discarded.
+    //
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_eventLogMonitor);
+    while(_eventLogWriting)
+    {
+        _eventLogMonitor.wait();
+    }
+    _pendingEvents.clear();
+    _loggedOffset = _nextOffset;
+    _eventLogMonitor.notifyAll();
+
+    try
+    {
+        IceDB::ReadWriteTxn txn(_instance->eventLogEnv());
+
+        EventRecordKey key;
+        key.topic = _id;
+        key.offset = 0;
+        EventRecord record;
+        EventMapRWCursor cursor(_eventMap, txn);
+        bool found = cursor.findRange(key, record) && key.topic == _id;
+        while(found)
+        {
+            cursor.del();
+            found = cursor.get(key, record, MDB_NEXT) && key.topic == _id;
+        }
+
+        txn.commit();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_instance->communicator(), ex);
+    }
+    _firstOffset = _nextOffset;
+    _eventLogSize = 0;
+}
+
+void
+TopicImpl::replayEvents(const SubscriberPtr& subscriber, Ice::Long offset)
+{
+    //
+    // Must be called with _subscribersMutex locked. The events published
+    // from now on are logged at _nextOffset or later and are queued to
+    // the subscriber after the replayed events. The events published
+    // before are written to the log first.
+    //
+    flushEventLog(_nextOffset);
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_eventLogMonitor);
+        offset = max(offset, _firstOffset);
+    }
+
+    TraceLevelsPtr traceLevels = _instance->traceLevels();
+    if(traceLevels->topic > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+        out << _name << ": replaying events from offset " << offset << " to " << _nextOffset << " to "
+            << _instance->communicator()->identityToString(subscriber->id());
+    }
+
+    if(offset < _nextOffset)
+    {
+        subscriber->replay(new EventLogReplay(_instance, _id, offset, _nextOffset));
+    }
+}
+
 void
 TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
 {
@@ -1320,13 +1789,14 @@ TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
         // replicas on the same subscriber). To avoid sending unnecessary
         // observer updates keep track of the observers that are actually
         // removed.
+        vector<SubscriberPtr>& subscribers = modifySubscribers(_subscribers);
         for(Ice::IdentitySeq::const_iterator id = ids.begin(); id != ids.end(); ++id)
         {
-            vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), *id);
-            if(p != _subscribers.end())
+            vector<SubscriberPtr>::iterator p = find(subscribers.begin(), subscribers.end(), *id);
+            if(p != subscribers.end())
             {
                 (*p)->destroy();
-                _subscribers.erase(p);
+                subscribers.erase(p);
             }
         }
 
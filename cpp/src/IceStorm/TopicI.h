@@ -15,6 +15,8 @@
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Util.h>
 #include <Ice/ObserverHelper.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Timer.h>
 #include <list>
 
 namespace IceStorm
@@ -27,6 +29,9 @@ typedef IceUtil::Handle<PersistentInstance> PersistentInstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class SubscriberList;
+typedef IceUtil::Handle<SubscriberList> SubscriberListPtr;
+
 class TopicImpl : public IceUtil::Shared
 {
 public:
@@ -68,10 +73,18 @@ public:
     void updateObserver();
     void updateSubscriberObservers();
 
+    void trimEventLog();
+
 private:
 
     IceStormElection::LogUpdate destroyInternal(const IceStormElection::LogUpdate&, bool);
     void removeSubscribers(const Ice::IdentitySeq&);
+    Ice::Long queueEvents(const EventDataSeq&);
+    void flushEventLog(Ice::Long);
+    void writeEventLog(IceUtil::Monitor<IceUtil::Mutex>::Lock&);
+    bool writeEvents(const EventDataSeq&, Ice::Long, Ice::Long&, Ice::Long&);
+    void eraseEventLog();
+    void replayEvents(const SubscriberPtr&, Ice::Long);
 
     //
     // Immutable members.
@@ -96,14 +109,39 @@ private:
     // should be publishing events, not searching through the list of
     // subscribers for a particular subscriber. I tested
     // vector/list/map and although there was little difference vector
-    // was the fastest of the three.
+    // was the fastest of the three. The vector is copied on write
+    // so that publishing events doesn't require copying it (see
+    // SubscriberList).
     //
-    std::vector<SubscriberPtr> _subscribers;
+    SubscriberListPtr _subscribers;
 
     bool _destroyed; // Has this Topic been destroyed?
 
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
+
+    //
+    // The event log of the topic. Events are assigned increasing offsets
+    // with _subscribersMutex locked, _nextOffset is the offset of the next
+    // event. The events are then queued in _pendingEvents and written to
+    // the log outside _subscribersMutex: a publisher writes all the queued
+    // events in a single transaction while the other publishers wait for
+    // their events to be written. _loggedOffset is the end of the events
+    // written (or which failed to be written) and _firstOffset the offset
+    // of the oldest event still in the log. These members are protected
+    // by _eventLogMonitor.
+    //
+    const bool _eventLog;
+    EventMap _eventMap;
+    Ice::Long _nextOffset;
+
+    IceUtil::Monitor<IceUtil::Mutex> _eventLogMonitor;
+    EventDataSeq _pendingEvents;
+    bool _eventLogWriting;
+    Ice::Long _loggedOffset;
+    Ice::Long _firstOffset;
+    Ice::Long _eventLogSize;
+    IceUtil::TimerTaskPtr _eventLogTrimmer;
 };
 
 typedef IceUtil::Handle<TopicImpl> TopicImplPtr;
@@ -101,6 +101,7 @@ TransientTopicImpl::TransientTopicImpl(
     _instance(instance),
     _name(name),
     _id(id),
+    _subscribers(new SubscriberList),
     _destroyed(false)
 {
     //
@@ -248,17 +249,18 @@ TransientTopicImpl::subscribe(const QoS& origQoS, const Ice::ObjectPrx& obj, con
     record.link = false;
     record.cost = 0;
 
-    vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
-    if(p != _subscribers.end())
+    vector<SubscriberPtr>& subscribers = modifySubscribers(_subscribers);
+    vector<SubscriberPtr>::iterator p = find(subscribers.begin(), subscribers.end(), record.id);
+    if(p != subscribers.end())
     {
         // If we already have this subscriber remove it from our
         // subscriber list and remove it from the database.
         (*p)->destroy();
-        _subscribers.erase(p);
+        subscribers.erase(p);
     }
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
-    _subscribers.push_back(subscriber);
+    subscribers.push_back(subscriber);
 }
 
 Ice::ObjectPrx
@@ -297,6 +299,11 @@ TransientTopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPr
         }
     }
 
+    if(qos.find("resumeFrom") != qos.end())
+    {
+        throw BadQoS("resumeFrom requires a persistent topic with the event log enabled");
+    }
+
     Lock sync(*this);
 
     SubscriberRecord record;
@@ -307,14 +314,15 @@ TransientTopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPr
     record.link = false;
     record.cost = 0;
 
-    vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
-    if(p != _subscribers.end())
+    vector<SubscriberPtr>::const_iterator p = find(_subscribers->subscribers.begin(), _subscribers->subscribers.end(),
+                                                   record.id);
+    if(p != _subscribers->subscribers.end())
     {
         throw AlreadySubscribed();
     }
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
-    _subscribers.push_back(subscriber);
+    modifySubscribers(_subscribers).push_back(subscriber);
 
     return subscriber->proxy();
 }
@@ -349,11 +357,12 @@ TransientTopicImpl::unsubscribe(const Ice::ObjectPrx& subscriber, const Ice::Cur
     // First remove the subscriber from the subscribers list. Note
     // that its possible that the subscriber isn't in the list, but is
     // in the database if the subscriber was locally reaped.
-    vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), id);
-    if(p != _subscribers.end())
+    vector<SubscriberPtr>& subscribers = modifySubscribers(_subscribers);
+    vector<SubscriberPtr>::iterator p = find(subscribers.begin(), subscribers.end(), id);
+    if(p != subscribers.end())
     {
         (*p)->destroy();
-        _subscribers.erase(p);
+        subscribers.erase(p);
     }
 }
 
@@ -390,8 +399,9 @@ TransientTopicImpl::link(const TopicPrx& topic, Ice::Int cost, const Ice::Curren
     record.link = true;
     record.cost = cost;
 
-    vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
-    if(p != _subscribers.end())
+    vector<SubscriberPtr>::const_iterator p = find(_subscribers->subscribers.begin(), _subscribers->subscribers.end(),
+                                                   record.id);
+    if(p != _subscribers->subscribers.end())
     {
         string name = IceStormInternal::identityToTopicName(id);
         LinkExists ex;
@@ -400,7 +410,7 @@ TransientTopicImpl::link(const TopicPrx& topic, Ice::Int cost, const Ice::Curren
     }
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
-    _subscribers.push_back(subscriber);
+    modifySubscribers(_subscribers).push_back(subscriber);
 }
 
 void
@@ -414,8 +424,9 @@ TransientTopicImpl::unlink(const TopicPrx& topic, const Ice::Current&)
 
     Ice::Identity id = topic->ice_getIdentity();
 
-    vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), id);
-    if(p == _subscribers.end())
+    vector<SubscriberPtr>& subscribers = modifySubscribers(_subscribers);
+    vector<SubscriberPtr>::iterator p = find(subscribers.begin(), subscribers.end(), id);
+    if(p == subscribers.end())
     {
         string name = IceStormInternal::identityToTopicName(id);
         TraceLevelsPtr traceLevels = _instance->traceLevels();
@@ -440,11 +451,11 @@ TransientTopicImpl::unlink(const TopicPrx& topic, const Ice::Current&)
     // Remove the subscriber from the subscribers list. Note
     // that its possible that the subscriber isn't in the list, but is
     // in the database if the subscriber was locally reaped.
-    p = find(_subscribers.begin(), _subscribers.end(), id);
-    if(p != _subscribers.end())
+    p = find(subscribers.begin(), subscribers.end(), id);
+    if(p != subscribers.end())
     {
         (*p)->destroy();
-        _subscribers.erase(p);
+        subscribers.erase(p);
     }
 }
 
@@ -453,7 +464,8 @@ TransientTopicImpl::getLinkInfoSeq(const Ice::Current&) const
 {
     Lock sync(*this);
     LinkInfoSeq seq;
-    for(vector<SubscriberPtr>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = _subscribers->subscribers.begin();
+        p != _subscribers->subscribers.end(); ++p)
     {
         SubscriberRecord record = (*p)->record();
         if(record.link && !(*p)->errored())
@@ -474,7 +486,8 @@ TransientTopicImpl::getSubscribers(const Ice::Current&) const
     IceUtil::Mutex::Lock sync(*this);
 
     Ice::IdentitySeq subscribers;
-    for(vector<SubscriberPtr>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = _subscribers->subscribers.begin();
+        p != _subscribers->subscribers.end(); ++p)
     {
         subscribers.push_back((*p)->id());
     }
@@ -510,11 +523,12 @@ TransientTopicImpl::destroy(const Ice::Current&)
     }
 
     // Destroy all of the subscribers.
-    for(vector<SubscriberPtr>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = _subscribers->subscribers.begin();
+        p != _subscribers->subscribers.end(); ++p)
     {
         (*p)->destroy();
     }
-    _subscribers.clear();
+    _subscribers = new SubscriberList;
 }
 
 void
@@ -540,27 +554,25 @@ void
 TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
 {
     //
-    // Copy of the subscriber list so that event publishing can occur
-    // in parallel.
+    // Reference to the subscriber list so that event publishing can
+    // occur in parallel, the list is copied if it's modified while the
+    // events are queued.
     //
-    vector<SubscriberPtr> copy;
+    SubscriberListPtr list;
     {
         Lock sync(*this);
-        copy = _subscribers;
+        _subscribers->index();
+        list = _subscribers;
     }
 
     //
-    // Queue each event, gathering a list of those subscribers that
-    // must be reaped.
+    // Queue each event to the subscribers which might accept it,
+    // gathering a list of those subscribers that must be reaped.
     //
+    list = list->select(events);
     vector<Ice::Identity> e;
-    for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
-    {
-        if(!(*p)->queue(forwarded, events) && (*p)->reap())
-        {
-            e.push_back((*p)->id());
-        }
-    }
+    _instance->fanOutPool()->publish(list, forwarded, events, e);
+    list = 0; // Release the list so that it's not copied if it's modified below.
 
     //
     // Run through the error list removing those subscribers that are
@@ -569,6 +581,7 @@ TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
     if(!e.empty())
     {
         Lock sync(*this);
+        vector<SubscriberPtr>& subscribers = modifySubscribers(_subscribers);
         for(vector<Ice::Identity>::const_iterator ep = e.begin(); ep != e.end(); ++ep)
         {
             //
@@ -585,15 +598,15 @@ TransientTopicImpl::publish(bool forwarded, const EventDataSeq& events)
             // error'd subscribers and remove it from the database on
             // the next reap.
             //
-            vector<SubscriberPtr>::iterator q = find(_subscribers.begin(), _subscribers.end(), *ep);
-            if(q != _subscribers.end())
+            vector<SubscriberPtr>::iterator q = find(subscribers.begin(), subscribers.end(), *ep);
+            if(q != subscribers.end())
             {
                 SubscriberPtr subscriber = *q;
                 //
                 // Destroy the subscriber.
                 //
                 subscriber->destroy();
-                _subscribers.erase(q);
+                subscribers.erase(q);
             }
         }
     }
@@ -605,7 +618,8 @@ TransientTopicImpl::shutdown()
     Lock sync(*this);
 
     // Shutdown each subscriber. This waits for the event queues to drain.
-    for(vector<SubscriberPtr>::const_iterator p = _subscribers.begin(); p != _subscribers.end(); ++p)
+    for(vector<SubscriberPtr>::const_iterator p = _subscribers->subscribers.begin();
+        p != _subscribers->subscribers.end(); ++p)
     {
         (*p)->shutdown();
     }
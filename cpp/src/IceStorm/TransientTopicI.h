@@ -22,6 +22,9 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class SubscriberList;
+typedef IceUtil::Handle<SubscriberList> SubscriberListPtr;
+
 class TransientTopicImpl : public TopicInternal, public IceUtil::Mutex
 {
 public:
@@ -67,9 +70,11 @@ private:
     // should be publishing events, not searching through the list of
     // subscribers for a particular subscriber. I tested
     // vector/list/map and although there was little difference vector
-    // was the fastest of the three.
+    // was the fastest of the three. The vector is copied on write
+    // so that publishing events doesn't require copying it (see
+    // SubscriberList).
     //
-    std::vector<SubscriberPtr> _subscribers;
+    SubscriberListPtr _subscribers;
 
     bool _destroyed; // Has this Topic been destroyed?
 };
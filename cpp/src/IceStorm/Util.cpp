@@ -19,6 +19,22 @@ namespace IceStormInternal
 IceDB::IceContext dbContext;
 }
 
+namespace
+{
+
+const size_t offsetSize = 8;
+
+void
+writeOffset(Ice::OutputStream& stream, Ice::Long offset)
+{
+    for(size_t i = offsetSize; i > 0; --i)
+    {
+        stream.write(static_cast<Ice::Byte>(offset >> ((i - 1) * 8)));
+    }
+}
+
+}
+
 string
 IceStormInternal::identityToTopicName(const Ice::Identity& id)
 {
@@ -99,3 +115,46 @@ IceStormInternal::getIncrementedLLU(const IceDB::ReadWriteTxn& txn, LLUMap& lluM
     lluMap.put(txn, lluDbKey, llu);
     return llu;
 }
+
+void
+IceDB::Codec<EventRecordKey, IceDB::IceContext, Ice::OutputStream>::read(EventRecordKey& key, const MDB_val& val,
+                                                                         const IceContext& ctx)
+{
+    assert(val.mv_size > offsetSize);
+    const Ice::Byte* begin = static_cast<const Ice::Byte*>(val.mv_data);
+    const Ice::Byte* end = begin + val.mv_size - offsetSize;
+    Ice::InputStream in(ctx.communicator, ctx.encoding, make_pair(begin, end));
+    in.read(key.topic);
+
+    key.offset = 0;
+    for(const Ice::Byte* p = end; p != end + offsetSize; ++p)
+    {
+        key.offset = (key.offset << 8) | *p;
+    }
+}
+
+void
+IceDB::Codec<EventRecordKey, IceDB::IceContext, Ice::OutputStream>::write(const EventRecordKey& key, MDB_val& val,
+                                                                          Ice::OutputStream& holder,
+                                                                          const IceContext& ctx)
+{
+    holder.initialize(ctx.communicator, ctx.encoding);
+    holder.write(key.topic);
+    writeOffset(holder, key.offset);
+    val.mv_size = holder.b.size();
+    val.mv_data = &holder.b[0];
+}
+
+bool
+IceDB::Codec<EventRecordKey, IceDB::IceContext, Ice::OutputStream>::write(const EventRecordKey& key, MDB_val& val,
+                                                                          const IceContext& ctx)
+{
+    const size_t limit = val.mv_size;
+    pair<Ice::Byte*, Ice::Byte*> p(reinterpret_cast<Ice::Byte*>(val.mv_data),
+                                   reinterpret_cast<Ice::Byte*>(val.mv_data) + limit);
+    Ice::OutputStream stream(ctx.communicator, ctx.encoding, p);
+    stream.write(key.topic);
+    writeOffset(stream, key.offset);
+    val.mv_size = stream.b.size();
+    return stream.b.size() <= limit;
+}
@@ -27,11 +27,31 @@ typedef IceUtil::Handle<Instance> InstancePtr;
 typedef IceDB::Dbi<IceStorm::SubscriberRecordKey, IceStorm::SubscriberRecord, IceDB::IceContext, Ice::OutputStream>
         SubscriberMap;
 typedef IceDB::Dbi<std::string, IceStormElection::LogUpdate, IceDB::IceContext, Ice::OutputStream> LLUMap;
+typedef IceDB::Dbi<IceStorm::EventRecordKey, IceStorm::EventRecord, IceDB::IceContext, Ice::OutputStream> EventMap;
 
 const std::string lluDbKey = "_manager";
 
 }
 
+namespace IceDB
+{
+
+//
+// The key of an event record is encoded as the topic identity followed
+// by the offset as a fixed-width big-endian integer. The events of a
+// topic are therefore sorted by offset with the default LMDB key
+// comparison, without unmarshaling the keys.
+//
+template<>
+struct Codec<IceStorm::EventRecordKey, IceContext, Ice::OutputStream>
+{
+    static void read(IceStorm::EventRecordKey&, const MDB_val&, const IceContext&);
+    static void write(const IceStorm::EventRecordKey&, MDB_val&, Ice::OutputStream&, const IceContext&);
+    static bool write(const IceStorm::EventRecordKey&, MDB_val&, const IceContext&);
+};
+
+}
+
 namespace IceStormInternal
 {
 
@@ -19,6 +19,13 @@
 #include <IceUtil/Unicode.h>
 #endif
 
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define ICE_USE_SSE2
+#   include <emmintrin.h>
+#endif
+
 using namespace IceUtil;
 using namespace IceUtilInternal;
 using namespace std;
@@ -34,6 +41,112 @@ IceUtil::WstringConverterPtr processWstringConverter;
 IceUtil::WstringConverterPtr unicodeWstringConverter;
 #endif
 
+//
+// Strings are often mostly made of ASCII characters, the helpers below
+// convert the leading ASCII characters of a string without going through
+// codecvt or ConvertUTF. They check and convert 16 characters at a time
+// with SSE2 when available (it's always available on x86-64) and 8 bytes
+// at a time otherwise. They return the number of characters converted,
+// the target must be large enough for the whole source.
+//
+size_t
+widenASCII(const Byte* sourceStart, const Byte* sourceEnd, wchar_t* target)
+{
+    const Byte* p = sourceStart;
+#ifdef ICE_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    while(sourceEnd - p >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        if(_mm_movemask_epi8(chunk) != 0)
+        {
+            break; // Non-ASCII character in this chunk.
+        }
+
+        __m128i lo = _mm_unpacklo_epi8(chunk, zero);
+        __m128i hi = _mm_unpackhi_epi8(chunk, zero);
+        __m128i* t = reinterpret_cast<__m128i*>(target + (p - sourceStart));
+        if(sizeof(wchar_t) == 2)
+        {
+            _mm_storeu_si128(t, lo);
+            _mm_storeu_si128(t + 1, hi);
+        }
+        else
+        {
+            _mm_storeu_si128(t, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(t + 1, _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(t + 2, _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(t + 3, _mm_unpackhi_epi16(hi, zero));
+        }
+        p += 16;
+    }
+#else
+    while(sourceEnd - p >= 8)
+    {
+        IceUtil::Int64 word;
+        memcpy(&word, p, 8);
+        if(word & ICE_INT64(0x8080808080808080))
+        {
+            break; // Non-ASCII character in this word.
+        }
+
+        wchar_t* t = target + (p - sourceStart);
+        for(int j = 0; j < 8; ++j)
+        {
+            t[j] = static_cast<wchar_t>(p[j]);
+        }
+        p += 8;
+    }
+#endif
+    while(p < sourceEnd && *p < 0x80)
+    {
+        target[p - sourceStart] = static_cast<wchar_t>(*p);
+        ++p;
+    }
+    return static_cast<size_t>(p - sourceStart);
+}
+
+size_t
+narrowASCII(const wchar_t* sourceStart, const wchar_t* sourceEnd, Byte* target)
+{
+    const wchar_t* p = sourceStart;
+#ifdef ICE_USE_SSE2
+    while(sourceEnd - p >= 8)
+    {
+        const __m128i* s = reinterpret_cast<const __m128i*>(p);
+        __m128i chunk;
+        if(sizeof(wchar_t) == 2)
+        {
+            chunk = _mm_loadu_si128(s);
+            if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chunk, _mm_set1_epi16(-0x80)),
+                                                 _mm_setzero_si128())) != 0xFFFF)
+            {
+                break; // Non-ASCII character in this chunk.
+            }
+        }
+        else
+        {
+            __m128i lo = _mm_loadu_si128(s);
+            __m128i hi = _mm_loadu_si128(s + 1);
+            if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(lo, hi), _mm_set1_epi32(-0x80)),
+                                                 _mm_setzero_si128())) != 0xFFFF)
+            {
+                break; // Non-ASCII character in this chunk.
+            }
+            chunk = _mm_packs_epi32(lo, hi);
+        }
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(target + (p - sourceStart)), _mm_packus_epi16(chunk, chunk));
+        p += 8;
+    }
+#endif
+    while(p < sourceEnd && static_cast<unsigned int>(*p) < 0x80)
+    {
+        target[p - sourceStart] = static_cast<Byte>(*p);
+        ++p;
+    }
+    return static_cast<size_t>(p - sourceStart);
+}
+
 #ifdef ICE_HAS_CODECVT_UTF8
 
 template<size_t wcharSize>
@@ -80,9 +193,21 @@ public:
             return buffer.getMoreBytes(1, 0);
         }
 
+        //
+        // Copy the leading ASCII characters, the remaining characters (if any)
+        // are converted with codecvt.
+        //
+        Byte* asciiTarget = buffer.getMoreBytes(sourceEnd - sourceStart, 0);
+        const size_t asciiSize = narrowASCII(sourceStart, sourceEnd, asciiTarget);
+        if(sourceStart + asciiSize == sourceEnd)
+        {
+            return asciiTarget + asciiSize;
+        }
+        sourceStart += asciiSize;
+
         char* targetStart = 0;
         char* targetEnd = 0;
-        char* targetNext = 0;
+        char* targetNext = reinterpret_cast<char*>(asciiTarget + asciiSize);
 
         mbstate_t state = mbstate_t(); // must be initialized!
         const wchar_t* sourceNext = sourceStart;
@@ -161,7 +286,18 @@ public:
             target.resize(sourceSize);
             wchar_t* targetStart = const_cast<wchar_t*>(target.data());
             wchar_t* targetEnd = targetStart + sourceSize;
-            wchar_t* targetNext = targetStart;
+
+            //
+            // Copy the leading ASCII characters, the remaining characters (if any)
+            // are converted with codecvt.
+            //
+            const size_t asciiSize = widenASCII(sourceStart, sourceEnd, targetStart);
+            if(asciiSize == sourceSize)
+            {
+                return;
+            }
+            sourceStart += asciiSize;
+            wchar_t* targetNext = targetStart + asciiSize;
 
             const char* sourceNext = reinterpret_cast<const char*>(sourceStart);
 
@@ -171,7 +307,7 @@ public:
                                                       reinterpret_cast<const char*>(sourceStart),
                                                       reinterpret_cast<const char*>(sourceEnd),
                                                       sourceNext,
-                                                      targetStart, targetEnd, targetNext);
+                                                      targetStart + asciiSize, targetEnd, targetNext);
 
             if(result != codecvt_base::ok)
             {
@@ -201,7 +337,19 @@ public:
             return buffer.getMoreBytes(1, 0);
         }
 
-        Byte* targetStart = 0;
+        //
+        // Copy the leading ASCII characters, the remaining characters (if any)
+        // are converted with ConvertUTF.
+        //
+        Byte* targetStart = buffer.getMoreBytes(sourceEnd - sourceStart, 0);
+        const size_t asciiSize = narrowASCII(sourceStart, sourceEnd, targetStart);
+        targetStart += asciiSize;
+        sourceStart += asciiSize;
+        if(sourceStart == sourceEnd)
+        {
+            return targetStart;
+        }
+
         Byte* targetEnd = 0;
 
         //
@@ -231,7 +379,20 @@ public:
         }
         else
         {
-            convertUTF8ToUTFWstring(sourceStart, sourceEnd, target);
+            //
+            // Copy the leading ASCII characters, the remaining characters (if any)
+            // are converted with ConvertUTF.
+            //
+            const size_t sourceSize = sourceEnd - sourceStart;
+            target.resize(sourceSize);
+            const size_t asciiSize = widenASCII(sourceStart, sourceEnd, const_cast<wchar_t*>(target.data()));
+            if(asciiSize < sourceSize)
+            {
+                wstring tail;
+                sourceStart += asciiSize;
+                convertUTF8ToUTFWstring(sourceStart, sourceEnd, tail);
+                target.replace(asciiSize, wstring::npos, tail);
+            }
         }
     }
 };
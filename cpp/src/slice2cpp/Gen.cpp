@@ -19,6 +19,7 @@
 #include <IceUtil/FileUtil.h>
 
 #include <limits>
+#include <set>
 #include <string.h>
 
 using namespace std;
@@ -79,6 +80,64 @@ isConstexprType(const TypePtr& type)
     }
 }
 
+//
+// Returns true if the struct only contains numeric members other than
+// bool or structs with such members. Without padding, the memory
+// representation of such structs is identical to their encoding on
+// little-endian hosts.
+//
+bool
+isWireCompatible(const StructPtr& s)
+{
+    if(s->hasMetaData("cpp:class"))
+    {
+        return false;
+    }
+
+    DataMemberList members = s->dataMembers();
+    for(DataMemberList::const_iterator i = members.begin(); i != members.end(); ++i)
+    {
+        BuiltinPtr bp = BuiltinPtr::dynamicCast((*i)->type());
+        StructPtr st = StructPtr::dynamicCast((*i)->type());
+        if(bp)
+        {
+            switch(bp->kind())
+            {
+                case Builtin::KindByte:
+                case Builtin::KindShort:
+                case Builtin::KindInt:
+                case Builtin::KindLong:
+                case Builtin::KindFloat:
+                case Builtin::KindDouble:
+                {
+                    break;
+                }
+                default:
+                {
+                    return false;
+                }
+            }
+        }
+        else if(!st || !isWireCompatible(st))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+writeIsWireCompatible(IceUtilInternal::Output& H, const StructPtr& p, const string& name)
+{
+    if(isWireCompatible(p))
+    {
+        H << nl << "template<>";
+        H << nl << "struct IsWireCompatible< " << name << ">";
+        H << sb;
+        H << nl << "static const bool value = sizeof(" << name << ") == " << p->minWireSize() << ";";
+        H << eb << ";" << nl;
+    }
+}
 
 string
 getDeprecateSymbol(const ContainedPtr& p1, const ContainedPtr& p2)
@@ -372,6 +431,91 @@ condString(bool ok, const string& str)
     return ok ? str : "";
 }
 
+//
+// Writes the dispatch of operations whose names have the same length. If
+// there are more than two operations, they are selected with a switch on
+// the character which best discriminates their names, so the operation
+// name is compared at most twice.
+//
+void
+writeDispatchCases(IceUtilInternal::Output& C, const StringList& names)
+{
+    if(names.size() <= 2)
+    {
+        for(StringList::const_iterator q = names.begin(); q != names.end(); ++q)
+        {
+            C << nl << "if(current.operation == \"" << *q << "\")";
+            C << sb;
+            C << nl << "return _iceD_" << *q << "(in, current);";
+            C << eb;
+        }
+        return;
+    }
+
+    size_t position = 0;
+    size_t distinct = 0;
+    for(size_t i = 0; i < names.front().size(); ++i)
+    {
+        set<char> chars;
+        for(StringList::const_iterator q = names.begin(); q != names.end(); ++q)
+        {
+            chars.insert((*q)[i]);
+        }
+        if(chars.size() > distinct)
+        {
+            position = i;
+            distinct = chars.size();
+        }
+    }
+
+    map<char, StringList> groups;
+    for(StringList::const_iterator q = names.begin(); q != names.end(); ++q)
+    {
+        groups[(*q)[position]].push_back(*q);
+    }
+
+    C << nl << "switch(current.operation[" << position << "])";
+    C << sb;
+    for(map<char, StringList>::const_iterator g = groups.begin(); g != groups.end(); ++g)
+    {
+        C << nl << "case '" << g->first << "':";
+        C << sb;
+        writeDispatchCases(C, g->second);
+        C << nl << "break;";
+        C << eb;
+    }
+    C << eb;
+}
+
+//
+// Writes the body of _iceDispatch. The operation is selected with a switch
+// on the length of its name rather than with a binary search over the
+// operation names.
+//
+void
+writeDispatch(IceUtilInternal::Output& C, const StringList& names)
+{
+    map<size_t, StringList> groups;
+    for(StringList::const_iterator q = names.begin(); q != names.end(); ++q)
+    {
+        groups[q->size()].push_back(*q);
+    }
+
+    C << nl << "switch(current.operation.size())";
+    C << sb;
+    for(map<size_t, StringList>::const_iterator g = groups.begin(); g != groups.end(); ++g)
+    {
+        C << nl << "case " << g->first << ':';
+        C << sb;
+        writeDispatchCases(C, g->second);
+        C << nl << "break;";
+        C << eb;
+    }
+    C << eb;
+    C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, "
+      << "current.operation);";
+}
+
 }
 
 Slice::Gen::Gen(const string& base, const string& headerExtension, const string& sourceExtension,
@@ -2551,53 +2695,11 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
             H << sp;
             H << nl << "virtual bool _iceDispatch(::IceInternal::Incoming&, const ::Ice::Current&);";
 
-            string flatName = "iceC" + p->flattenedScope() + p->name() + "_all";
-            C << sp << nl << "namespace";
-            C << nl << "{";
-            C << nl << "const ::std::string " << flatName << "[] =";
-            C << sb;
-
-            for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
-            {
-                C << nl << '"' << *q << '"';
-                if(++q != allOpNames.end())
-                {
-                    C << ',';
-                }
-            }
-            C << eb << ';';
-            C << sp << nl << "}";
             C << sp;
             C << nl << "bool";
             C << nl << scoped.substr(2) << "::_iceDispatch(::IceInternal::Incoming& in, const ::Ice::Current& current)";
             C << sb;
-
-            C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-              << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
-              << ", current.operation);";
-            C << nl << "if(r.first == r.second)";
-            C << sb;
-            C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, "
-              << "current.facet, current.operation);";
-            C << eb;
-            C << sp;
-            C << nl << "switch(r.first - " << flatName << ')';
-            C << sb;
-            int i = 0;
-            for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
-            {
-                C << nl << "case " << i++ << ':';
-                C << sb;
-                C << nl << "return _iceD_" << *q << "(in, current);";
-                C << eb;
-            }
-            C << nl << "default:";
-            C << sb;
-            C << nl << "assert(false);";
-            C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, "
-              << "current.facet, current.operation);";
-            C << eb;
-            C << eb;
+            writeDispatch(C, allOpNames);
             C << eb;
 
             //
@@ -2619,10 +2721,23 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
                 H << nl
                   << "virtual ::Ice::Int ice_operationAttributes(const ::std::string&) const;";
 
+                string flatName = "iceC" + p->flattenedScope() + p->name() + "_all";
                 string opAttrFlatName = "iceC" + p->flattenedScope() + p->name() + "_operationAttributes";
 
                 C << sp << nl << "namespace";
                 C << nl << "{";
+                C << nl << "const ::std::string " << flatName << "[] =";
+                C << sb;
+                for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
+                {
+                    C << nl << '"' << *q << '"';
+                    if(++q != allOpNames.end())
+                    {
+                        C << ',';
+                    }
+                }
+                C << eb << ';';
+                C << sp;
                 C << nl << "const int " << opAttrFlatName << "[] = ";
                 C << sb;
 
@@ -4441,6 +4556,11 @@ Slice::Gen::StreamVisitor::visitStructStart(const StructPtr& p)
         }
         H << eb << ";" << nl;
 
+        if(!classMetaData)
+        {
+            writeIsWireCompatible(H, p, fullStructName);
+        }
+
         writeStreamHelpers(H, p, p->dataMembers(), false, true, false);
     }
     return false;
@@ -5184,27 +5304,6 @@ Slice::Gen::Cpp11DeclVisitor::visitClassDefStart(const ClassDefPtr& p)
             }
         }
         C << eb << ';';
-
-        StringList allOpNames;
-        transform(allOps.begin(), allOps.end(), back_inserter(allOpNames), ::IceUtil::constMemFun(&Contained::name));
-        allOpNames.push_back("ice_id");
-        allOpNames.push_back("ice_ids");
-        allOpNames.push_back("ice_isA");
-        allOpNames.push_back("ice_ping");
-        allOpNames.sort();
-        allOpNames.unique();
-
-        C << nl << "const ::std::string iceC" << p->flattenedScope() << p->name() << "_ops[] =";
-        C << sb;
-        for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
-        {
-            C << nl << '"' << *q << '"';
-            if(++q != allOpNames.end())
-            {
-                C << ',';
-            }
-        }
-        C << eb << ';';
     }
 
     return true;
@@ -6790,8 +6889,6 @@ Slice::Gen::Cpp11InterfaceVisitor::visitClassDefEnd(const ClassDefPtr& p)
         allOpNames.sort();
         allOpNames.unique();
 
-        string flatName = "iceC" + p->flattenedScope() + p->name() + "_ops";
-
         H << sp;
         H << nl << "virtual bool _iceDispatch(::IceInternal::Incoming&, const ::Ice::Current&) override;";
 
@@ -6799,30 +6896,7 @@ Slice::Gen::Cpp11InterfaceVisitor::visitClassDefEnd(const ClassDefPtr& p)
         C << nl << "bool";
         C << nl << scoped.substr(2) << "::_iceDispatch(::IceInternal::Incoming& in, const ::Ice::Current& current)";
         C << sb;
-
-        C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-          << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size() << ", current.operation);";
-        C << nl << "if(r.first == r.second)";
-        C << sb;
-        C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);";
-        C << eb;
-        C << sp;
-        C << nl << "switch(r.first - " << flatName << ')';
-        C << sb;
-        int i = 0;
-        for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
-        {
-            C << nl << "case " << i++ << ':';
-            C << sb;
-            C << nl << "return _iceD_" << *q << "(in, current);";
-            C << eb;
-        }
-        C << nl << "default:";
-        C << sb;
-        C << nl << "assert(false);";
-        C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);";
-        C << eb;
-        C << eb;
+        writeDispatch(C, allOpNames);
         C << eb;
     }
 
@@ -7499,6 +7573,8 @@ Slice::Gen::Cpp11StreamVisitor::visitStructStart(const StructPtr& p)
     H << nl << "static const bool fixedLength = " << (p->isVariableLength() ? "false" : "true") << ";";
     H << eb << ";" << nl;
 
+    writeIsWireCompatible(H, p, scoped);
+
     writeStreamHelpers(H, p, p->dataMembers(), false, false, true);
 
     return false;
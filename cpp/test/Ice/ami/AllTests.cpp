@@ -881,6 +881,220 @@ private:
 typedef IceUtil::Handle<Thrower> ThrowerPtr;
 #endif
 
+//
+// Records the threads that dispatch the responses of asynchronous invocations.
+//
+class ThreadRecorder : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    ThreadRecorder() :
+        _count(0)
+    {
+    }
+
+    void response()
+    {
+        Lock sync(*this);
+        _threads.insert(IceUtil::ThreadControl().id());
+        ++_count;
+        notifyAll();
+    }
+
+    void exception(const Ice::Exception&)
+    {
+        test(false);
+    }
+
+    size_t waitForResponses(int count)
+    {
+        Lock sync(*this);
+        while(_count < count)
+        {
+            wait();
+        }
+        return _threads.size();
+    }
+
+private:
+
+    set<IceUtil::ThreadControl::ID> _threads;
+    int _count;
+};
+typedef IceUtil::Handle<ThreadRecorder> ThreadRecorderPtr;
+
+void
+testShards(const Ice::CommunicatorPtr& communicator, const string& sref)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.ThreadPool.Client.Shards", "3");
+    initData.properties->setProperty("Ice.ThreadPool.Client.Size", "1");
+    initData.properties->setProperty("Ice.ThreadPool.Client.SizeMax", "1");
+    Ice::CommunicatorHolder ich = Ice::initialize(initData);
+
+    //
+    // Connections are assigned to the shards in a round-robin fashion, so the responses
+    // received over 3 connections must be dispatched by the single thread of each shard.
+    //
+    vector<Test::TestIntfPrxPtr> proxies;
+    for(int i = 0; i < 3; ++i)
+    {
+        ostringstream os;
+        os << "shard-" << i;
+        Test::TestIntfPrxPtr prx =
+            ICE_UNCHECKED_CAST(Test::TestIntfPrx, ich->stringToProxy(sref)->ice_connectionId(os.str()));
+        prx->ice_ping();
+        proxies.push_back(prx);
+    }
+
+    ThreadRecorderPtr recorder = new ThreadRecorder();
+    for(int i = 0; i < 30; ++i)
+    {
+#ifdef ICE_CPP11_MAPPING
+        proxies[i % 3]->opAsync([recorder]() { recorder->response(); }, [](exception_ptr) { test(false); });
+#else
+        proxies[i % 3]->begin_op(Test::newCallback_TestIntf_op(recorder, &ThreadRecorder::response,
+                                                               &ThreadRecorder::exception));
+#endif
+    }
+    test(recorder->waitForResponses(30) == 3);
+}
+
+void
+sendBatch(const Test::TestIntfPrxPtr& oneway, int count)
+{
+    //
+    // Synchronous oneway requests wait to be sent and would wait for the cork
+    // delay to expire.
+    //
+    for(int i = 0; i < count; ++i)
+    {
+#ifdef ICE_CPP11_MAPPING
+        oneway->opBatchAsync();
+#else
+        oneway->begin_opBatch();
+#endif
+    }
+}
+
+void
+waitForBatch(const Test::TestIntfPrxPtr& p, int count)
+{
+    //
+    // Poll the batch count rather than blocking the server thread pool with
+    // waitForBatch while the requests are received over another connection.
+    //
+    for(int i = 0; i < 500 && p->opBatchCount() < count; ++i)
+    {
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+    }
+    test(p->opBatchCount() == count);
+    test(p->waitForBatch(count));
+}
+
+void
+testCorking(const Ice::CommunicatorPtr& communicator, const string& sref)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.Cork.Delay", "2000000"); // 2s
+    initData.properties->setProperty("Ice.Cork.MaxBytes", "1400");
+    Ice::CommunicatorHolder ich = Ice::initialize(initData);
+
+    Test::TestIntfPrxPtr p = ICE_UNCHECKED_CAST(Test::TestIntfPrx, ich->stringToProxy(sref));
+    Test::TestIntfPrxPtr oneway = p->ice_oneway();
+    Test::TestIntfPrxPtr q = ICE_UNCHECKED_CAST(Test::TestIntfPrx, communicator->stringToProxy(sref));
+    Ice::ByteSeq seq(1000);
+
+    //
+    // Small oneway requests are held until the cork delay expires.
+    //
+    p->ice_getConnection();
+    {
+#ifdef ICE_CPP11_MAPPING
+        vector<future<void>> results;
+        for(int i = 0; i < 5; ++i)
+        {
+            results.push_back(oneway->opBatchAsync());
+        }
+        test(results.back().wait_for(chrono::milliseconds(0)) != future_status::ready);
+        results.back().get();
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < 5; ++i)
+        {
+            results.push_back(oneway->begin_opBatch());
+        }
+        test(!results.back()->isSent());
+        results.back()->waitForSent();
+#endif
+        waitForBatch(q, 5);
+    }
+
+    //
+    // The corked requests are sent as soon as Ice.Cork.MaxBytes is reached.
+    //
+    {
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        sendBatch(oneway, 1);
+#ifdef ICE_CPP11_MAPPING
+        oneway->opWithPayloadAsync(seq);
+        oneway->opWithPayloadAsync(seq);
+#else
+        oneway->begin_opWithPayload(seq);
+        oneway->begin_opWithPayload(seq);
+#endif
+        waitForBatch(q, 1);
+        test(IceUtil::Time::now(IceUtil::Time::Monotonic) - start < IceUtil::Time::seconds(1));
+    }
+
+    //
+    // Oneway and twoway requests are corked together and sent in order. A
+    // request larger than Ice.Cork.MaxBytes flushes the corked requests.
+    //
+    {
+        sendBatch(oneway, 2);
+        test(p->opWithResult() == 15);
+        sendBatch(oneway, 1);
+        test(p->waitForBatch(3));
+        sendBatch(oneway, 1);
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        p->opWithPayload(Ice::ByteSeq(2000));
+        test(IceUtil::Time::now(IceUtil::Time::Monotonic) - start < IceUtil::Time::seconds(1));
+        waitForBatch(q, 1);
+    }
+
+    //
+    // A corked request which times out is removed from the send queue, it
+    // isn't sent once the cork delay expires.
+    //
+    {
+        try
+        {
+            p->ice_invocationTimeout(100)->opBatch();
+            test(false);
+        }
+        catch(const Ice::InvocationTimeoutException&)
+        {
+        }
+        sendBatch(oneway, 1);
+        waitForBatch(q, 1);
+    }
+
+    //
+    // The close connection message isn't corked, the corked requests are sent
+    // right away before it.
+    //
+    {
+        sendBatch(oneway, 5);
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        p->ice_getConnection()->close(false);
+        waitForBatch(q, 5);
+        test(IceUtil::Time::now(IceUtil::Time::Monotonic) - start < IceUtil::Time::seconds(1));
+    }
+}
+
 }
 
 void
@@ -2235,6 +2449,20 @@ allTests(const Ice::CommunicatorPtr& communicator, bool collocated)
 
     }
 
+    if(p->ice_getConnection())
+    {
+        cout << "testing sharded thread pool... " << flush;
+        testShards(communicator, p->ice_toString());
+        cout << "ok" << endl;
+    }
+
+    if(p->ice_getConnection())
+    {
+        cout << "testing corking... " << flush;
+        testCorking(communicator, p->ice_toString());
+        cout << "ok" << endl;
+    }
+
     p->shutdown();
 
 #else
@@ -3777,6 +4005,20 @@ allTests(const Ice::CommunicatorPtr& communicator, bool collocated)
         cout << "ok" << endl;
     }
 
+    if(p->ice_getConnection())
+    {
+        cout << "testing sharded thread pool... " << flush;
+        testShards(communicator, p->ice_toString());
+        cout << "ok" << endl;
+    }
+
+    if(p->ice_getConnection())
+    {
+        cout << "testing corking... " << flush;
+        testCorking(communicator, p->ice_toString());
+        cout << "ok" << endl;
+    }
+
     p->shutdown();
 #endif
 }
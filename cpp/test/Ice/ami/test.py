@@ -0,0 +1,25 @@
+# **********************************************************************
+#
+# Copyright (c) 2003-2016 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+#
+# Also run the test with sharded thread pools on both the client and server sides.
+#
+shardsProps = {
+    "Ice.ThreadPool.Client.Shards" : 3,
+    "Ice.ThreadPool.Server.Shards" : 3
+}
+
+testcases = [
+    ClientServerTestCase(),
+    ClientServerTestCase(name="client/server with sharded thread pools", client=Client(props=shardsProps),
+                         server=Server(props=shardsProps)),
+    CollocatedTestCase()
+]
+
+TestSuite(__name__, testcases)
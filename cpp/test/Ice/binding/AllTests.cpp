@@ -100,6 +100,70 @@ deactivate(const RemoteCommunicatorPrxPtr& com, vector<RemoteObjectAdapterPrxPtr
     }
 }
 
+class ConnectionPoolI : public Ice::Blobject, public IceUtil::Mutex
+{
+public:
+
+    virtual bool
+    ice_invoke(const vector<Ice::Byte>&, vector<Ice::Byte>&, const Ice::Current& current)
+    {
+        {
+            IceUtil::Mutex::Lock sync(*this);
+            ++_requests[current.con];
+        }
+        if(current.operation == "sleep")
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(50));
+        }
+        else if(current.operation == "close")
+        {
+            current.con->close(true);
+        }
+        return true;
+    }
+
+    //
+    // Returns the number of requests received over each connection since
+    // the last call.
+    //
+    map<Ice::ConnectionPtr, int>
+    reset()
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        map<Ice::ConnectionPtr, int> requests;
+        requests.swap(_requests);
+        return requests;
+    }
+
+private:
+
+    map<Ice::ConnectionPtr, int> _requests;
+};
+ICE_DEFINE_PTR(ConnectionPoolIPtr, ConnectionPoolI);
+
+bool
+waitForConnectionPool(const Ice::ObjectPrxPtr& prx, const ConnectionPoolIPtr& servant, size_t size)
+{
+    //
+    // The pooled connections are established in the background and the
+    // requests are spread over the pooled connections once established.
+    //
+    for(int i = 0; i < 100; ++i)
+    {
+        servant->reset();
+        for(size_t j = 0; j < size * 3; ++j)
+        {
+            prx->ice_ping();
+        }
+        if(servant->reset().size() == size)
+        {
+            return true;
+        }
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(20));
+    }
+    return false;
+}
+
 void
 allTests(const Ice::CommunicatorPtr& communicator)
 {
@@ -805,6 +869,158 @@ allTests(const Ice::CommunicatorPtr& communicator)
     }
     cout << "ok" << endl;
 
+    cout << "testing parallel connect... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.Default.ParallelConnect", "200");
+        initData.properties->setProperty("Ice.Override.ConnectTimeout", "10000");
+        Ice::CommunicatorHolder ich = Ice::initialize(initData);
+
+        vector<RemoteObjectAdapterPrxPtr> adapters;
+        adapters.push_back(com->createObjectAdapter("Adapter91", "default"));
+        adapters.push_back(com->createObjectAdapter("Adapter92", "default"));
+        adapters.push_back(com->createObjectAdapter("Adapter93", "default"));
+
+        string proxy = communicator->proxyToString(createTestIntfPrx(adapters));
+        TestIntfPrxPtr test = ICE_UNCHECKED_CAST(TestIntfPrx, ich->stringToProxy(proxy));
+        test = ICE_UNCHECKED_CAST(TestIntfPrx, test->ice_endpointSelection(Ice::Ordered));
+        test(test->getAdapterName() == "Adapter91");
+        test->ice_getConnection()->close(false);
+
+        //
+        // The held adapter accepts the connection at the transport level but
+        // never validates it. The second endpoint is tried once the parallel
+        // connect delay expires, without waiting for the connect timeout of
+        // the first endpoint.
+        //
+        adapters[0]->hold();
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        test(test->getAdapterName() == "Adapter92");
+        IceUtil::Time elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+        test(elapsed >= IceUtil::Time::milliSeconds(150) && elapsed < IceUtil::Time::seconds(2));
+        test->ice_getConnection()->close(false);
+
+        //
+        // Connecting to the deactivated adapters fails right away, the
+        // connection is established with the remaining adapter.
+        //
+        com->deactivateObjectAdapter(adapters[0]);
+        com->deactivateObjectAdapter(adapters[1]);
+        test(test->getAdapterName() == "Adapter93");
+        test->ice_getConnection()->close(false);
+
+        com->deactivateObjectAdapter(adapters[2]);
+        try
+        {
+            test->ice_ping();
+            test(false);
+        }
+        catch(const Ice::ConnectFailedException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing connection pooling... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Pool.Endpoints", "default");
+        initData.properties->setProperty("Pool.ThreadPool.Size", "5");
+        Ice::CommunicatorHolder serverCommunicator = Ice::initialize(initData);
+        Ice::ObjectAdapterPtr adapter = serverCommunicator->createObjectAdapter("Pool");
+        ConnectionPoolIPtr servant = ICE_MAKE_SHARED(ConnectionPoolI);
+        string proxy = serverCommunicator->proxyToString(adapter->add(servant, Ice::stringToIdentity("pool")));
+        adapter->activate();
+
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.Default.ConnectionPoolSize", "3");
+        Ice::CommunicatorHolder ich = Ice::initialize(initData);
+        Ice::ObjectPrxPtr prx = ich->stringToProxy(proxy);
+
+        //
+        // The pool grows up to the pool size once the first connection is
+        // established.
+        //
+        test(waitForConnectionPool(prx, servant, 3));
+        for(int i = 0; i < 10; ++i)
+        {
+            prx->ice_ping();
+        }
+        test(servant->reset().size() == 3);
+
+        //
+        // Concurrent requests are sent over the least loaded connections.
+        //
+        vector<Ice::Byte> inParams;
+        vector<Ice::Byte> outParams;
+#ifdef ICE_CPP11_MAPPING
+        vector<future<Ice::Object::Ice_invokeResult>> results;
+        for(int i = 0; i < 30; ++i)
+        {
+            results.push_back(prx->ice_invokeAsync("sleep", Ice::OperationMode::Normal, inParams));
+        }
+        for(vector<future<Ice::Object::Ice_invokeResult>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            p->get();
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < 30; ++i)
+        {
+            results.push_back(prx->begin_ice_invoke("sleep", Ice::Normal, inParams));
+        }
+        for(vector<Ice::AsyncResultPtr>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            prx->end_ice_invoke(outParams, *p);
+        }
+#endif
+        map<Ice::ConnectionPtr, int> requests = servant->reset();
+        test(requests.size() == 3);
+        for(map<Ice::ConnectionPtr, int>::const_iterator p = requests.begin(); p != requests.end(); ++p)
+        {
+            test(p->second >= 5);
+        }
+
+        //
+        // A pooled connection lost abnormally is replaced, the requests of
+        // the proxy bound to the lost connection are sent over the other
+        // connections.
+        //
+        try
+        {
+#ifdef ICE_CPP11_MAPPING
+            prx->ice_invoke("close", Ice::OperationMode::Normal, inParams, outParams);
+#else
+            prx->ice_invoke("close", Ice::Normal, inParams, outParams);
+#endif
+            test(false);
+        }
+        catch(const Ice::ConnectionLostException&)
+        {
+        }
+        test(waitForConnectionPool(prx, servant, 3));
+        for(int i = 0; i < 10; ++i)
+        {
+            prx->ice_ping();
+        }
+        test(servant->reset().size() == 3);
+
+        //
+        // A pooled connection closed gracefully isn't replaced.
+        //
+        prx->ice_getConnection()->close(false);
+        test(waitForConnectionPool(prx, servant, 2));
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+        for(int i = 0; i < 10; ++i)
+        {
+            prx->ice_ping();
+        }
+        test(servant->reset().size() == 2);
+    }
+    cout << "ok" << endl;
+
     cout << "testing endpoint mode filtering... " << flush;
     {
         vector<RemoteObjectAdapterPrxPtr> adapters;
@@ -77,6 +77,12 @@ RemoteObjectAdapterI::getTestIntf(const Ice::Current&)
     return _testIntf;
 }
 
+void
+RemoteObjectAdapterI::hold(const Ice::Current&)
+{
+    _adapter->hold();
+}
+
 void
 RemoteObjectAdapterI::deactivate(const Ice::Current& current)
 {
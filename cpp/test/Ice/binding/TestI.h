@@ -40,6 +40,7 @@ public:
     RemoteObjectAdapterI(const Ice::ObjectAdapterPtr&);
     
     virtual Test::TestIntfPrxPtr getTestIntf(const Ice::Current&);
+    virtual void hold(const Ice::Current&);
     virtual void deactivate(const Ice::Current&);
 
 private:
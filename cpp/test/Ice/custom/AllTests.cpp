@@ -691,6 +691,71 @@ allTests(const Ice::CommunicatorPtr& communicator)
         test(ret == in);
     }
 
+    {
+        //
+        // Large byte sequences are sent without being copied to the
+        // request stream by synchronous invocations.
+        //
+        vector<Ice::Byte> inArray(300 * 1024);
+        for(size_t i = 0; i < inArray.size(); ++i)
+        {
+            inArray[i] = static_cast<Ice::Byte>(i % 251);
+        }
+        Test::ByteList in(inArray.begin(), inArray.end());
+        pair<const Ice::Byte*, const Ice::Byte*> inPair(&inArray[0], &inArray[0] + inArray.size());
+
+        Test::ByteList out;
+        Test::ByteList ret = t->opByteArray(inPair, out);
+        test(out == in);
+        test(ret == in);
+    }
+
+    {
+        //
+        // Send more large byte sequences than the transport can gather
+        // with a single write.
+        //
+        Test::ByteSeqList in;
+        for(int i = 0; i < 70; ++i)
+        {
+            Test::ByteSeq seq(64 * 1024);
+            for(size_t j = 0; j < seq.size(); ++j)
+            {
+                seq[j] = static_cast<Ice::Byte>((i + j) % 251);
+            }
+            in.push_back(seq);
+        }
+        test(t->opByteSeqList(in) == in);
+    }
+
+    {
+        //
+        // The array of a deferred asynchronous dispatch references the request
+        // memory, it must remain valid while the server receives other requests
+        // over the connection.
+        //
+        vector<Ice::Byte> inArray1(1024, 1);
+        vector<Ice::Byte> inArray2(1024, 2);
+        pair<const Ice::Byte*, const Ice::Byte*> inPair1(&inArray1[0], &inArray1[0] + inArray1.size());
+        pair<const Ice::Byte*, const Ice::Byte*> inPair2(&inArray2[0], &inArray2[0] + inArray2.size());
+#ifdef ICE_CPP11_MAPPING
+        auto r = t->opByteArrayDeferredAsync(inPair1);
+#else
+        Ice::AsyncResultPtr r = t->begin_opByteArrayDeferred(inPair1);
+#endif
+        for(int i = 0; i < 3; ++i)
+        {
+            Test::ByteList out;
+            t->opByteArray(inPair2, out);
+            test(out == Test::ByteList(inArray2.begin(), inArray2.end()));
+        }
+#ifdef ICE_CPP11_MAPPING
+        test(r.get() == Test::ByteList(inArray1.begin(), inArray1.end()));
+#else
+        test(t->end_opByteArrayDeferred(r) == Test::ByteList(inArray1.begin(), inArray1.end()));
+#endif
+    }
+
     {
         Test::VariableList in;
         Test::Variable inArray[5];
@@ -47,6 +47,7 @@ main(int argc, char** argv)
         setProcessWstringConverter(ICE_MAKE_SHARED(Test::WstringConverterI));
 
         Ice::InitializationData initData = getTestInitData(argc, argv);
+        initData.properties->setProperty("Ice.MessageSizeMax", "10000"); // For the large byte sequence lists.
         communicator = Ice::initialize(argc, argv, initData);
         status = run(argc, argv, communicator);
     }
@@ -10,11 +10,80 @@
 #include <Ice/Communicator.h>
 #include <TestAMDI.h>
 
+namespace
+{
+
+//
+// Sends the response of a deferred dispatch from a separate thread, once the
+// dispatch returned.
+//
+#ifdef ICE_CPP11_MAPPING
+class DeferredResponseThread : public IceUtil::Thread
+{
+public:
+
+    DeferredResponseThread(std::function<void()> response) :
+        _response(std::move(response))
+    {
+    }
+
+    virtual void run()
+    {
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        _response();
+    }
+
+private:
+
+    std::function<void()> _response;
+};
+#else
+class DeferredResponseThread : public IceUtil::Thread
+{
+public:
+
+    DeferredResponseThread(const Test::AMD_TestIntf_opByteArrayDeferredPtr& cb,
+                           const std::pair<const Ice::Byte*, const Ice::Byte*>& inSeq) :
+        _cb(cb),
+        _inSeq(inSeq)
+    {
+    }
+
+    virtual void run()
+    {
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        _cb->ice_response(_inSeq);
+    }
+
+private:
+
+    const Test::AMD_TestIntf_opByteArrayDeferredPtr _cb;
+    const std::pair<const Ice::Byte*, const Ice::Byte*> _inSeq;
+};
+#endif
+
+}
+
 TestIntfI::TestIntfI(const Ice::CommunicatorPtr& communicator)
     : _communicator(communicator)
 {
 }
 
+void
+TestIntfI::deferResponse(const IceUtil::ThreadPtr& thread)
+{
+    IceUtil::Mutex::Lock sync(_deferredMutex);
+    if(_deferredThread)
+    {
+        _deferredThread->getThreadControl().join();
+    }
+    _deferredThread = thread;
+    if(_deferredThread)
+    {
+        _deferredThread->start();
+    }
+}
+
 #ifdef ICE_CPP11_MAPPING
 
 void
@@ -44,6 +113,26 @@ TestIntfI::opByteArrayAsync(std::pair<const Ice::Byte*, const Ice::Byte*> in,
     response(in, in);
 }
 
+void
+TestIntfI::opByteSeqListAsync(Test::ByteSeqList in,
+                              std::function<void(const Test::ByteSeqList&)> response,
+                              std::function<void(std::exception_ptr)>, const Ice::Current&)
+{
+    response(in);
+}
+
+void
+TestIntfI::opByteArrayDeferredAsync(std::pair<const Ice::Byte*, const Ice::Byte*> in,
+                                    std::function<void(const std::pair<const Ice::Byte*, const Ice::Byte*>&)> response,
+                                    std::function<void(std::exception_ptr)>, const Ice::Current&)
+{
+    //
+    // The array references the request memory, which must remain valid
+    // until the response is sent.
+    //
+    deferResponse(new DeferredResponseThread([in, response]() { response(in); }));
+}
+
 void
 TestIntfI::opVariableArrayAsync(std::pair<const Test::Variable*, const Test::Variable*> in,
                                 std::function<void(const Test::VariableList&, const Test::VariableList&)> response,
@@ -350,6 +439,7 @@ void
 TestIntfI::shutdownAsync(std::function<void()> response,
                          std::function<void(std::exception_ptr)>, const Ice::Current&)
 {
+    deferResponse(0);
     _communicator->shutdown();
     response();
 }
@@ -382,6 +472,26 @@ TestIntfI::opByteArray_async(const Test::AMD_TestIntf_opByteArrayPtr& opByteArra
     opByteArrayCB->ice_response(inSeq, inSeq);
 }
 
+void
+TestIntfI::opByteSeqList_async(const Test::AMD_TestIntf_opByteSeqListPtr& opByteSeqListCB,
+                               const Test::ByteSeqList& inSeq,
+                               const Ice::Current&)
+{
+    opByteSeqListCB->ice_response(inSeq);
+}
+
+void
+TestIntfI::opByteArrayDeferred_async(const Test::AMD_TestIntf_opByteArrayDeferredPtr& opByteArrayDeferredCB,
+                                     const std::pair<const Ice::Byte*, const Ice::Byte*>& inSeq,
+                                     const Ice::Current&)
+{
+    //
+    // The array references the request memory, which must remain valid
+    // until the response is sent.
+    //
+    deferResponse(new DeferredResponseThread(opByteArrayDeferredCB, inSeq));
+}
+
 void
 TestIntfI::opVariableArray_async(const Test::AMD_TestIntf_opVariableArrayPtr& opVariableArrayCB,
                                  const std::pair<const Test::Variable*, const Test::Variable*>& inSeq,
@@ -702,6 +812,7 @@ void
 TestIntfI::shutdown_async(const Test::AMD_TestIntf_shutdownPtr& shutdownCB,
                           const Ice::Current&)
 {
+    deferResponse(0);
     _communicator->shutdown();
     shutdownCB->ice_response();
 }
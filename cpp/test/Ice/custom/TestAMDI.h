@@ -10,6 +10,7 @@
 #ifndef TEST_I_H
 #define TEST_I_H
 
+#include <IceUtil/Thread.h>
 #include <TestAMD.h>
 
 class TestIntfI : public virtual Test::TestIntf
@@ -35,6 +36,14 @@ public:
                                               const std::pair<const ::Ice::Byte*, const ::Ice::Byte*>&)>,
                           std::function<void(std::exception_ptr)>, const Ice::Current&) override;
 
+    void opByteSeqListAsync(::Test::ByteSeqList,
+                            std::function<void(const ::Test::ByteSeqList&)>,
+                            std::function<void(std::exception_ptr)>, const Ice::Current&) override;
+
+    void opByteArrayDeferredAsync(std::pair<const ::Ice::Byte*, const ::Ice::Byte*>,
+                                  std::function<void(const std::pair<const ::Ice::Byte*, const ::Ice::Byte*>&)>,
+                                  std::function<void(std::exception_ptr)>, const Ice::Current&) override;
+
     void opVariableArrayAsync(std::pair<const ::Test::Variable*, const ::Test::Variable*>,
                               std::function<void(const ::Test::VariableList&, const ::Test::VariableList&)>,
                               std::function<void(std::exception_ptr)>, const Ice::Current&) override;
@@ -234,6 +243,14 @@ public:
                                    const std::pair<const ::Ice::Byte*, const ::Ice::Byte*>&,
                                    const Ice::Current&);
 
+    virtual void opByteSeqList_async(const Test::AMD_TestIntf_opByteSeqListPtr&,
+                                     const Test::ByteSeqList&,
+                                     const Ice::Current&);
+
+    virtual void opByteArrayDeferred_async(const Test::AMD_TestIntf_opByteArrayDeferredPtr&,
+                                           const std::pair<const ::Ice::Byte*, const ::Ice::Byte*>&,
+                                           const Ice::Current&);
+
     virtual void opVariableArray_async(const Test::AMD_TestIntf_opVariableArrayPtr&,
                                        const std::pair<const Test::Variable*, const Test::Variable*>&,
                                        const Ice::Current&);
@@ -382,7 +399,12 @@ public:
 
 private:
 
+    void deferResponse(const IceUtil::ThreadPtr&);
+
     Ice::CommunicatorPtr _communicator;
+
+    IceUtil::Mutex _deferredMutex;
+    IceUtil::ThreadPtr _deferredThread;
 };
 
 #endif
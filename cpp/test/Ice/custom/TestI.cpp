@@ -42,6 +42,18 @@ TestIntfI::opByteArray(ICE_IN(std::pair<const Ice::Byte*, const Ice::Byte*>) inS
     return outSeq;
 }
 
+Test::ByteSeqList
+TestIntfI::opByteSeqList(ICE_IN(Test::ByteSeqList) inSeq, const Ice::Current&)
+{
+    return inSeq;
+}
+
+Test::ByteList
+TestIntfI::opByteArrayDeferred(ICE_IN(std::pair<const Ice::Byte*, const Ice::Byte*>) inSeq, const Ice::Current&)
+{
+    return Test::ByteList(inSeq.first, inSeq.second);
+}
+
 Test::VariableList
 TestIntfI::opVariableArray(ICE_IN(std::pair<const Test::Variable*, const Test::Variable*>) inSeq,
                            Test::VariableList& outSeq,
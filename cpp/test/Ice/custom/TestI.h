@@ -41,6 +41,11 @@ public:
                                        Test::ByteList&,
                                        const Ice::Current&);
 
+    virtual Test::ByteSeqList opByteSeqList(ICE_IN(Test::ByteSeqList), const Ice::Current&);
+
+    virtual Test::ByteList opByteArrayDeferred(ICE_IN(std::pair<const Ice::Byte*, const Ice::Byte*>),
+                                               const Ice::Current&);
+
     virtual Test::VariableList opVariableArray(ICE_IN(std::pair<const Test::Variable*, const Test::Variable*>),
                                                Test::VariableList&,
                                                const Ice::Current&);
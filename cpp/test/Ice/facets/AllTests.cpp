@@ -253,5 +253,47 @@ allTests(const Ice::CommunicatorPtr& communicator)
     test(hf->callH() == "H");
     cout << "ok" << endl;
 
+    cout << "testing facets and contexts of dispatched requests... " << flush;
+    {
+        IPrxPtr i = ICE_UNCHECKED_CAST(IPrx, communicator->stringToProxy("i:" + getTestEndpoint(communicator, 0)));
+        test(i->getFacet().empty());
+        test(i->getContext().empty());
+
+        Ice::Context ctx;
+        ctx["one"] = "1";
+        ctx["two"] = "";
+        ctx[string(100, 'k')] = string(100, 'v');
+
+        const string longFacet = "facetI with a name longer than the small string buffer";
+        const char* facets[] = { "facetI", longFacet.c_str() };
+        for(size_t n = 0; n < sizeof(facets) / sizeof(facets[0]); ++n)
+        {
+            IPrxPtr fi = ICE_UNCHECKED_CAST(IPrx, i->ice_facet(facets[n]));
+            test(fi->getFacet() == facets[n]);
+            test(fi->getContext().empty());
+            test(fi->getContext(ctx) == ctx);
+            test(ICE_UNCHECKED_CAST(IPrx, fi->ice_context(ctx))->getContext() == ctx);
+
+            //
+            // A request without facet and context following a request with a
+            // facet and a context doesn't get them.
+            //
+            test(i->getFacet().empty());
+            test(i->getContext().empty());
+        }
+
+        try
+        {
+            ICE_UNCHECKED_CAST(IPrx, i->ice_facet("unknown")->ice_context(ctx))->getFacet();
+            test(false);
+        }
+        catch(const Ice::FacetNotExistException& ex)
+        {
+            test(ex.facet == "unknown");
+            test(ex.operation == "getFacet");
+        }
+    }
+    cout << "ok" << endl;
+
     return gf;
 }
@@ -28,6 +28,10 @@ run(int, char**, const Ice::CommunicatorPtr& communicator)
     adapter->addFacet(f, Ice::stringToIdentity("d"), "facetEF");
     Ice::ObjectPtr h = ICE_MAKE_SHARED(HI, communicator);
     adapter->addFacet(h, Ice::stringToIdentity("d"), "facetGH");
+    Ice::ObjectPtr i = ICE_MAKE_SHARED(II);
+    adapter->add(i, Ice::stringToIdentity("i"));
+    adapter->addFacet(i, Ice::stringToIdentity("i"), "facetI");
+    adapter->addFacet(i, Ice::stringToIdentity("i"), "facetI with a name longer than the small string buffer");
 
     GPrxPtr allTests(const Ice::CommunicatorPtr&);
     allTests(communicator);
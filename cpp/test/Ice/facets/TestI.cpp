@@ -73,3 +73,15 @@ HI::callH(const Ice::Current&)
 {
     return "H";
 }
+
+std::string
+II::getFacet(const Ice::Current& current)
+{
+    return current.facet;
+}
+
+Ice::Context
+II::getContext(const Ice::Current& current)
+{
+    return current.ctx;
+}
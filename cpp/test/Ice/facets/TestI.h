@@ -75,4 +75,12 @@ public:
     virtual std::string callH(const Ice::Current&);
 };
 
+class II : public virtual Test::I
+{
+public:
+
+    virtual std::string getFacet(const Ice::Current&);
+    virtual Ice::Context getContext(const Ice::Current&);
+};
+
 #endif
@@ -627,6 +627,53 @@ allTests(const Ice::CommunicatorPtr& communicator, const string& ref)
     }
     cout << "ok" << endl;
 
+    cout << "testing locator cache refresh and size... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.LocatorCacheRefreshThreshold", "50");
+        Ice::CommunicatorPtr ic = Ice::initialize(initData);
+
+        int count = locator->getRequestCount();
+        ic->stringToProxy("test@TestAdapter")->ice_locatorCacheTimeout(2)->ice_ping(); // 2s timeout.
+        test(++count == locator->getRequestCount());
+        ic->stringToProxy("test@TestAdapter")->ice_locatorCacheTimeout(2)->ice_ping();
+        test(count == locator->getRequestCount());
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1200));
+
+        //
+        // The entry is due for refresh, the following request uses the cached endpoints
+        // and refreshes the entry in the background.
+        //
+        ic->stringToProxy("test@TestAdapter")->ice_locatorCacheTimeout(2)->ice_ping();
+        for(int i = 0; i < 100 && locator->getRequestCount() == count; ++i)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
+        test(++count == locator->getRequestCount());
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(900));
+        ic->stringToProxy("test@TestAdapter")->ice_locatorCacheTimeout(2)->ice_ping(); // Still cached.
+        test(count == locator->getRequestCount());
+        ic->destroy();
+
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.LocatorCacheSize", "1");
+        ic = Ice::initialize(initData);
+
+        count = locator->getRequestCount();
+        ic->stringToProxy("test")->ice_ping();
+        count += 2;
+        test(count == locator->getRequestCount());
+        ic->stringToProxy("test2")->ice_ping(); // Evicts test from the cache.
+        test(++count == locator->getRequestCount());
+        ic->stringToProxy("test2")->ice_ping();
+        test(count == locator->getRequestCount());
+        ic->stringToProxy("test")->ice_ping();
+        test(++count == locator->getRequestCount());
+        ic->destroy();
+    }
+    cout << "ok" << endl;
+
     cout << "testing proxy from server after shutdown... " << flush;
     hello = obj->getReplicatedHello();
     obj->shutdown();
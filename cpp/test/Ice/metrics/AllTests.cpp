@@ -216,6 +216,267 @@ waitForCurrent(const ObserverIPtr& observer, int value)
     }
 };
 
+#ifndef _WIN32
+class SleepI : public Ice::Blobject
+{
+public:
+
+    virtual bool
+    ice_invoke(const vector<Ice::Byte>&, vector<Ice::Byte>&, const Ice::Current&)
+    {
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(20));
+        return true;
+    }
+};
+
+IceMX::ThreadMetricsPtr
+getThreadPoolMetrics(const IceMX::MetricsAdminPrxPtr& metrics, const string& pool)
+{
+    Ice::Long timestamp;
+    IceMX::MetricsView view = metrics->getMetricsView("View", timestamp);
+    for(IceMX::MetricsMap::const_iterator p = view["Thread"].begin(); p != view["Thread"].end(); ++p)
+    {
+        if((*p)->id == pool)
+        {
+            return ICE_DYNAMIC_CAST(IceMX::ThreadMetrics, *p);
+        }
+    }
+    test(false);
+    return 0;
+}
+
+IceMX::BufferPoolMetricsPtr
+getBufferPoolMetrics(const IceMX::MetricsAdminPrxPtr& metrics, const string& size)
+{
+    Ice::Long timestamp;
+    IceMX::MetricsView view = metrics->getMetricsView("View", timestamp);
+    for(IceMX::MetricsMap::const_iterator p = view["BufferPool"].begin(); p != view["BufferPool"].end(); ++p)
+    {
+        IceMX::BufferPoolMetricsPtr m = ICE_DYNAMIC_CAST(IceMX::BufferPoolMetrics, *p);
+        test(m && m->hits <= m->total && m->cached >= 0);
+        if(m->id == size)
+        {
+            return m;
+        }
+    }
+    test(false);
+    return 0;
+}
+
+void
+testTargetSize()
+{
+    Ice::InitializationData initData;
+    initData.properties = Ice::createProperties();
+    initData.properties->setProperty("Ice.Admin.Endpoints", "tcp -h 127.0.0.1");
+    initData.properties->setProperty("Ice.Admin.InstanceName", "pool");
+    initData.properties->setProperty("IceMX.Metrics.View.Map.Thread.GroupBy", "parent");
+    initData.properties->setProperty("Pool.Endpoints", "tcp -h 127.0.0.1");
+    initData.properties->setProperty("Pool.ThreadPool.Size", "2");
+    initData.properties->setProperty("Pool.ThreadPool.SizeMax", "4");
+    initData.properties->setProperty("Pool.ThreadPool.TargetLatency", "10");
+    Ice::CommunicatorHolder ich = Ice::initialize(initData);
+
+    Ice::ObjectAdapterPtr adapter = ich->createObjectAdapter("Pool");
+    Ice::ObjectPrxPtr prx = adapter->add(ICE_MAKE_SHARED(SleepI), Ice::stringToIdentity("sleep"));
+    prx = prx->ice_collocationOptimized(false);
+    adapter->activate();
+
+    IceMX::MetricsAdminPrxPtr metrics = ICE_CHECKED_CAST(IceMX::MetricsAdminPrx, ich->getAdmin(), "Metrics");
+
+    //
+    // Grow the pool with concurrent requests, then lower the target size with
+    // sequential requests.
+    //
+    vector<Ice::Byte> inParams;
+    vector<Ice::Byte> outParams;
+#ifdef ICE_CPP11_MAPPING
+    vector<future<Ice::Object::Ice_invokeResult>> results;
+    for(int i = 0; i < 40; ++i)
+    {
+        results.push_back(prx->ice_invokeAsync("sleep", Ice::OperationMode::Normal, inParams));
+    }
+    for(vector<future<Ice::Object::Ice_invokeResult>>::iterator p = results.begin(); p != results.end(); ++p)
+    {
+        p->get();
+    }
+#else
+    vector<Ice::AsyncResultPtr> results;
+    for(int i = 0; i < 40; ++i)
+    {
+        results.push_back(prx->begin_ice_invoke("sleep", Ice::Normal, inParams));
+    }
+    for(vector<Ice::AsyncResultPtr>::iterator p = results.begin(); p != results.end(); ++p)
+    {
+        prx->end_ice_invoke(outParams, *p);
+    }
+#endif
+    test(getThreadPoolMetrics(metrics, "Pool.ThreadPool")->current == 4);
+
+    for(int i = 0; i < 50; ++i)
+    {
+        prx->ice_invoke("sleep", Ice::ICE_ENUM(OperationMode, Normal), inParams, outParams);
+    }
+
+    //
+    // The idle threads in excess of the target size are released after a
+    // second. The threads waiting concurrently must not all be released, the
+    // pool doesn't shrink below the target size, which is at least Size.
+    //
+    IceMX::ThreadMetricsPtr m = getThreadPoolMetrics(metrics, "Pool.ThreadPool");
+    for(int i = 0; i < 50 && m->current > m->targetSize; ++i)
+    {
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        m = getThreadPoolMetrics(metrics, "Pool.ThreadPool");
+    }
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1500));
+    m = getThreadPoolMetrics(metrics, "Pool.ThreadPool");
+    test(m->targetSize == 2 && m->current == 2);
+}
+#endif
+
+IceMX::HostResolverMetricsPtr
+getHostResolverMetrics(const IceMX::MetricsAdminPrxPtr& metrics)
+{
+    Ice::Long timestamp;
+    IceMX::MetricsView view = metrics->getMetricsView("View", timestamp);
+    test(view["HostResolver"].size() == 1);
+    return ICE_DYNAMIC_CAST(IceMX::HostResolverMetrics, view["HostResolver"][0]);
+}
+
+Ice::Long
+getEndpointLookupTotal(const IceMX::MetricsAdminPrxPtr& metrics)
+{
+    Ice::Long timestamp;
+    IceMX::MetricsView view = metrics->getMetricsView("View", timestamp);
+    Ice::Long total = 0;
+    for(IceMX::MetricsMap::const_iterator p = view["EndpointLookup"].begin(); p != view["EndpointLookup"].end(); ++p)
+    {
+        total += (*p)->total;
+    }
+    return total;
+}
+
+void
+testHostResolver()
+{
+    Ice::InitializationData initData;
+    initData.properties = Ice::createProperties();
+    initData.properties->setProperty("Ice.Admin.Endpoints", "tcp -h 127.0.0.1");
+    initData.properties->setProperty("Ice.Admin.InstanceName", "resolver");
+    initData.properties->setProperty("IceMX.Metrics.View.GroupBy", "none");
+    initData.properties->setProperty("Ice.RetryIntervals", "-1");
+
+    //
+    // The requests are sent to the admin adapter of the communicator with
+    // a different connection ID to resolve the host for each request.
+    //
+    initData.properties->setProperty("Ice.HostResolver.CacheTimeout", "60");
+    initData.properties->setProperty("Ice.HostResolver.NegativeCacheTimeout", "60");
+    {
+        Ice::CommunicatorHolder ich = Ice::initialize(initData);
+        IceMX::MetricsAdminPrxPtr metrics = ICE_CHECKED_CAST(IceMX::MetricsAdminPrx, ich->getAdmin(), "Metrics");
+        Ice::IPEndpointInfoPtr info =
+            ICE_DYNAMIC_CAST(Ice::IPEndpointInfo, metrics->ice_getEndpoints()[0]->getInfo());
+        ostringstream os;
+        os << "dummy:tcp -h localhost -p " << info->port;
+        Ice::ObjectPrxPtr prx = metrics->ice_endpoints(ich->stringToProxy(os.str())->ice_getEndpoints());
+
+        //
+        // The addresses of the host are looked up once and cached.
+        //
+        for(int i = 0; i < 5; ++i)
+        {
+            ostringstream id;
+            id << "cache-" << i;
+            prx->ice_connectionId(id.str())->ice_ping();
+        }
+        IceMX::HostResolverMetricsPtr m = getHostResolverMetrics(metrics);
+        test(m->lookups == 1 && m->hits == 4 && m->negativeHits == 0 && m->cached == 1);
+        test(m->total == 5 && m->current == 0);
+        test(getEndpointLookupTotal(metrics) == 5);
+
+        //
+        // The DNS error of an unknown host is also cached.
+        //
+        Ice::ObjectPrxPtr unknown = ich->stringToProxy("test:tcp -t 500 -h unknownfoo.zeroc.com -p 10000");
+        bool dnsException = true;
+        for(int i = 0; i < 3; ++i)
+        {
+            ostringstream id;
+            id << "negative-cache-" << i;
+            try
+            {
+                unknown->ice_connectionId(id.str())->ice_ping();
+                test(false);
+            }
+            catch(const Ice::DNSException&)
+            {
+            }
+            catch(const Ice::LocalException&)
+            {
+                // Some DNS servers don't fail on unknown DNS names.
+                dnsException = false;
+            }
+        }
+        m = getHostResolverMetrics(metrics);
+        test(m->lookups == 2 && m->cached == 2);
+        test(dnsException ? m->hits == 4 && m->negativeHits == 2 : m->hits == 6 && m->negativeHits == 0);
+        test(getEndpointLookupTotal(metrics) == 8);
+    }
+
+    //
+    // Without cache, the requests for a host which is being looked up wait
+    // for the result of this lookup instead of looking it up again.
+    //
+    initData.properties->setProperty("Ice.HostResolver.CacheTimeout", "0");
+    initData.properties->setProperty("Ice.HostResolver.NegativeCacheTimeout", "0");
+    {
+        Ice::CommunicatorHolder ich = Ice::initialize(initData);
+        IceMX::MetricsAdminPrxPtr metrics = ICE_CHECKED_CAST(IceMX::MetricsAdminPrx, ich->getAdmin(), "Metrics");
+        Ice::IPEndpointInfoPtr info =
+            ICE_DYNAMIC_CAST(Ice::IPEndpointInfo, metrics->ice_getEndpoints()[0]->getInfo());
+        ostringstream os;
+        os << "dummy:tcp -h localhost -p " << info->port;
+        Ice::ObjectPrxPtr prx = metrics->ice_endpoints(ich->stringToProxy(os.str())->ice_getEndpoints());
+
+        int requests = 0;
+        IceMX::HostResolverMetricsPtr m = getHostResolverMetrics(metrics);
+        for(int i = 0; i < 20 && m->coalesced == 0; ++i)
+        {
+#ifdef ICE_CPP11_MAPPING
+            vector<future<void>> results;
+            for(int j = 0; j < 20; ++j)
+            {
+                ostringstream id;
+                id << "coalesce-" << requests++;
+                results.push_back(prx->ice_connectionId(id.str())->ice_pingAsync());
+            }
+            for(vector<future<void>>::iterator p = results.begin(); p != results.end(); ++p)
+            {
+                p->get();
+            }
+#else
+            vector<Ice::AsyncResultPtr> results;
+            for(int j = 0; j < 20; ++j)
+            {
+                ostringstream id;
+                id << "coalesce-" << requests++;
+                results.push_back(prx->ice_connectionId(id.str())->begin_ice_ping());
+            }
+            for(vector<Ice::AsyncResultPtr>::iterator p = results.begin(); p != results.end(); ++p)
+            {
+                (*p)->getProxy()->end_ice_ping(*p);
+            }
+#endif
+            m = getHostResolverMetrics(metrics);
+        }
+        test(m->coalesced > 0 && m->lookups + m->coalesced == requests);
+        test(m->hits == 0 && m->cached == 0 && m->current == 0);
+        test(getEndpointLookupTotal(metrics) == requests);
+    }
+}
+
 template<typename T> void
 testAttribute(const IceMX::MetricsAdminPrxPtr& metrics,
               const Ice::PropertiesAdminPrxPtr& props,
@@ -485,6 +746,28 @@ allTests(const Ice::CommunicatorPtr& communicator, const CommunicatorObserverIPt
          view["Thread"][0]->total == threadCount);
     cout << "ok" << endl;
 
+    cout << "testing buffer pool metrics..." << flush;
+    {
+        //
+        // The 20KB requests are allocated from the 32KB size class. Only
+        // the first allocations miss, the next requests recycle the buffers
+        // of the previous ones. The counters of the thread caches are added
+        // to the pool counters at the latest every 256 allocations.
+        //
+        IceMX::BufferPoolMetricsPtr m1 = getBufferPoolMetrics(clientMetrics, "32768");
+        Test::ByteSeq bs(20 * 1024);
+        for(int i = 0; i < 600; ++i)
+        {
+            metrics->opByteS(bs);
+        }
+        IceMX::BufferPoolMetricsPtr m2 = getBufferPoolMetrics(clientMetrics, "32768");
+        Ice::Long allocated = m2->total - m1->total;
+        Ice::Long hits = m2->hits - m1->hits;
+        test(allocated >= 512);
+        test(allocated - hits <= 16);
+    }
+    cout << "ok" << endl;
+
     cout << "testing group by id..." << flush;
 
     props["IceMX.Metrics.View.GroupBy"] = "id";
@@ -527,6 +810,16 @@ allTests(const Ice::CommunicatorPtr& communicator, const CommunicatorObserverIPt
     {
         test(static_cast<int>(view["Thread"].size()) > threadCount);
         test(view["Connection"].size() == 2);
+#ifndef _WIN32
+        Ice::Long executed = 0;
+        for(IceMX::MetricsMap::const_iterator p = view["Thread"].begin(); p != view["Thread"].end(); ++p)
+        {
+            IceMX::ThreadMetricsPtr m = ICE_DYNAMIC_CAST(IceMX::ThreadMetrics, *p);
+            test(m && m->queueDelay >= 0 && m->serviceTime >= 0 && m->targetSize == 0);
+            executed += m->executed;
+        }
+        test(executed >= 5);
+#endif
     }
     test(view["Dispatch"].size() == 1);
     test(view["Dispatch"][0]->current <= 1 && view["Dispatch"][0]->total == 5);
@@ -1527,5 +1820,15 @@ allTests(const Ice::CommunicatorPtr& communicator, const CommunicatorObserverIPt
     }
     cout << "ok" << endl;
 
+#ifndef _WIN32
+    cout << "testing thread pool target size... " << flush;
+    testTargetSize();
+    cout << "ok" << endl;
+#endif
+
+    cout << "testing host resolver metrics... " << flush;
+    testHostResolver();
+    cout << "ok" << endl;
+
     return metrics;
 }
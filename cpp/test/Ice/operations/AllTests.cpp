@@ -14,6 +14,76 @@
 
 using namespace std;
 
+namespace
+{
+
+//
+// Logger used to check the compression status of the traced messages.
+//
+class ProtocolLoggerI : public Ice::Logger,
+                        private IceUtil::Mutex
+#ifdef ICE_CPP11_MAPPING
+                      , public std::enable_shared_from_this<ProtocolLoggerI>
+#endif
+{
+public:
+
+    virtual void
+    print(const string&)
+    {
+    }
+
+    virtual void
+    trace(const string&, const string& message)
+    {
+        Lock sync(*this);
+        _messages.push_back(message);
+    }
+
+    virtual void
+    warning(const string&)
+    {
+    }
+
+    virtual void
+    error(const string&)
+    {
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return ICE_SHARED_FROM_THIS;
+    }
+
+    bool
+    traced(const string& text)
+    {
+        Lock sync(*this);
+        for(vector<string>::const_iterator p = _messages.begin(); p != _messages.end(); ++p)
+        {
+            if(p->find(text) != string::npos)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+
+    vector<string> _messages;
+};
+ICE_DEFINE_PTR(ProtocolLoggerIPtr, ProtocolLoggerI);
+
+}
+
 Test::MyClassPrxPtr
 allTests(const Ice::CommunicatorPtr& communicator)
 {
@@ -57,5 +127,73 @@ allTests(const Ice::CommunicatorPtr& communicator)
     batchOnewaysAMI(derived);
     cout << "ok" << endl;
 
+    cout << "testing compression codecs... " << flush;
+    {
+        //
+        // The codecs other than bzip2 are optional, the communicator
+        // initialization fails if the codec isn't supported.
+        //
+        const char* codecs[] = { "bzip2", "lz4", "zstd" };
+        const char* compressed[] = { "compression status = 2 ", "compression status = 4 ", "compression status = 6 " };
+        for(size_t i = 0; i < sizeof(codecs) / sizeof(codecs[0]); ++i)
+        {
+            Ice::InitializationData initData;
+            initData.properties = communicator->getProperties()->clone();
+            initData.properties->setProperty("Ice.Compression.Codec", codecs[i]);
+            initData.properties->setProperty("Ice.Trace.Protocol", "1");
+            ProtocolLoggerIPtr logger = ICE_MAKE_SHARED(ProtocolLoggerI);
+            initData.logger = logger;
+            Ice::CommunicatorPtr ic;
+            try
+            {
+                ic = Ice::initialize(initData);
+            }
+            catch(const Ice::InitializationException&)
+            {
+                test(i > 0);
+                continue;
+            }
+
+            Test::MyClassPrxPtr p = ICE_UNCHECKED_CAST(Test::MyClassPrx,
+                                                       ic->stringToProxy(ref)->ice_compress(true));
+            Test::ByteS p1(64 * 1024);
+            for(size_t j = 0; j < p1.size(); ++j)
+            {
+                p1[j] = static_cast<Ice::Byte>(j % 16);
+            }
+            Test::ByteS p2(p1.begin(), p1.begin() + 1024);
+            Test::ByteS p3;
+            Test::ByteS r = p->opByteS(p1, p2, p3);
+            test(r.size() == p1.size() + p2.size());
+            test(equal(p1.begin(), p1.end(), r.begin()));
+            test(equal(p2.begin(), p2.end(), r.begin() + p1.size()));
+            test(p3.size() == p1.size());
+            test(equal(p1.rbegin(), p1.rend(), p3.begin()));
+
+            if(p->ice_getConnection())
+            {
+                //
+                // The request and the response are compressed with the
+                // configured codec.
+                //
+                test(logger->traced(compressed[i]));
+            }
+            ic->destroy();
+        }
+
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.Compression.Codec", "unknown");
+        try
+        {
+            Ice::initialize(initData);
+            test(false);
+        }
+        catch(const Ice::InitializationException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
     return cl;
 }
@@ -88,6 +88,71 @@ public:
 };
 typedef IceUtil::Handle<CallbackFail> CallbackFailPtr;
 
+class InvokeThread : public IceUtil::Thread, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    InvokeThread(const RetryPrxPtr& proxy) :
+        _proxy(proxy),
+        _destroyed(false),
+        _count(0)
+    {
+    }
+
+    virtual void run()
+    {
+        while(true)
+        {
+            {
+                IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+                if(_destroyed)
+                {
+                    return;
+                }
+            }
+
+            try
+            {
+                _proxy->op(false);
+            }
+            catch(const Ice::LocalException& ex)
+            {
+                cerr << ex << endl;
+                test(false);
+            }
+
+            {
+                IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+                ++_count;
+                notifyAll();
+            }
+        }
+    }
+
+    void waitForInvocations(int count)
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        count += _count;
+        while(_count < count)
+        {
+            wait();
+        }
+    }
+
+    void destroy()
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        _destroyed = true;
+    }
+
+private:
+
+    const RetryPrxPtr _proxy;
+    bool _destroyed;
+    int _count;
+};
+typedef IceUtil::Handle<InvokeThread> InvokeThreadPtr;
+
 RetryPrxPtr
 allTests(const Ice::CommunicatorPtr& communicator, const Ice::CommunicatorPtr& communicator2, const string& ref)
 {
@@ -339,5 +404,171 @@ allTests(const Ice::CommunicatorPtr& communicator, const Ice::CommunicatorPtr& c
     }
     cout << "ok" << endl;
 
+    if(retry1->ice_getConnection())
+    {
+        cout << "testing rejected dispatches... " << flush;
+        RetryPrxPtr prx = ICE_UNCHECKED_CAST(RetryPrx,
+                                             communicator->stringToProxy("retry:" + getTestEndpoint(communicator, 1)));
+        prx->ice_ping();
+
+        //
+        // A request rejected by the dispatch limits of the server wasn't
+        // dispatched, it's retried even if it's not idempotent and the
+        // rejection is raised once the retries are exhausted.
+        //
+        testInvocationCount(-1);
+        testRetryCount(-1);
+        testFailureCount(-1);
+#ifdef ICE_CPP11_MAPPING
+        auto f = prx->sleepAsync(1000);
+#else
+        Ice::AsyncResultPtr r = prx->begin_sleep(1000);
+#endif
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+        try
+        {
+            prx->opNotIdempotent();
+            test(false);
+        }
+        catch(const Ice::DispatchRejectedException&)
+        {
+        }
+        testRetryCount(4);
+#ifdef ICE_CPP11_MAPPING
+        f.get();
+#else
+        prx->end_sleep(r);
+#endif
+        testInvocationCount(2);
+        testFailureCount(1);
+
+        //
+        // The rejected request succeeds once retried after the dispatch in
+        // progress completes.
+        //
+        {
+            Ice::InitializationData initData;
+            initData.properties = communicator->getProperties()->clone();
+            initData.properties->setProperty("Ice.RetryIntervals", "0 1000");
+            initData.observer = getObserver();
+            Ice::CommunicatorHolder ich = Ice::initialize(initData);
+            RetryPrxPtr prx2 = ICE_UNCHECKED_CAST(RetryPrx, ich->stringToProxy(prx->ice_toString()));
+            prx2->ice_ping();
+            testInvocationCount(-1);
+#ifdef ICE_CPP11_MAPPING
+            auto f2 = prx2->sleepAsync(500);
+#else
+            Ice::AsyncResultPtr r2 = prx2->begin_sleep(500);
+#endif
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+            prx2->op(false);
+            testRetryCount(2);
+#ifdef ICE_CPP11_MAPPING
+            f2.get();
+#else
+            prx2->end_sleep(r2);
+#endif
+            testInvocationCount(2);
+            testFailureCount(0);
+        }
+
+        //
+        // The requests are counted by the queued dispatch limit until their
+        // dispatch returns. Since the ping response is sent before its
+        // dispatch returns, the sleep request might be rejected and retried,
+        // the counters are reset once it's dispatched.
+        //
+        {
+            RetryPrxPtr prx3 = ICE_UNCHECKED_CAST(RetryPrx,
+                                                  communicator->stringToProxy("retry:" +
+                                                                              getTestEndpoint(communicator, 2)));
+            prx3->ice_ping();
+#ifdef ICE_CPP11_MAPPING
+            auto f3 = prx3->sleepAsync(1000);
+#else
+            Ice::AsyncResultPtr r3 = prx3->begin_sleep(1000);
+#endif
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+            testInvocationCount(-1);
+            testRetryCount(-1);
+            testFailureCount(-1);
+            try
+            {
+                prx3->opNotIdempotent();
+                test(false);
+            }
+            catch(const Ice::DispatchRejectedException&)
+            {
+            }
+            testRetryCount(4);
+#ifdef ICE_CPP11_MAPPING
+            f3.get();
+#else
+            prx3->end_sleep(r3);
+#endif
+            testInvocationCount(2);
+            testFailureCount(1);
+        }
+
+        //
+        // A DispatchRejectedException raised by the servant isn't a rejection
+        // by the server, the request was dispatched and isn't retried.
+        //
+        try
+        {
+            prx->opDispatchRejected();
+            test(false);
+        }
+        catch(const Ice::DispatchRejectedException&)
+        {
+            test(false);
+        }
+        catch(const Ice::UnknownLocalException& ex)
+        {
+            test(ex.unknown.find("raised by the servant") != string::npos);
+        }
+        testInvocationCount(1);
+        testRetryCount(0);
+        testFailureCount(1);
+        cout << "ok" << endl;
+    }
+
+    if(retry1->ice_getConnection())
+    {
+        cout << "testing concurrent invocations with connection closure... " << flush;
+        {
+            //
+            // Oneway requests queued by concurrent invocations aren't sent if
+            // the connection is closed while another thread sends the queued
+            // requests. They must be retried even if retries are disabled.
+            //
+            Ice::InitializationData initData;
+            initData.properties = communicator->getProperties()->clone();
+            initData.properties->setProperty("Ice.RetryIntervals", "-1");
+            Ice::CommunicatorHolder ich = Ice::initialize(initData);
+            RetryPrxPtr prx = ICE_UNCHECKED_CAST(RetryPrx, ich->stringToProxy(retry1->ice_toString())->ice_oneway());
+
+            vector<InvokeThreadPtr> threads;
+            for(int i = 0; i < 8; ++i)
+            {
+                threads.push_back(new InvokeThread(prx));
+                threads.back()->start();
+            }
+
+            for(int i = 0; i < 200; ++i)
+            {
+                threads.front()->waitForInvocations(1);
+                prx->ice_getConnection()->close(true);
+            }
+
+            for(vector<InvokeThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+            {
+                (*p)->destroy();
+                (*p)->getThreadControl().join();
+            }
+        }
+        cout << "ok" << endl;
+    }
+
     return retry1;
 }
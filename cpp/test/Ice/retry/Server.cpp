@@ -22,6 +22,28 @@ run(int, char**, const Ice::CommunicatorPtr& communicator)
     Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
     adapter->add(ICE_MAKE_SHARED(RetryI), Ice::stringToIdentity("retry"));
     adapter->activate();
+
+    //
+    // The dispatches of this adapter are rejected while another dispatch is
+    // in progress.
+    //
+    communicator->getProperties()->setProperty("RejectAdapter.Endpoints", getTestEndpoint(communicator, 1));
+    communicator->getProperties()->setProperty("RejectAdapter.MaxConcurrentDispatch", "1");
+    communicator->getProperties()->setProperty("RejectAdapter.ThreadPool.Size", "2");
+    Ice::ObjectAdapterPtr rejectAdapter = communicator->createObjectAdapter("RejectAdapter");
+    rejectAdapter->add(ICE_MAKE_SHARED(RetryI), Ice::stringToIdentity("retry"));
+    rejectAdapter->activate();
+
+    //
+    // The requests of this adapter are rejected while another request is
+    // queued or dispatched.
+    //
+    communicator->getProperties()->setProperty("QueueAdapter.Endpoints", getTestEndpoint(communicator, 2));
+    communicator->getProperties()->setProperty("QueueAdapter.MaxQueuedDispatch", "1");
+    communicator->getProperties()->setProperty("QueueAdapter.ThreadPool.Size", "2");
+    Ice::ObjectAdapterPtr queueAdapter = communicator->createObjectAdapter("QueueAdapter");
+    queueAdapter->add(ICE_MAKE_SHARED(RetryI), Ice::stringToIdentity("retry"));
+    queueAdapter->activate();
     TEST_READY
     communicator->waitForShutdown();
     return EXIT_SUCCESS;
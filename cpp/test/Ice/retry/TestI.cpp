@@ -62,6 +62,18 @@ RetryI::opSystemException(const Ice::Current&)
     throw SystemFailure(__FILE__, __LINE__);
 }
 
+void
+RetryI::opDispatchRejected(const Ice::Current&)
+{
+    throw Ice::DispatchRejectedException(__FILE__, __LINE__, "raised by the servant");
+}
+
+void
+RetryI::sleep(int delay, const Ice::Current&)
+{
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(delay));
+}
+
 void
 RetryI::shutdown(const Ice::Current& current)
 {
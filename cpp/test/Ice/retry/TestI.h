@@ -22,6 +22,8 @@ public:
     virtual int opIdempotent(int, const Ice::Current&);
     virtual void opNotIdempotent(const Ice::Current&);
     virtual void opSystemException(const Ice::Current&);
+    virtual void opDispatchRejected(const Ice::Current&);
+    virtual void sleep(int, const Ice::Current&);
     virtual void shutdown(const Ice::Current&);
 
 private:
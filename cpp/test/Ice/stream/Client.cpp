@@ -787,6 +787,74 @@ run(int, char**, const Ice::CommunicatorPtr& communicator)
 #endif
     }
 
+    {
+#ifndef ICE_BIG_ENDIAN
+        test(Ice::IsWireCompatible<FixedStruct>::value);
+#endif
+        FixedStructS arr;
+        Ice::OutputStream out(communicator);
+        for(int i = 0; i < 4; ++i)
+        {
+            FixedStruct s;
+            s.l = 1 + i;
+            s.i = 2 + i;
+            s.sh = static_cast<Ice::Short>(3 + i);
+            s.by1 = static_cast<Ice::Byte>(4 + i);
+            s.by2 = static_cast<Ice::Byte>(5 + i);
+            s.d = 6.0 + i;
+            s.f = static_cast<Ice::Float>(7.0 + i);
+            s.i2 = 8 + i;
+            arr.push_back(s);
+            out.write(s);
+        }
+        vector<Ice::Byte> memberData;
+        out.finished(memberData);
+
+        Ice::OutputStream out2(communicator);
+        out2.write(arr);
+        out2.finished(data);
+        test(data.size() == memberData.size() + 1);
+        test(equal(memberData.begin(), memberData.end(), data.begin() + 1));
+
+        Ice::InputStream in(communicator, data);
+        FixedStructS arr2;
+        in.read(arr2);
+        test(arr2 == arr);
+    }
+
+    {
+        //
+        // Wide strings with non-ASCII characters after ASCII prefixes of
+        // various lengths.
+        //
+        vector<wstring> arr;
+        for(int i = 0; i < 40; ++i)
+        {
+            wstring s;
+            for(int j = 0; j < i; ++j)
+            {
+                s += static_cast<wchar_t>(L'a' + j % 26);
+            }
+            arr.push_back(s);
+            arr.push_back(s + L"\u00e9" + s);
+            arr.push_back(s + L"\u20ac");
+        }
+        Ice::OutputStream out(communicator);
+        out.write(arr);
+        out.finished(data);
+
+        Ice::InputStream in(communicator, data);
+        vector<wstring> arr2;
+        in.read(arr2);
+        test(arr2 == arr);
+
+        for(vector<wstring>::const_iterator p = arr.begin(); p != arr.end(); ++p)
+        {
+            test(Ice::stringToWstring(Ice::wstringToString(*p)) == *p);
+        }
+        test(Ice::wstringToString(L"abcdefghijklmnopq\u00e9") == "abcdefghijklmnopq\xc3\xa9");
+    }
+
     {
         MyClassS arr;
         for(int i = 0; i < 4; ++i)
@@ -38,11 +38,11 @@ public:
             cerr << endl << "expected oneway request";
             test(false);
         }
-        else if((_name == "twoway" || _name == "twoway ordered") && current.requestId == 0)
+        else if((_name == "twoway" || _name.find("twoway ordered") == 0) && current.requestId == 0)
         {
             cerr << endl << "expected twoway request";
         }
-        if(_name == "twoway ordered" && i != _last)
+        if(_name.find("twoway ordered") == 0 && i != _last)
         {
             cerr << endl << "received unordered event for `" << _name << "': " << i << " " << _last;
             test(false);
@@ -101,6 +101,122 @@ private:
 };
 typedef IceUtil::Handle<SingleI> SingleIPtr;
 
+//
+// Records the events replayed from the event log of the topic.
+//
+class ReplayI : public Single, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    virtual void
+    event(int i, const Current& current)
+    {
+        //
+        // The events are logged from offset 1.
+        //
+        Context::const_iterator p = current.ctx.find("IceStorm.Offset");
+        ostringstream os;
+        os << i + 1;
+        test(p != current.ctx.end() && p->second == os.str());
+
+        Lock sync(*this);
+        _events.push_back(i);
+        notify();
+    }
+
+    vector<int>
+    waitForEvents(size_t count)
+    {
+        Lock sync(*this);
+        while(_events.size() < count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(20)))
+            {
+                test(false);
+            }
+        }
+        return _events;
+    }
+
+private:
+
+    vector<int> _events;
+};
+typedef IceUtil::Handle<ReplayI> ReplayIPtr;
+
+//
+// Records the events which pass the filter of the subscriber.
+//
+class FilteredI : public Filtered, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    virtual void
+    eventA(int i, const Current&)
+    {
+        add("A", i);
+    }
+
+    virtual void
+    eventB(int i, const Current&)
+    {
+        add("B", i);
+    }
+
+    vector<string>
+    waitForEvents(size_t count)
+    {
+        Lock sync(*this);
+        while(_events.size() < count)
+        {
+            if(!timedWait(IceUtil::Time::seconds(20)))
+            {
+                test(false);
+            }
+        }
+        return _events;
+    }
+
+private:
+
+    void
+    add(const string& op, int i)
+    {
+        ostringstream os;
+        os << op << i;
+        Lock sync(*this);
+        _events.push_back(os.str());
+        notify();
+    }
+
+    vector<string> _events;
+};
+typedef IceUtil::Handle<FilteredI> FilteredIPtr;
+
+vector<string>
+split(const string& s)
+{
+    vector<string> v;
+    istringstream is(s);
+    string event;
+    while(is >> event)
+    {
+        v.push_back(event);
+    }
+    return v;
+}
+
+vector<int>
+range(int first, int last)
+{
+    vector<int> v;
+    for(int i = first; i <= last; ++i)
+    {
+        v.push_back(i);
+    }
+    return v;
+}
+
 int
 run(int, char* argv[], const CommunicatorPtr& communicator)
 {
@@ -203,6 +319,23 @@ run(int, char* argv[], const CommunicatorPtr& communicator)
         subscriberIdentities.push_back(object->ice_getIdentity());
         topic->subscribeAndGetPublisher(qos, object);
     }
+    {
+        //
+        // With a window, the events are pipelined on the subscriber connection and must be
+        // dispatched serially to be received in order.
+        //
+        properties->setProperty("OrderedAdapter.ThreadPool.Size", "2");
+        properties->setProperty("OrderedAdapter.ThreadPool.Serialize", "1");
+        ObjectAdapterPtr adpt = communicator->createObjectAdapterWithEndpoints("OrderedAdapter", "default");
+        subscribers.push_back(new SingleI(communicator, "twoway ordered window"));
+        IceStorm::QoS qos;
+        qos["reliability"] = "ordered";
+        qos["window"] = "10";
+        Ice::ObjectPrx object = adpt->addWithUUID(subscribers.back());
+        subscriberIdentities.push_back(object->ice_getIdentity());
+        topic->subscribeAndGetPublisher(qos, object);
+        adpt->activate();
+    }
     {
         // Use a separate adapter to ensure a separate connection is used for the subscriber
         // (otherwise, if multiple UDP subscribers use the same connection we might get high
@@ -240,6 +373,181 @@ run(int, char* argv[], const CommunicatorPtr& communicator)
         (*p)->waitForEvents();
     }
 
+    if(string(argv[1]) == "persistent")
+    {
+        //
+        // The event log of the topic keeps the last 500 events (see test.py).
+        //
+        cout << "testing event log replay... " << flush;
+        IceStorm::QoS qos;
+        qos["reliability"] = "ordered";
+        {
+            qos["resumeFrom"] = "0";
+            ReplayIPtr servant = new ReplayI();
+            topic->subscribeAndGetPublisher(qos, adapter->addWithUUID(servant));
+            test(servant->waitForEvents(500) == range(500, 999));
+        }
+        {
+            qos["resumeFrom"] = "901";
+            ReplayIPtr servant = new ReplayI();
+            Ice::ObjectPrx object = adapter->addWithUUID(servant);
+            topic->subscribeAndGetPublisher(qos, object);
+            test(servant->waitForEvents(100) == range(900, 999));
+
+            //
+            // Subscribing again with resumeFrom replaces the subscription.
+            //
+            try
+            {
+                topic->subscribeAndGetPublisher(IceStorm::QoS(), object);
+                test(false);
+            }
+            catch(const IceStorm::AlreadySubscribed&)
+            {
+            }
+            qos["resumeFrom"] = "991";
+            topic->subscribeAndGetPublisher(qos, object);
+            vector<int> events = range(900, 999);
+            vector<int> resumed = range(990, 999);
+            events.insert(events.end(), resumed.begin(), resumed.end());
+            test(servant->waitForEvents(110) == events);
+        }
+        cout << "ok" << endl;
+    }
+
+    cout << "testing event filters... " << flush;
+    {
+        TopicPrx filterTopic = manager->create("filter");
+
+        const char* filters[][4] =
+        {
+            { 0, 0, 0, 0 },
+            { "filter.operation", "eventA", 0, 0 },
+            { "filter.context.region", "eu, us", 0, 0 },
+            { "filter.operation", "eventB", "filter.context.region", "eu" },
+            { "filter.context.region", "eu", "filter.context.tier", "gold" },
+        };
+        vector<FilteredIPtr> servants;
+        for(size_t i = 0; i < sizeof(filters) / sizeof(*filters); ++i)
+        {
+            IceStorm::QoS qos;
+            qos["reliability"] = "ordered";
+            for(size_t j = 0; j < 4 && filters[i][j]; j += 2)
+            {
+                qos[filters[i][j]] = filters[i][j + 1];
+            }
+            servants.push_back(new FilteredI());
+            filterTopic->subscribeAndGetPublisher(qos, adapter->addWithUUID(servants.back()));
+        }
+
+        //
+        // Invalid filters are rejected.
+        //
+        const char* invalid[][2] =
+        {
+            { "filter.operation", "" },
+            { "filter.context.region", " , " },
+            { "filter.context.", "eu" },
+            { "filter.unknown", "eu" },
+        };
+        Ice::ObjectPrx object = adapter->addWithUUID(new FilteredI());
+        for(size_t i = 0; i < sizeof(invalid) / sizeof(*invalid); ++i)
+        {
+            IceStorm::QoS qos;
+            qos[invalid[i][0]] = invalid[i][1];
+            try
+            {
+                filterTopic->subscribeAndGetPublisher(qos, object);
+                test(false);
+            }
+            catch(const IceStorm::BadQoS&)
+            {
+            }
+        }
+        filterTopic->subscribeAndGetPublisher(IceStorm::QoS(), object);
+        filterTopic->unsubscribe(object);
+
+        FilteredPrx publisher = FilteredPrx::uncheckedCast(filterTopic->getPublisher()->ice_twoway());
+        Ice::Context ctx;
+        publisher->eventA(0);
+        ctx["region"] = "eu";
+        publisher->eventB(1, ctx);
+        ctx["region"] = "us";
+        publisher->eventA(2, ctx);
+        ctx["region"] = "asia";
+        publisher->eventB(3, ctx);
+        ctx["region"] = "eu";
+        ctx["tier"] = "gold";
+        publisher->eventA(4, ctx);
+        publisher->eventB(5);
+
+        //
+        // The events are received in order, an event accepted by mistake
+        // would therefore show up before the last expected event.
+        //
+        const char* expected[] =
+        {
+            "A0 B1 A2 B3 A4 B5", // No filter
+            "A0 A2 A4", // Operation
+            "B1 A2 A4", // Context, any of the values
+            "B1", // Operation and context
+            "A4", // Several context entries
+        };
+        for(size_t i = 0; i < servants.size(); ++i)
+        {
+            vector<string> events = split(expected[i]);
+            test(servants[i]->waitForEvents(events.size()) == events);
+        }
+
+        filterTopic->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing event log QoS... " << flush;
+    {
+        IceStorm::QoS qos;
+        Ice::ObjectPrx object = adapter->addWithUUID(new ReplayI());
+        const char* invalid[] = { "", "abc", "-1", "1x" };
+        for(size_t i = 0; i < sizeof(invalid) / sizeof(*invalid); ++i)
+        {
+            qos["resumeFrom"] = invalid[i];
+            try
+            {
+                topic->subscribeAndGetPublisher(qos, object);
+                test(false);
+            }
+            catch(const IceStorm::BadQoS&)
+            {
+            }
+        }
+
+        //
+        // Only the persistent topic has an event log and batch subscribers
+        // don't support replays.
+        //
+        qos["resumeFrom"] = "1";
+        try
+        {
+            topic->subscribeAndGetPublisher(qos, object->ice_batchOneway());
+            test(false);
+        }
+        catch(const IceStorm::BadQoS&)
+        {
+        }
+        if(string(argv[1]) != "persistent")
+        {
+            try
+            {
+                topic->subscribeAndGetPublisher(qos, object);
+                test(false);
+            }
+            catch(const IceStorm::BadQoS&)
+            {
+            }
+        }
+    }
+    cout << "ok" << endl;
+
     return EXIT_SUCCESS;
 }
 
@@ -16,11 +16,16 @@
 # truncated). See also bug #6070.
 #
 props = { "Ice.UDP.SndSize" : 4096, "Ice.Warn.Dispatch" : 0 }
-persistent = IceStorm(props = props)
+#
+# The persistent topic logs its last 500 events, the event log isn't supported
+# with replication.
+#
+persistent = IceStorm(props = dict(props, **{ "IceStorm.EventLog.Topics" : "single",
+                                              "IceStorm.EventLog.MaxEvents" : 500 }))
 transient = IceStorm(props = props, transient=True)
 replicated = [ IceStorm(replica=i, nreplicas=3, props = props) for i in range(0,3) ]
 
-sub = Subscriber(args=["{testcase.parent.name}"], props = { "Ice.UDP.RcvSize" : 4096 }, readyCount=3)
+sub = Subscriber(args=["{testcase.parent.name}"], props = { "Ice.UDP.RcvSize" : 4096 }, readyCount=4)
 pub = Publisher(args=["{testcase.parent.name}"])
 
 class IceStormSingleTestCase(IceStormTestCase):
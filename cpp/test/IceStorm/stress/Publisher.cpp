@@ -25,6 +25,7 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
     opts.addOpt("", "events", IceUtilInternal::Options::NeedArg);
     opts.addOpt("", "oneway");
     opts.addOpt("", "maxQueueTest");
+    opts.addOpt("", "payload", IceUtilInternal::Options::NeedArg);
 
     try
     {
@@ -50,6 +51,7 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
 
     bool oneway = opts.isSet("oneway");
     bool maxQueueTest = opts.isSet("maxQueueTest");
+    int payload = opts.isSet("payload") ? atoi(opts.optArg("payload").c_str()) : 0;
 
     PropertiesPtr properties = communicator->getProperties();
     const char* managerProxyProperty = "IceStormAdmin.TopicManager.Default";
@@ -98,7 +100,22 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
             // Sleep one seconds to give some time to IceStorm to connect to the subscriber
             IceUtil::ThreadControl::sleep(IceUtil::Time::seconds(1));
         }
-        proxy->pub(i);
+        if(payload > 0)
+        {
+            //
+            // The subscribers check the payload against this pattern.
+            //
+            Ice::ByteSeq data(payload);
+            for(int j = 0; j < payload; ++j)
+            {
+                data[j] = static_cast<Ice::Byte>(i + j);
+            }
+            proxy->pubData(i, data);
+        }
+        else
+        {
+            proxy->pub(i);
+        }
     }
 
     if(oneway)
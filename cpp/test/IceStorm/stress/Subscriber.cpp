@@ -25,6 +25,16 @@ using namespace Test;
 
 struct Subscription; // Forward declaration.
 
+namespace
+{
+
+//
+// The payload size of the pubData events, set with the --payload option.
+//
+int payloadSize = 0;
+
+}
+
 class EventI : public Event, public IceUtil::Mutex
 {
 public:
@@ -44,6 +54,26 @@ public:
     {
     }
 
+    virtual void
+    pubData(int counter, const Ice::ByteSeq& data, const Ice::Current& current)
+    {
+        //
+        // Check the payload against the pattern sent by the publisher before
+        // processing the event like any other event.
+        //
+        bool valid = static_cast<int>(data.size()) == payloadSize;
+        for(Ice::ByteSeq::size_type i = 0; valid && i < data.size(); ++i)
+        {
+            valid = data[i] == static_cast<Ice::Byte>(counter + static_cast<int>(i));
+        }
+        if(!valid)
+        {
+            cerr << "failed! received invalid payload for event: " << counter << endl;
+            test(false);
+        }
+        pub(counter, current);
+    }
+
 protected:
 
     const CommunicatorPtr _communicator;
@@ -273,6 +303,90 @@ private:
     const Ice::ObjectAdapterPtr _adapter;
 };
 
+class IgnoreEventI : public EventI
+{
+public:
+
+    IgnoreEventI(const CommunicatorPtr& communicator) :
+        EventI(communicator, 0)
+    {
+    }
+
+    virtual void
+    pub(int, const Ice::Current&)
+    {
+    }
+};
+
+//
+// Subscribes and unsubscribes a subscriber to the topic in a loop until
+// stopped, to modify the subscribers of the topic while events are
+// published.
+//
+class ChurnThread : public IceUtil::Thread, public IceUtil::Mutex
+{
+public:
+
+    ChurnThread(const TopicPrx& topic, const Ice::ObjectPrx& subscriber) :
+        _topic(topic), _subscriber(subscriber), _stopped(false), _failed(false), _count(0)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        while(true)
+        {
+            {
+                Lock sync(*this);
+                if(_stopped)
+                {
+                    return;
+                }
+            }
+
+            try
+            {
+                _topic->subscribeAndGetPublisher(IceStorm::QoS(), _subscriber);
+                _topic->unsubscribe(_subscriber);
+            }
+            catch(const Ice::Exception& ex)
+            {
+                cerr << "failed! unexpected exception while subscribing:\n" << ex << endl;
+                Lock sync(*this);
+                _failed = true;
+                return;
+            }
+
+            Lock sync(*this);
+            ++_count;
+        }
+    }
+
+    void
+    stop()
+    {
+        Lock sync(*this);
+        _stopped = true;
+    }
+
+    bool
+    succeeded() const
+    {
+        Lock sync(*this);
+        return !_failed && _count > 0;
+    }
+
+private:
+
+    const TopicPrx _topic;
+    const Ice::ObjectPrx _subscriber;
+    bool _stopped;
+    bool _failed;
+    int _count;
+};
+typedef IceUtil::Handle<ChurnThread> ChurnThreadPtr;
+
 namespace
 {
 
@@ -306,6 +420,10 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
     opts.addOpt("", "erratic", IceUtilInternal::Options::NeedArg);
     opts.addOpt("", "maxQueueDropEvents", IceUtilInternal::Options::NeedArg);
     opts.addOpt("", "maxQueueRemoveSub", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "payload", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "compress");
+    opts.addOpt("", "churn");
+    opts.addOpt("", "endpoints", IceUtilInternal::Options::NeedArg, "default");
 
     try
     {
@@ -343,6 +461,11 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
         cmdLineQos[q->substr(0, off)] = q->substr(off+1);
     }
 
+    payloadSize = opts.isSet("payload") ? atoi(opts.optArg("payload").c_str()) : 0;
+    bool compress = opts.isSet("compress");
+    bool churn = opts.isSet("churn");
+    string endpoints = opts.optArg("endpoints");
+
     bool slow = opts.isSet("slow");
     int maxQueueDropEvents = opts.isSet("maxQueueDropEvents") ? atoi(opts.optArg("maxQueueDropEvents").c_str()) : 0;
     int maxQueueRemoveSub = opts.isSet("maxQueueRemoveSub") ? atoi(opts.optArg("maxQueueRemoveSub").c_str()) : 0;
@@ -425,7 +548,7 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
     else
     {
         Subscription item;
-        item.adapter = communicator->createObjectAdapterWithEndpoints("SubscriberAdapter", "default");
+        item.adapter = communicator->createObjectAdapterWithEndpoints("SubscriberAdapter", endpoints);
         item.qos = cmdLineQos;
         map<string, string>::const_iterator p = item.qos.find("reliability");
         if(p != item.qos.end() && p->second == "ordered")
@@ -478,6 +601,10 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
             {
                 p->obj = p->obj->ice_oneway();
             }
+            if(compress)
+            {
+                p->obj = p->obj->ice_compress(true);
+            }
             p->publisher = topic->subscribeAndGetPublisher(qos, p->obj);
         }
     }
@@ -492,8 +619,27 @@ run(int argc, char* argv[], const CommunicatorPtr& communicator)
         }
     }
 
+    ChurnThreadPtr churnThread;
+    if(churn)
+    {
+        Ice::ObjectPrx obj = subs.front().adapter->addWithUUID(new IgnoreEventI(communicator))->ice_oneway();
+        churnThread = new ChurnThread(topic, obj);
+        churnThread->start();
+    }
+
     communicator->waitForShutdown();
 
+    if(churnThread)
+    {
+        churnThread->stop();
+        churnThread->getThreadControl().join();
+        if(!churnThread->succeeded())
+        {
+            cerr << "failed to subscribe and unsubscribe while receiving events." << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
     {
         for(vector<Subscription>::const_iterator p = subs.begin(); p != subs.end(); ++p)
         {
@@ -41,6 +41,19 @@ class IceStormStressTestCase(IceStormTestCase):
         doTest(("TestIceStorm1", '--events 5000 --qos "reliability,ordered"'), '--events 5000')
         current.writeln("ok")
 
+        #
+        # Events of 1KB or more reference the event data instead of copying it in
+        # the request of each subscriber. Check the data is intact for transports
+        # with and without gather writes and for compressed requests.
+        #
+        current.write("Sending 1000 events with a 4KB payload to several subscribers... ")
+        doTest([("TestIceStorm1", '--events 1000 --payload 4096 --qos "reliability,ordered"'),
+                ("TestIceStorm1", '--events 1000 --payload 4096'),
+                ("TestIceStorm1", '--events 1000 --payload 4096 --qos "reliability,twoway" --compress'),
+                ("TestIceStorm1", '--events 1000 --payload 4096 --endpoints ws')],
+                '--events 1000 --payload 4096')
+        current.writeln("ok")
+
         self.runadmin(current, "link TestIceStorm1/fed1 TestIceStorm2/fed1")
         current.write("Sending 5000 ordered events across a link... ")
         doTest(("TestIceStorm2", '--events 5000 --qos "reliability,ordered"'), '--events 5000')
@@ -143,6 +156,32 @@ class IceStormStressTestCase(IceStormTestCase):
             s.stop(current, True)
         current.writeln("ok")
 
+        #
+        # With a shard size of 2, the subscribers are split in several shards
+        # processed by the fan-out pool threads and the publishing thread.
+        #
+        current.write("Sending 5000 ordered events with the fan-out pool... ")
+        opts = " --IceStorm.FanOut.Size=2 --IceStorm.FanOut.ShardSize=2"
+        for s in icestorm1:
+            s.start(current, args=opts.split(" "))
+        doTest([("TestIceStorm1", '--events 5000 --qos "reliability,ordered"'),
+                ("TestIceStorm1", '--events 5000 --qos "reliability,ordered" --churn'),
+                ("TestIceStorm1", '--events 5000 --qos "reliability,ordered"'),
+                ("TestIceStorm1", '--events 5000 --qos "reliability,ordered" --churn'),
+                ("TestIceStorm1", '--events 5000'),
+                ("TestIceStorm1", '--events 5000 --qos "reliability,batch"')],
+                '--events 5000')
+        current.writeln("ok")
+
+        #
+        # The services must join the fan-out pool threads and exit cleanly.
+        #
+        current.write("shutting down icestorm services with the fan-out pool... ")
+        for s in icestorm1:
+            s.shutdown(current)
+            s.stop(current, True)
+        current.writeln("ok")
+
 TestSuite(__file__, [
 
     IceStormStressTestCase("persistent", icestorm=[IceStorm("TestIceStorm1", quiet=True),